@@ -0,0 +1,166 @@
+#pragma once
+
+// Compile-time name tables for enum classes.
+//
+//     enum class Suit { Hearts, Diamonds, Clubs, Spades };
+//
+//     template <>
+//     struct EnumNames<Suit> {
+//         static constexpr int first = 0;   // Underlying value of names[0]
+//         static constexpr std::array<std::string_view, 4> names{
+//             "Hearts", "Diamonds", "Clubs", "Spades"};
+//     };
+//
+//     enumName(Suit::Clubs)             // "Clubs", O(1), no allocation
+//     enumFromName<Suit>("Spades")      // std::optional<Suit>, O(1) hash lookup
+//     formatEnums<Suit>(hand, buffer)   // Whole array into a caller's char buffer
+//
+// The enumerators must be contiguous starting at `first`. A switch that
+// returns std::string allocates on every call once the name outgrows the
+// small-string buffer, and even short names pay for constructing an object;
+// here a name is a string_view into static storage, and the reverse map is an
+// open-addressing hash table built at compile time.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include "../common/span.h"
+
+template <typename E>
+struct EnumNames;  // Specialize for each enum, as above
+
+namespace enum_detail {
+
+constexpr std::uint32_t fnv1a(std::string_view s) {
+    std::uint32_t h = 2166136261u;
+    for (char c : s) h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    return h;
+}
+
+constexpr size_t slotCountFor(size_t n) {
+    size_t slots = 1;
+    while (slots < 2 * n) slots <<= 1;  // Load factor <= 1/2
+    return slots;
+}
+
+template <typename E>
+struct NameIndex {
+    static constexpr auto& names = EnumNames<E>::names;
+    static constexpr size_t kSlots = slotCountFor(names.size());
+    static constexpr std::int16_t kEmpty = -1;
+
+    static constexpr std::array<std::int16_t, kSlots> build() {
+        std::array<std::int16_t, kSlots> slots{};
+        for (auto& s : slots) s = kEmpty;
+        for (size_t i = 0; i < names.size(); ++i) {
+            size_t slot = fnv1a(names[i]) & (kSlots - 1);
+            while (slots[slot] != kEmpty) slot = (slot + 1) & (kSlots - 1);
+            slots[slot] = static_cast<std::int16_t>(i);
+        }
+        return slots;
+    }
+
+    static constexpr std::array<std::int16_t, kSlots> slots = build();
+};
+
+// Every name padded to 16 bytes, so the bulk formatter can copy a fixed-size
+// block (one vector move) and then advance by the real length
+inline constexpr size_t kPadded = 16;
+
+template <typename E>
+struct PaddedNames {
+    static constexpr auto& names = EnumNames<E>::names;
+
+    static constexpr bool fits() {
+        for (auto n : names) {
+            if (n.size() >= kPadded) return false;
+        }
+        return true;
+    }
+
+    static constexpr std::array<std::array<char, kPadded>, EnumNames<E>::names.size()> build() {
+        std::array<std::array<char, kPadded>, EnumNames<E>::names.size()> table{};
+        for (size_t i = 0; i < names.size(); ++i) {
+            for (size_t j = 0; j < names[i].size() && j < kPadded; ++j) table[i][j] = names[i][j];
+        }
+        return table;
+    }
+
+    static constexpr bool kUsable = fits();
+    static constexpr auto table = build();
+};
+
+}  // namespace enum_detail
+
+template <typename E>
+constexpr size_t enumCount() {
+    return EnumNames<E>::names.size();
+}
+
+// Position of `value` in the name table, or enumCount<E>() if out of range
+template <typename E>
+constexpr size_t enumIndex(E value) {
+    auto offset = static_cast<long long>(value) - EnumNames<E>::first;
+    return (offset >= 0 && static_cast<size_t>(offset) < enumCount<E>())
+               ? static_cast<size_t>(offset)
+               : enumCount<E>();
+}
+
+template <typename E>
+constexpr std::string_view enumName(E value, std::string_view unknown = "Unknown") {
+    size_t i = enumIndex(value);
+    return i < enumCount<E>() ? EnumNames<E>::names[i] : unknown;
+}
+
+template <typename E>
+constexpr std::optional<E> enumFromName(std::string_view name) {
+    using Index = enum_detail::NameIndex<E>;
+    size_t slot = enum_detail::fnv1a(name) & (Index::kSlots - 1);
+    while (Index::slots[slot] != Index::kEmpty) {
+        size_t i = static_cast<size_t>(Index::slots[slot]);
+        if (EnumNames<E>::names[i] == name) {
+            return static_cast<E>(EnumNames<E>::first + static_cast<int>(i));
+        }
+        slot = (slot + 1) & (Index::kSlots - 1);
+    }
+    return std::nullopt;
+}
+
+struct FormatResult {
+    size_t values;  // How many enums were written
+    size_t bytes;   // How many chars of the buffer were used
+};
+
+// Write name + separator for each value into `out`, without allocating.
+// Stops before the first value that does not fit, so a caller with a fixed
+// buffer can flush and call again with values.subspan(result.values, ...).
+// Out-of-range values are written as "?". Bytes past result.bytes may have
+// been overwritten by the fixed-size copies.
+template <typename E>
+FormatResult formatEnums(Span<const E> values, Span<char> out, char separator = '\n') {
+    using Padded = enum_detail::PaddedNames<E>;
+    char* p = out.data();
+    char* const end = p + out.size();
+    size_t i = 0;
+    for (; i < values.size(); ++i) {
+        size_t index = enumIndex(values[i]);
+        std::string_view name = index < enumCount<E>() ? EnumNames<E>::names[index] : "?";
+        if constexpr (Padded::kUsable) {
+            if (index < enumCount<E>() && static_cast<size_t>(end - p) >= enum_detail::kPadded) {
+                std::memcpy(p, Padded::table[index].data(), enum_detail::kPadded);
+                p += name.size();
+                *p++ = separator;
+                continue;
+            }
+        }
+        if (static_cast<size_t>(end - p) < name.size() + 1) break;
+        std::memcpy(p, name.data(), name.size());
+        p += name.size();
+        *p++ = separator;
+    }
+    return {i, static_cast<size_t>(p - out.data())};
+}
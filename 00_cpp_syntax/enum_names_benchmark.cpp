@@ -0,0 +1,168 @@
+// Enum-to-text for report generation: switch returning std::string vs name tables.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o enum_names_benchmark enum_names_benchmark.cpp
+//     ./enum_names_benchmark [values]      (default: 10000000)
+//
+// Every variant writes one line per value and hands the text to a sink in
+// 64 KiB chunks, the way a report writer feeding a file would. A byte sum of
+// the output confirms they agree.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "enum_names.h"
+
+enum class Suit { Hearts, Diamonds, Clubs, Spades };
+
+enum class Rank {
+    Ace = 1, Two, Three, Four, Five, Six, Seven, Eight, Nine, Ten,
+    Jack, Queen, King
+};
+
+// solution.cpp before: a switch building a std::string per call
+std::string suitToStringBySwitch(Suit s) {
+    switch (s) {
+        case Suit::Hearts:   return "Hearts";
+        case Suit::Diamonds: return "Diamonds";
+        case Suit::Clubs:    return "Clubs";
+        case Suit::Spades:   return "Spades";
+        default:             return "Unknown";
+    }
+}
+
+std::string rankToStringBySwitch(Rank r) {
+    switch (r) {
+        case Rank::Ace:   return "Ace";
+        case Rank::Jack:  return "Jack";
+        case Rank::Queen: return "Queen";
+        case Rank::King:  return "King";
+        default:          return std::to_string(static_cast<int>(r));
+    }
+}
+
+template <>
+struct EnumNames<Suit> {
+    static constexpr int first = 0;
+    static constexpr std::array<std::string_view, 4> names{
+        "Hearts", "Diamonds", "Clubs", "Spades"};
+};
+
+template <>
+struct EnumNames<Rank> {
+    static constexpr int first = static_cast<int>(Rank::Ace);
+    static constexpr std::array<std::string_view, 13> names{
+        "Ace", "2", "3", "4", "5", "6", "7", "8", "9", "10", "Jack", "Queen", "King"};
+};
+
+constexpr size_t kChunk = 64 * 1024;
+
+// Stands in for fwrite. Sums the bytes so the outputs can be compared; the sum
+// vectorizes, so the sink stays cheap next to the formatting being measured.
+struct Sink {
+    std::uint64_t checksum = 0;
+    size_t bytes = 0;
+
+    void write(const char* data, size_t n) {
+        for (size_t i = 0; i < n; ++i) checksum += static_cast<unsigned char>(data[i]);
+        bytes += n;
+    }
+
+    bool operator==(const Sink& o) const { return checksum == o.checksum && bytes == o.bytes; }
+};
+
+// Build text into a chunk, one append per value, flushing when nearly full
+template <typename Append>
+Sink appendAll(size_t n, Append&& append) {
+    Sink sink;
+    std::string out;
+    out.reserve(kChunk);
+    for (size_t i = 0; i < n; ++i) {
+        append(out, i);
+        if (out.size() >= kChunk - 32) {
+            sink.write(out.data(), out.size());
+            out.clear();
+        }
+    }
+    sink.write(out.data(), out.size());
+    return sink;
+}
+
+int main(int argc, char** argv) {
+    size_t n = std::max<size_t>(1, bench::argOr(argc, argv, 1, 10000000));
+    std::printf("=== Enum to Text (%zu values) ===\n\n", n);
+
+    std::mt19937 rng(8);
+    std::vector<Suit> suits(n);
+    std::vector<Rank> ranks(n);
+    for (size_t i = 0; i < n; ++i) {
+        suits[i] = static_cast<Suit>(rng() % 4);
+        ranks[i] = static_cast<Rank>(rng() % 13 + 1);
+    }
+
+    // 1. A suit column, one per line: all three approaches
+    Sink switchSuits, viewSuits, bulkSuits;
+    double switchNs = bench::bestOfNs([&] {
+        switchSuits = appendAll(n, [&](std::string& out, size_t i) {
+            out += suitToStringBySwitch(suits[i]) + "\n";
+        });
+    }, 3);
+    double viewNs = bench::bestOfNs([&] {
+        viewSuits = appendAll(n, [&](std::string& out, size_t i) {
+            out += enumName(suits[i]);
+            out += '\n';
+        });
+    }, 3);
+    std::vector<char> buffer(kChunk);
+    double bulkNs = bench::bestOfNs([&] {
+        bulkSuits = Sink();
+        Span<const Suit> rest(suits);
+        while (!rest.empty()) {
+            FormatResult r = formatEnums(rest, buffer);
+            bulkSuits.write(buffer.data(), r.bytes);
+            rest = rest.subspan(r.values, rest.size() - r.values);
+        }
+    }, 3);
+
+    std::printf("suit column (\"Spades\\n\" per value):\n");
+    std::printf("  %-40s %8.2f ns/value\n", "switch -> std::string", switchNs / n);
+    std::printf("  %-40s %8.2f ns/value   (%.1fx)\n", "enumName -> string_view", viewNs / n,
+                switchNs / viewNs);
+    std::printf("  %-40s %8.2f ns/value   (%.1fx)\n", "formatEnums into a 64 KiB buffer", bulkNs / n,
+                switchNs / bulkNs);
+
+    // 2. Whole cards, "Queen of Spades\n": per-call strings vs string_views
+    Sink switchCards, viewCards;
+    double switchCardNs = bench::bestOfNs([&] {
+        switchCards = appendAll(n, [&](std::string& out, size_t i) {
+            out += rankToStringBySwitch(ranks[i]) + " of " + suitToStringBySwitch(suits[i]) + "\n";
+        });
+    }, 3);
+    double viewCardNs = bench::bestOfNs([&] {
+        viewCards = appendAll(n, [&](std::string& out, size_t i) {
+            out += enumName(ranks[i]);
+            out += " of ";
+            out += enumName(suits[i]);
+            out += '\n';
+        });
+    }, 3);
+
+    std::printf("\ncards (\"Queen of Spades\\n\" per value):\n");
+    std::printf("  %-40s %8.2f ns/value\n", "switch -> std::string, operator+", switchCardNs / n);
+    std::printf("  %-40s %8.2f ns/value   (%.1fx)\n", "enumName -> string_view, append",
+                viewCardNs / n, switchCardNs / viewCardNs);
+
+    bool ok = switchSuits == viewSuits && viewSuits == bulkSuits && switchCards == viewCards;
+    for (size_t i = 0; i < 4; ++i) {
+        auto suit = static_cast<Suit>(i);
+        ok = ok && enumFromName<Suit>(enumName(suit)) == suit;
+    }
+    ok = ok && !enumFromName<Suit>("Jokers").has_value();
+    std::printf("\n%zu + %zu bytes of text, outputs %s\n", viewSuits.bytes, viewCards.bytes,
+                ok ? "match" : "MISMATCH");
+    return ok ? 0 : 1;
+}
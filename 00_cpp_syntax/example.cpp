@@ -4,6 +4,9 @@
 #include <map>
 #include <tuple>
 
+#include "../common/output_sink.h"
+#include "lookup_tables.h"
+
 // =============================================================================
 // Example 1: Namespaces
 // C has one global scope; C++ lets you organize names into namespaces.
@@ -56,6 +59,15 @@ void demoIOStream() {
     // Chaining: each << returns the stream, so calls can be chained
     std::cout << "Hex: " << std::hex << 255 << std::dec << std::endl;
 
+    // std::endl = '\n' + flush (a system call). For bulk output, a buffered
+    // sink that formats with std::to_chars and flushes only when asked is
+    // several times faster (see common/output_sink.h)
+    OutputSink out(stdout);
+    for (int i = 1; i <= 3; ++i) {
+        out << "row " << i << ": " << i * gpa << '\n';
+    }
+    out.flush();  // Before the next std::cout, so the lines stay in order
+
     std::cout << std::endl;
 }
 
@@ -219,6 +231,8 @@ void demoDefaultParams() {
 // =============================================================================
 // Example 9: constexpr — compile-time computation
 // =============================================================================
+// Fine in constant expressions. At runtime, prefer the tables in
+// lookup_tables.h: this fibonacci is exponential and int overflows at 13!.
 constexpr int factorial(int n) {
     return (n <= 1) ? 1 : n * factorial(n - 1);
 }
@@ -243,6 +257,15 @@ void demoConstexpr() {
     int buffer[SIZE];
     std::cout << "buffer has " << SIZE << " elements" << std::endl;
 
+    // Tables built at compile time, indexed with a runtime value
+    int n = 90;  // An ordinary runtime variable
+    std::cout << "F" << n << " = " << *checkedFibonacci(n) << std::endl;
+    std::cout << "20! = " << *checkedFactorial(20) << std::endl;
+    std::cout << "21! fits in 64 bits: " << std::boolalpha
+              << checkedFactorial(21).has_value() << std::endl;  // false
+    std::cout << "F(10^18) mod 1000000007 = " << fibonacciMod(1000000000000000000ULL, 1000000007)
+              << std::endl;
+
     std::cout << std::endl;
 }
 
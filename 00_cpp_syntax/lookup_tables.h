@@ -0,0 +1,150 @@
+#pragma once
+
+// Compile-time lookup tables built with constexpr functions.
+//
+//     constexpr auto squares = makeLookupTable<16>([](size_t i) { return i * i; });
+//     static_assert(squares[5] == 25);
+//
+// The recursive `factorial` / `fibonacci` in example.cpp are fine inside a
+// constant expression, but called at runtime with a variable argument the
+// naive fibonacci is exponential (unusable past n ~ 40) and an int factorial
+// silently overflows at 13!. Here both are precomputed into std::array tables
+// of 64-bit values: a runtime call is a bounds check plus one load.
+//
+//   - Overflow-checked: table sizes are derived from where uint64_t overflows
+//     (20! and F(93) are the last exact values), and the checked accessors
+//     return std::nullopt beyond that instead of a wrapped result
+//   - fibonacciMod(n, m) uses fast doubling for any n in O(log n), for when
+//     F(n) itself no longer fits in 64 bits
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+// table[i] = f(i) for i in [0, N), evaluated at compile time when assigned to
+// a constexpr variable
+template <size_t N, typename F>
+constexpr auto makeLookupTable(F f) {
+    std::array<decltype(f(size_t{0})), N> table{};
+    for (size_t i = 0; i < N; ++i) table[i] = f(i);
+    return table;
+}
+
+namespace lookup_detail {
+
+constexpr std::uint64_t kU64Max = std::numeric_limits<std::uint64_t>::max();
+
+// Largest n with n! representable in uint64_t
+constexpr size_t lastExactFactorial() {
+    std::uint64_t value = 1;
+    size_t n = 0;
+    while (value <= kU64Max / (n + 1)) value *= ++n;
+    return n;
+}
+
+// Largest n with F(n) representable in uint64_t
+constexpr size_t lastExactFibonacci() {
+    std::uint64_t a = 0, b = 1;  // F(n), F(n + 1)
+    size_t n = 0;
+    while (b <= kU64Max - a) {
+        std::uint64_t next = a + b;
+        a = b;
+        b = next;
+        ++n;
+    }
+    return n + 1;  // b = F(n + 1) still fit; F(n + 2) would not
+}
+
+// a + b and a - b mod m, for a, b < m, without overflow for any m
+constexpr std::uint64_t addMod(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+    return a >= m - b ? a - (m - b) : a + b;
+}
+
+constexpr std::uint64_t subMod(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+    return a >= b ? a - b : a + (m - b);
+}
+
+constexpr std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+#else
+    // Double-and-add: every intermediate stays below m
+    std::uint64_t result = 0;
+    a %= m;
+    while (b) {
+        if (b & 1) result = addMod(result, a, m);
+        a = addMod(a, a, m);
+        b >>= 1;
+    }
+    return result;
+#endif
+}
+
+}  // namespace lookup_detail
+
+inline constexpr size_t kFactorialTableSize = lookup_detail::lastExactFactorial() + 1;
+inline constexpr size_t kFibonacciTableSize = lookup_detail::lastExactFibonacci() + 1;
+
+inline constexpr auto kFactorials = makeLookupTable<kFactorialTableSize>([](size_t n) {
+    std::uint64_t value = 1;
+    for (size_t i = 2; i <= n; ++i) value *= i;
+    return value;
+});
+
+inline constexpr auto kFibonacci = makeLookupTable<kFibonacciTableSize>([](size_t n) {
+    std::uint64_t a = 0, b = 1;
+    for (size_t i = 0; i < n; ++i) {
+        std::uint64_t next = a + b;
+        a = b;
+        b = next;
+    }
+    return a;
+});
+
+static_assert(kFactorialTableSize == 21 && kFactorials[20] == 2432902008176640000ULL);
+static_assert(kFibonacciTableSize == 94 && kFibonacci[93] == 12200160415121876738ULL);
+
+// n! if it fits in 64 bits
+constexpr std::optional<std::uint64_t> checkedFactorial(size_t n) {
+    if (n >= kFactorialTableSize) return std::nullopt;
+    return kFactorials[n];
+}
+
+// F(n) if it fits in 64 bits
+constexpr std::optional<std::uint64_t> checkedFibonacci(size_t n) {
+    if (n >= kFibonacciTableSize) return std::nullopt;
+    return kFibonacci[n];
+}
+
+// F(n) mod m for any n, m > 0. Fast doubling:
+//   F(2k)     = F(k) * (2 F(k+1) - F(k))
+//   F(2k + 1) = F(k)^2 + F(k+1)^2
+constexpr std::uint64_t fibonacciMod(std::uint64_t n, std::uint64_t m) {
+    using lookup_detail::addMod;
+    using lookup_detail::mulMod;
+    using lookup_detail::subMod;
+    if (m == 1) return 0;
+    if (n < kFibonacciTableSize) return kFibonacci[n] % m;
+
+    int top = 63;
+    while (!((n >> top) & 1)) --top;  // n >= kFibonacciTableSize, so some bit is set
+
+    std::uint64_t a = 0, b = 1;  // F(k), F(k + 1) for k = leading bits of n
+    for (int bit = top; bit >= 0; --bit) {
+        std::uint64_t c = mulMod(a, subMod(addMod(b, b, m), a, m), m);  // F(2k)
+        std::uint64_t d = addMod(mulMod(a, a, m), mulMod(b, b, m), m);  // F(2k + 1)
+        if ((n >> bit) & 1) {
+            a = d;
+            b = addMod(c, d, m);
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+static_assert(fibonacciMod(93, 1000000007) == kFibonacci[93] % 1000000007);
+static_assert(fibonacciMod(1000, 1000000007) == 517691607ULL);
@@ -0,0 +1,125 @@
+// Runtime calls with non-constant arguments: recursion / switch vs constexpr tables.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o lookup_tables_benchmark lookup_tables_benchmark.cpp
+//     ./lookup_tables_benchmark [calls]      (default: 10000000)
+//
+// Arguments come from a runtime array so nothing can be folded at compile time.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "lookup_tables.h"
+
+// example.cpp's versions, widened to 64 bits so results can be compared
+constexpr std::uint64_t factorialRecursive(std::uint64_t n) {
+    return (n <= 1) ? 1 : n * factorialRecursive(n - 1);
+}
+
+constexpr std::uint64_t fibonacciRecursive(std::uint64_t n) {
+    if (n <= 0) return 0;
+    if (n == 1) return 1;
+    return fibonacciRecursive(n - 1) + fibonacciRecursive(n - 2);
+}
+
+// solution.cpp's grade conversion, before and after
+enum class Grade { A, B, C, D, F };
+
+constexpr double gradeToGPAByCase(Grade g) {
+    switch (g) {
+        case Grade::A: return 4.0;
+        case Grade::B: return 3.0;
+        case Grade::C: return 2.0;
+        case Grade::D: return 1.0;
+        case Grade::F: return 0.0;
+        default:       return 0.0;
+    }
+}
+
+inline constexpr auto kGradeGPA = makeLookupTable<5>(
+    [](size_t i) { return gradeToGPAByCase(static_cast<Grade>(i)); });
+
+double gradeToGPA(Grade g) {
+    size_t i = static_cast<size_t>(g);
+    return i < kGradeGPA.size() ? kGradeGPA[i] : 0.0;
+}
+
+template <typename Fn>
+void row(const char* label, size_t calls, Fn&& fn, double baselineNs = 0.0) {
+    double ns = bench::bestOfNs(fn, 3);
+    if (baselineNs > 0.0)
+        std::printf("  %-36s %10.2f ns/call   (%.0fx)\n", label, ns / calls, baselineNs / ns);
+    else
+        std::printf("  %-36s %10.2f ns/call\n", label, ns / calls);
+}
+
+int main(int argc, char** argv) {
+    size_t calls = std::max<size_t>(1, bench::argOr(argc, argv, 1, 10000000));
+    std::printf("=== constexpr Lookup Tables (%zu calls) ===\n\n", calls);
+
+    std::mt19937 rng(5);
+    std::vector<std::uint32_t> factArgs(calls), fibArgs(calls);
+    std::vector<Grade> grades(calls);
+    for (auto& n : factArgs) n = rng() % kFactorialTableSize;
+    for (auto& n : fibArgs) n = rng() % kFibonacciTableSize;
+    for (auto& g : grades) g = static_cast<Grade>(rng() % 5);
+
+    std::printf("factorial(n), n in [0, 20]:\n");
+    std::uint64_t a = 0, b = 0;
+    double factRecNs = bench::bestOfNs([&] {
+        for (auto n : factArgs) a += factorialRecursive(n);
+        bench::doNotOptimize(a);
+    }, 3);
+    std::printf("  %-36s %10.2f ns/call\n", "recursive", factRecNs / calls);
+    row("kFactorials table", calls, [&] {
+        for (auto n : factArgs) b += *checkedFactorial(n);
+        bench::doNotOptimize(b);
+    }, factRecNs);
+
+    // Exponential: only a few calls, at a modest n
+    std::printf("\nfibonacci(n), n in [0, 93]:\n");
+    const std::uint64_t slowN = 32;
+    size_t slowCalls = std::min<size_t>(3, calls);  // fibArgs has `calls` entries
+    double fibRecNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < slowCalls; ++i)
+            bench::doNotOptimize(fibonacciRecursive(slowN + (fibArgs[i] & 1)));
+    }, 3) / slowCalls;
+    std::printf("  %-36s %10.0f ns/call   (n = %llu only; n = 93 would take centuries)\n",
+                "recursive", fibRecNs, static_cast<unsigned long long>(slowN));
+    std::uint64_t c = 0;
+    double fibTableNs = bench::bestOfNs([&] {
+        for (auto n : fibArgs) c += *checkedFibonacci(n);
+        bench::doNotOptimize(c);
+    }, 3);
+    std::printf("  %-36s %10.2f ns/call   (%.0fx vs n = %llu)\n", "kFibonacci table",
+                fibTableNs / calls, fibRecNs / (fibTableNs / calls),
+                static_cast<unsigned long long>(slowN));
+    std::uint64_t d = 0;
+    size_t modCalls = std::max<size_t>(1, calls / 10);
+    double fastNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < modCalls; ++i) d += fibonacciMod(1000000000000ULL + fibArgs[i], 1000000007);
+        bench::doNotOptimize(d);
+    }, 3);
+    std::printf("  %-36s %10.2f ns/call\n", "fibonacciMod(~10^12, p), fast doubling",
+                fastNs / modCalls);
+
+    std::printf("\ngradeToGPA over random grades:\n");
+    double e = 0.0, f = 0.0;
+    double switchNs = bench::bestOfNs([&] {
+        for (auto g : grades) e += gradeToGPAByCase(g);
+        bench::doNotOptimize(e);
+    }, 3);
+    std::printf("  %-36s %10.2f ns/call\n", "switch", switchNs / calls);
+    row("kGradeGPA table", calls, [&] {
+        for (auto g : grades) f += gradeToGPA(g);
+        bench::doNotOptimize(f);
+    }, switchNs);
+
+    bool ok = a == b && e == f && kGradeGPA[1] == gradeToGPAByCase(Grade::B);
+    for (std::uint64_t n = 0; n <= 25; ++n) ok = ok && fibonacciRecursive(n) == kFibonacci[n];
+    std::printf("\nresults %s\n", ok ? "match" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -4,6 +4,9 @@
 #include <map>
 #include <tuple>
 
+#include "enum_names.h"
+#include "lookup_tables.h"
+
 // =============================================================================
 // SOLUTION 1: Namespaces
 // =============================================================================
@@ -173,25 +176,23 @@ enum class Rank {
     Jack, Queen, King
 };
 
-std::string suitToString(Suit s) {
-    switch (s) {
-        case Suit::Hearts:   return "Hearts";
-        case Suit::Diamonds: return "Diamonds";
-        case Suit::Clubs:    return "Clubs";
-        case Suit::Spades:   return "Spades";
-        default:             return "Unknown";
-    }
-}
+template <>
+struct EnumNames<Suit> {
+    static constexpr int first = 0;
+    static constexpr std::array<std::string_view, 4> names{
+        "Hearts", "Diamonds", "Clubs", "Spades"};
+};
 
-std::string rankToString(Rank r) {
-    switch (r) {
-        case Rank::Ace:   return "Ace";
-        case Rank::Jack:  return "Jack";
-        case Rank::Queen: return "Queen";
-        case Rank::King:  return "King";
-        default:          return std::to_string(static_cast<int>(r));
-    }
-}
+template <>
+struct EnumNames<Rank> {
+    static constexpr int first = static_cast<int>(Rank::Ace);
+    static constexpr std::array<std::string_view, 13> names{
+        "Ace", "2", "3", "4", "5", "6", "7", "8", "9", "10", "Jack", "Queen", "King"};
+};
+
+// Names live in static tables: no std::string is built per call
+constexpr std::string_view suitToString(Suit s) { return enumName(s); }
+constexpr std::string_view rankToString(Rank r) { return enumName(r); }
 
 void testEnumClass() {
     std::cout << "=== Exercise 6: Enum Classes ===" << std::endl;
@@ -206,6 +207,15 @@ void testEnumClass() {
 
     // int x = s;  // Does NOT compile with enum class — that's the point!
 
+    // And back from text, then a whole hand into one buffer
+    if (auto parsed = enumFromName<Suit>("Diamonds")) {
+        std::cout << "Parsed \"Diamonds\" -> " << suitToString(*parsed) << std::endl;
+    }
+    std::vector<Suit> hand{Suit::Clubs, Suit::Hearts, Suit::Spades};
+    char buffer[64];
+    FormatResult written = formatEnums<Suit>(hand, buffer, ' ');
+    std::cout << "Hand: " << std::string_view(buffer, written.bytes) << std::endl;
+
     std::cout << std::endl;
 }
 
@@ -248,7 +258,8 @@ void testStructuredBindings() {
 // =============================================================================
 enum class Grade { A, B, C, D, F };
 
-constexpr double gradeToGPA(Grade g) {
+// Source of truth for the table below; use gradeToGPA at runtime
+constexpr double gradeToGPAByCase(Grade g) {
     switch (g) {
         case Grade::A: return 4.0;
         case Grade::B: return 3.0;
@@ -259,26 +270,38 @@ constexpr double gradeToGPA(Grade g) {
     }
 }
 
-std::string gradeToString(Grade g) {
-    switch (g) {
-        case Grade::A: return "A";
-        case Grade::B: return "B";
-        case Grade::C: return "C";
-        case Grade::D: return "D";
-        case Grade::F: return "F";
-        default:       return "?";
-    }
+inline constexpr size_t kGradeCount = static_cast<size_t>(Grade::F) + 1;
+inline constexpr auto kGradeGPA = makeLookupTable<kGradeCount>(
+    [](size_t i) { return gradeToGPAByCase(static_cast<Grade>(i)); });
+
+// One indexed load instead of a compare-and-branch chain; out-of-range
+// values still get the switch's default of 0.0, for the cost of one compare
+constexpr double gradeToGPA(Grade g) {
+    size_t i = static_cast<size_t>(g);
+    return i < kGradeCount ? kGradeGPA[i] : 0.0;
 }
+static_assert(gradeToGPA(Grade::B) == 3.0);
+static_assert(gradeToGPA(static_cast<Grade>(7)) == 0.0);
+
+template <>
+struct EnumNames<Grade> {
+    static constexpr int first = 0;
+    static constexpr std::array<std::string_view, kGradeCount> names{"A", "B", "C", "D", "F"};
+};
+
+constexpr std::string_view gradeToString(Grade g) { return enumName(g, "?"); }
 
 std::pair<double, Grade> analyzeGrades(const std::vector<Grade>& grades) {
     double total = 0.0;
     Grade best = Grade::F;
+    double bestGPA = gradeToGPA(best);  // Cached: no re-conversion per iteration
 
     for (const auto& g : grades) {
         double gpa = gradeToGPA(g);
         total += gpa;
-        if (gpa > gradeToGPA(best)) {
+        if (gpa > bestGPA) {
             best = g;
+            bestGPA = gpa;
         }
     }
 
@@ -0,0 +1,478 @@
+#pragma once
+
+// Element-wise in-place kernels with runtime CPU dispatch.
+//
+//     std::vector<int> values = ...;
+//     kernels::scale(Span<int>(values), 2);            // doubleAllValues, vectorized
+//     kernels::add(Span<float>(f), 0.5f);
+//     kernels::clamp(Span<double>(d), 0.0, 1.0);
+//     kernels::multiplyAdd(Span<float>(f), 1.8f, 32.0f); // x = x * 1.8 + 32
+//
+// The first call picks the widest instruction set the CPU (and OS) supports:
+// AVX-512F, AVX2+FMA or SSE4.2 on x86, NEON on AArch64, plain scalar code
+// elsewhere. Unlike complex_buffer.h, which picks its kernel width at compile
+// time, this means one binary built without -march flags still uses AVX-512
+// where it exists. forceIsa() overrides the choice, e.g. to compare levels.
+//
+// Each kernel runs scalar steps until the pointer reaches a vector-aligned
+// address, uses aligned loads and stores (unrolled by two) for the bulk, and
+// finishes the last partial vector with scalar steps. Heads and tails compute
+// exactly what the vector body would.
+//
+// Semantics:
+//   - int arithmetic wraps modulo 2^32 (as the SIMD instructions do) instead
+//     of being undefined on overflow
+//   - float/double multiplyAdd is fused (one rounding) on AVX2, AVX-512 and
+//     NEON, and a separate multiply and add on SSE4.2 and scalar, so the last
+//     bit can differ between machines
+//   - clamp(lo, hi) requires lo <= hi; NaN inputs give an unspecified result
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../common/span.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define INPLACE_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define INPLACE_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang compile each level's entry point for its own instruction set;
+// MSVC accepts the intrinsics anywhere
+#if defined(_MSC_VER) && !defined(__clang__)
+#define KERNELS_TARGET(isa)
+#define KERNELS_INLINE __forceinline
+#else
+#define KERNELS_TARGET(isa) __attribute__((target(isa)))
+#define KERNELS_INLINE inline __attribute__((always_inline))
+#endif
+
+// The per-level structs take vector types by value; GCC warns that this would
+// change the ABI if they were ever real calls, which they are not
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace kernels {
+
+static_assert(sizeof(int) == 4, "int kernels assume 32-bit int");
+
+enum class Isa { Scalar, Sse42, Avx2, Avx512, Neon };
+
+inline const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Sse42:  return "SSE4.2";
+        case Isa::Avx2:   return "AVX2";
+        case Isa::Avx512: return "AVX-512";
+        case Isa::Neon:   return "NEON";
+        default:          return "scalar";
+    }
+}
+
+namespace detail {
+
+enum class Op { Scale, Add, Clamp, MultiplyAdd };
+
+// ---- Vector operations, one struct per instruction set and element type ----
+
+#if defined(INPLACE_KERNELS_X86)
+#define KERNELS_SSE42 KERNELS_TARGET("sse4.2")
+#define KERNELS_AVX2 KERNELS_TARGET("avx2,fma")
+#define KERNELS_AVX512 KERNELS_TARGET("avx512f")
+
+template <typename T> struct Sse42;
+template <typename T> struct Avx2;
+template <typename T> struct Avx512;
+
+template <>
+struct Sse42<int> {
+    using V = __m128i;
+    static constexpr size_t width = 4;
+    static constexpr bool fused = false;
+    KERNELS_SSE42 static V set1(int x) { return _mm_set1_epi32(x); }
+    KERNELS_SSE42 static V load(const int* p) { return _mm_load_si128(reinterpret_cast<const V*>(p)); }
+    KERNELS_SSE42 static void store(int* p, V v) { _mm_store_si128(reinterpret_cast<V*>(p), v); }
+    KERNELS_SSE42 static V add(V a, V b) { return _mm_add_epi32(a, b); }
+    KERNELS_SSE42 static V mul(V a, V b) { return _mm_mullo_epi32(a, b); }
+    KERNELS_SSE42 static V min(V a, V b) { return _mm_min_epi32(a, b); }
+    KERNELS_SSE42 static V max(V a, V b) { return _mm_max_epi32(a, b); }
+    KERNELS_SSE42 static V fma(V x, V a, V b) { return add(mul(x, a), b); }
+};
+
+template <>
+struct Sse42<float> {
+    using V = __m128;
+    static constexpr size_t width = 4;
+    static constexpr bool fused = false;
+    KERNELS_SSE42 static V set1(float x) { return _mm_set1_ps(x); }
+    KERNELS_SSE42 static V load(const float* p) { return _mm_load_ps(p); }
+    KERNELS_SSE42 static void store(float* p, V v) { _mm_store_ps(p, v); }
+    KERNELS_SSE42 static V add(V a, V b) { return _mm_add_ps(a, b); }
+    KERNELS_SSE42 static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    KERNELS_SSE42 static V min(V a, V b) { return _mm_min_ps(a, b); }
+    KERNELS_SSE42 static V max(V a, V b) { return _mm_max_ps(a, b); }
+    KERNELS_SSE42 static V fma(V x, V a, V b) { return add(mul(x, a), b); }
+};
+
+template <>
+struct Sse42<double> {
+    using V = __m128d;
+    static constexpr size_t width = 2;
+    static constexpr bool fused = false;
+    KERNELS_SSE42 static V set1(double x) { return _mm_set1_pd(x); }
+    KERNELS_SSE42 static V load(const double* p) { return _mm_load_pd(p); }
+    KERNELS_SSE42 static void store(double* p, V v) { _mm_store_pd(p, v); }
+    KERNELS_SSE42 static V add(V a, V b) { return _mm_add_pd(a, b); }
+    KERNELS_SSE42 static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    KERNELS_SSE42 static V min(V a, V b) { return _mm_min_pd(a, b); }
+    KERNELS_SSE42 static V max(V a, V b) { return _mm_max_pd(a, b); }
+    KERNELS_SSE42 static V fma(V x, V a, V b) { return add(mul(x, a), b); }
+};
+
+template <>
+struct Avx2<int> {
+    using V = __m256i;
+    static constexpr size_t width = 8;
+    static constexpr bool fused = false;
+    KERNELS_AVX2 static V set1(int x) { return _mm256_set1_epi32(x); }
+    KERNELS_AVX2 static V load(const int* p) { return _mm256_load_si256(reinterpret_cast<const V*>(p)); }
+    KERNELS_AVX2 static void store(int* p, V v) { _mm256_store_si256(reinterpret_cast<V*>(p), v); }
+    KERNELS_AVX2 static V add(V a, V b) { return _mm256_add_epi32(a, b); }
+    KERNELS_AVX2 static V mul(V a, V b) { return _mm256_mullo_epi32(a, b); }
+    KERNELS_AVX2 static V min(V a, V b) { return _mm256_min_epi32(a, b); }
+    KERNELS_AVX2 static V max(V a, V b) { return _mm256_max_epi32(a, b); }
+    KERNELS_AVX2 static V fma(V x, V a, V b) { return add(mul(x, a), b); }
+};
+
+template <>
+struct Avx2<float> {
+    using V = __m256;
+    static constexpr size_t width = 8;
+    static constexpr bool fused = true;
+    KERNELS_AVX2 static V set1(float x) { return _mm256_set1_ps(x); }
+    KERNELS_AVX2 static V load(const float* p) { return _mm256_load_ps(p); }
+    KERNELS_AVX2 static void store(float* p, V v) { _mm256_store_ps(p, v); }
+    KERNELS_AVX2 static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    KERNELS_AVX2 static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    KERNELS_AVX2 static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    KERNELS_AVX2 static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    KERNELS_AVX2 static V fma(V x, V a, V b) { return _mm256_fmadd_ps(x, a, b); }
+};
+
+template <>
+struct Avx2<double> {
+    using V = __m256d;
+    static constexpr size_t width = 4;
+    static constexpr bool fused = true;
+    KERNELS_AVX2 static V set1(double x) { return _mm256_set1_pd(x); }
+    KERNELS_AVX2 static V load(const double* p) { return _mm256_load_pd(p); }
+    KERNELS_AVX2 static void store(double* p, V v) { _mm256_store_pd(p, v); }
+    KERNELS_AVX2 static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    KERNELS_AVX2 static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    KERNELS_AVX2 static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    KERNELS_AVX2 static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    KERNELS_AVX2 static V fma(V x, V a, V b) { return _mm256_fmadd_pd(x, a, b); }
+};
+
+template <>
+struct Avx512<int> {
+    using V = __m512i;
+    static constexpr size_t width = 16;
+    static constexpr bool fused = false;
+    KERNELS_AVX512 static V set1(int x) { return _mm512_set1_epi32(x); }
+    KERNELS_AVX512 static V load(const int* p) { return _mm512_load_si512(p); }
+    KERNELS_AVX512 static void store(int* p, V v) { _mm512_store_si512(p, v); }
+    KERNELS_AVX512 static V add(V a, V b) { return _mm512_add_epi32(a, b); }
+    KERNELS_AVX512 static V mul(V a, V b) { return _mm512_mullo_epi32(a, b); }
+    // Masked min/max (all lanes): GCC 12 flags the unmasked forms' internal
+    // undefined source operand with a bogus -Wmaybe-uninitialized
+    KERNELS_AVX512 static V min(V a, V b) { return _mm512_mask_min_epi32(a, 0xFFFF, a, b); }
+    KERNELS_AVX512 static V max(V a, V b) { return _mm512_mask_max_epi32(a, 0xFFFF, a, b); }
+    KERNELS_AVX512 static V fma(V x, V a, V b) { return add(mul(x, a), b); }
+};
+
+template <>
+struct Avx512<float> {
+    using V = __m512;
+    static constexpr size_t width = 16;
+    static constexpr bool fused = true;
+    KERNELS_AVX512 static V set1(float x) { return _mm512_set1_ps(x); }
+    KERNELS_AVX512 static V load(const float* p) { return _mm512_load_ps(p); }
+    KERNELS_AVX512 static void store(float* p, V v) { _mm512_store_ps(p, v); }
+    KERNELS_AVX512 static V add(V a, V b) { return _mm512_add_ps(a, b); }
+    KERNELS_AVX512 static V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+    KERNELS_AVX512 static V min(V a, V b) { return _mm512_mask_min_ps(a, 0xFFFF, a, b); }
+    KERNELS_AVX512 static V max(V a, V b) { return _mm512_mask_max_ps(a, 0xFFFF, a, b); }
+    KERNELS_AVX512 static V fma(V x, V a, V b) { return _mm512_fmadd_ps(x, a, b); }
+};
+
+template <>
+struct Avx512<double> {
+    using V = __m512d;
+    static constexpr size_t width = 8;
+    static constexpr bool fused = true;
+    KERNELS_AVX512 static V set1(double x) { return _mm512_set1_pd(x); }
+    KERNELS_AVX512 static V load(const double* p) { return _mm512_load_pd(p); }
+    KERNELS_AVX512 static void store(double* p, V v) { _mm512_store_pd(p, v); }
+    KERNELS_AVX512 static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    KERNELS_AVX512 static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    KERNELS_AVX512 static V min(V a, V b) { return _mm512_mask_min_pd(a, 0xFF, a, b); }
+    KERNELS_AVX512 static V max(V a, V b) { return _mm512_mask_max_pd(a, 0xFF, a, b); }
+    KERNELS_AVX512 static V fma(V x, V a, V b) { return _mm512_fmadd_pd(x, a, b); }
+};
+#endif  // INPLACE_KERNELS_X86
+
+#if defined(INPLACE_KERNELS_NEON)
+template <typename T> struct Neon;
+
+template <>
+struct Neon<int> {
+    using V = int32x4_t;
+    static constexpr size_t width = 4;
+    static constexpr bool fused = false;
+    static V set1(int x) { return vdupq_n_s32(x); }
+    static V load(const int* p) { return vld1q_s32(p); }
+    static void store(int* p, V v) { vst1q_s32(p, v); }
+    static V add(V a, V b) { return vaddq_s32(a, b); }
+    static V mul(V a, V b) { return vmulq_s32(a, b); }
+    static V min(V a, V b) { return vminq_s32(a, b); }
+    static V max(V a, V b) { return vmaxq_s32(a, b); }
+    static V fma(V x, V a, V b) { return vmlaq_s32(b, x, a); }
+};
+
+template <>
+struct Neon<float> {
+    using V = float32x4_t;
+    static constexpr size_t width = 4;
+    static constexpr bool fused = true;
+    static V set1(float x) { return vdupq_n_f32(x); }
+    static V load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, V v) { vst1q_f32(p, v); }
+    static V add(V a, V b) { return vaddq_f32(a, b); }
+    static V mul(V a, V b) { return vmulq_f32(a, b); }
+    static V min(V a, V b) { return vminq_f32(a, b); }
+    static V max(V a, V b) { return vmaxq_f32(a, b); }
+    static V fma(V x, V a, V b) { return vfmaq_f32(b, x, a); }
+};
+
+template <>
+struct Neon<double> {
+    using V = float64x2_t;
+    static constexpr size_t width = 2;
+    static constexpr bool fused = true;
+    static V set1(double x) { return vdupq_n_f64(x); }
+    static V load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, V v) { vst1q_f64(p, v); }
+    static V add(V a, V b) { return vaddq_f64(a, b); }
+    static V mul(V a, V b) { return vmulq_f64(a, b); }
+    static V min(V a, V b) { return vminq_f64(a, b); }
+    static V max(V a, V b) { return vmaxq_f64(a, b); }
+    static V fma(V x, V a, V b) { return vfmaq_f64(b, x, a); }
+};
+#endif  // INPLACE_KERNELS_NEON
+
+// ---- Shared loop ----
+
+template <Op op, bool fused, typename T>
+KERNELS_INLINE T applyScalar(T x, T a, T b) {
+    if constexpr (op == Op::Clamp) {
+        return std::min(std::max(x, a), b);
+    } else if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;  // Wrap like the vector instructions
+        if constexpr (op == Op::Scale) return static_cast<T>(U(x) * U(a));
+        else if constexpr (op == Op::Add) return static_cast<T>(U(x) + U(a));
+        else return static_cast<T>(U(x) * U(a) + U(b));
+    } else {
+        if constexpr (op == Op::Scale) return x * a;
+        else if constexpr (op == Op::Add) return x + a;
+        else if constexpr (fused) return std::fma(x, a, b);
+        else return x * a + b;
+    }
+}
+
+// Vectors by reference: this helper has no target attribute of its own, and
+// passing AVX types by value through it would trip GCC's ABI warning
+template <typename P, Op op>
+KERNELS_INLINE void applyVector(typename P::V& x, const typename P::V& a, const typename P::V& b) {
+    if constexpr (op == Op::Scale) x = P::mul(x, a);
+    else if constexpr (op == Op::Add) x = P::add(x, a);
+    else if constexpr (op == Op::Clamp) x = P::min(P::max(x, a), b);
+    else x = P::fma(x, a, b);
+}
+
+template <typename P, Op op, typename T>
+KERNELS_INLINE void runVector(T* p, size_t n, T a, T b) {
+    constexpr size_t W = P::width;
+    constexpr size_t kBytes = W * sizeof(T);
+    size_t i = 0;
+
+    // Head: scalar up to the first vector-aligned element
+    size_t misalignment = reinterpret_cast<std::uintptr_t>(p) % kBytes;
+    if (misalignment) {
+        size_t head = std::min(n, (kBytes - misalignment) / sizeof(T));
+        for (; i < head; ++i) p[i] = applyScalar<op, P::fused>(p[i], a, b);
+    }
+
+    auto va = P::set1(a);
+    auto vb = P::set1(b);
+    for (; i + 2 * W <= n; i += 2 * W) {
+        auto x0 = P::load(p + i);
+        auto x1 = P::load(p + i + W);
+        applyVector<P, op>(x0, va, vb);
+        applyVector<P, op>(x1, va, vb);
+        P::store(p + i, x0);
+        P::store(p + i + W, x1);
+    }
+    if (i + W <= n) {
+        auto x = P::load(p + i);
+        applyVector<P, op>(x, va, vb);
+        P::store(p + i, x);
+        i += W;
+    }
+
+    // Tail: the last partial vector
+    for (; i < n; ++i) p[i] = applyScalar<op, P::fused>(p[i], a, b);
+}
+
+template <Op op, typename T>
+void runScalar(T* p, size_t n, T a, T b) {
+    for (size_t i = 0; i < n; ++i) p[i] = applyScalar<op, false>(p[i], a, b);
+}
+
+#if defined(INPLACE_KERNELS_X86)
+template <Op op, typename T>
+KERNELS_SSE42 void runSse42(T* p, size_t n, T a, T b) { runVector<Sse42<T>, op>(p, n, a, b); }
+
+template <Op op, typename T>
+KERNELS_AVX2 void runAvx2(T* p, size_t n, T a, T b) { runVector<Avx2<T>, op>(p, n, a, b); }
+
+template <Op op, typename T>
+KERNELS_AVX512 void runAvx512(T* p, size_t n, T a, T b) { runVector<Avx512<T>, op>(p, n, a, b); }
+#endif
+
+#if defined(INPLACE_KERNELS_NEON)
+template <Op op, typename T>
+void runNeon(T* p, size_t n, T a, T b) { runVector<Neon<T>, op>(p, n, a, b); }
+#endif
+
+// ---- CPU detection ----
+
+inline Isa detectIsa() {
+#if defined(INPLACE_KERNELS_NEON)
+    return Isa::Neon;  // Baseline on AArch64
+#elif defined(INPLACE_KERNELS_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    int maxLeaf = regs[0];
+    __cpuid(regs, 1);
+    bool sse42 = (regs[2] >> 20) & 1;
+    bool fma = (regs[2] >> 12) & 1;
+    bool osxsave = (regs[2] >> 27) & 1;
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool avxState = (xcr0 & 0x6) == 0x6;       // XMM + YMM saved by the OS
+    bool avx512State = (xcr0 & 0xE6) == 0xE6;  // ... + opmask and ZMM
+    bool avx2 = false, avx512f = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(regs, 7, 0);
+        avx2 = (regs[1] >> 5) & 1;
+        avx512f = (regs[1] >> 16) & 1;
+    }
+    if (avx512f && avx512State) return Isa::Avx512;
+    if (avx2 && fma && avxState) return Isa::Avx2;
+    if (sse42) return Isa::Sse42;
+    return Isa::Scalar;
+#elif defined(INPLACE_KERNELS_X86)
+    __builtin_cpu_init();  // These checks include OS support for the register state
+    if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Isa::Avx2;
+    if (__builtin_cpu_supports("sse4.2")) return Isa::Sse42;
+    return Isa::Scalar;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+inline std::atomic<Isa>& selectedIsa() {
+    static std::atomic<Isa> isa{detectIsa()};
+    return isa;
+}
+
+template <Op op, typename T>
+void dispatch(Span<T> data, T a, T b) {
+    static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "kernels support int, float and double");
+    T* p = data.data();
+    size_t n = data.size();
+    switch (selectedIsa().load(std::memory_order_relaxed)) {
+#if defined(INPLACE_KERNELS_X86)
+        case Isa::Avx512: runAvx512<op>(p, n, a, b); return;
+        case Isa::Avx2:   runAvx2<op>(p, n, a, b); return;
+        case Isa::Sse42:  runSse42<op>(p, n, a, b); return;
+#endif
+#if defined(INPLACE_KERNELS_NEON)
+        case Isa::Neon:   runNeon<op>(p, n, a, b); return;
+#endif
+        default:          runScalar<op>(p, n, a, b); return;
+    }
+}
+
+}  // namespace detail
+
+// Instruction set the kernels currently use
+inline Isa activeIsa() { return detail::selectedIsa().load(std::memory_order_relaxed); }
+
+// Whether this CPU (and build) can run `isa`
+inline bool isaSupported(Isa isa) {
+    Isa best = detail::detectIsa();
+    if (isa == Isa::Scalar || isa == best) return true;
+    if (best == Isa::Neon || isa == Isa::Neon) return false;
+    return static_cast<int>(isa) <= static_cast<int>(best);  // x86 levels are ordered
+}
+
+// Switch every kernel to `isa`; returns false (and changes nothing) if unsupported
+inline bool forceIsa(Isa isa) {
+    if (!isaSupported(isa)) return false;
+    detail::selectedIsa().store(isa, std::memory_order_relaxed);
+    return true;
+}
+
+// x = x * factor
+template <typename T>
+void scale(Span<T> data, T factor) {
+    detail::dispatch<detail::Op::Scale>(data, factor, T{});
+}
+
+// x = x + value
+template <typename T>
+void add(Span<T> data, T value) {
+    detail::dispatch<detail::Op::Add>(data, value, T{});
+}
+
+// x = min(max(x, lo), hi)
+template <typename T>
+void clamp(Span<T> data, T lo, T hi) {
+    detail::dispatch<detail::Op::Clamp>(data, lo, hi);
+}
+
+// x = x * mul + addend
+template <typename T>
+void multiplyAdd(Span<T> data, T mul, T addend) {
+    detail::dispatch<detail::Op::MultiplyAdd>(data, mul, addend);
+}
+
+}  // namespace kernels
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
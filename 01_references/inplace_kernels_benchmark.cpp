@@ -0,0 +1,130 @@
+// In-place element-wise kernels: range-for loop vs each SIMD level, in GB/s.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o inplace_kernels_benchmark inplace_kernels_benchmark.cpp
+//     ./inplace_kernels_benchmark [MiB]      (default: 256 MiB per buffer)
+//
+// No -march flag is needed: the kernels pick their instruction set at runtime,
+// and this program runs every level the CPU supports. The baseline is the
+// plain loop from 01_references/solution.cpp (`for (auto& elem : vec) elem *= 2;`),
+// which the compiler may auto-vectorize for the baseline SSE2 only.
+//
+// GB/s counts bytes read plus bytes written. Each run starts one element past
+// a 64-byte boundary so the scalar heads are exercised, and each level's
+// result is checked against the scalar kernel.
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "inplace_kernels.h"
+
+const kernels::Isa kLevels[] = {kernels::Isa::Scalar, kernels::Isa::Sse42, kernels::Isa::Avx2,
+                                kernels::Isa::Avx512, kernels::Isa::Neon};
+
+template <typename T>
+bool closeEnough(const std::vector<T>& a, const std::vector<T>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if constexpr (std::is_integral_v<T>) {
+            if (a[i] != b[i]) return false;
+        } else {
+            // Fused and unfused multiply-add may differ in the last bit
+            T tolerance = std::abs(a[i]) * T(1e-6) + T(1e-6);
+            if (std::abs(a[i] - b[i]) > tolerance) return false;
+        }
+    }
+    return true;
+}
+
+// Run `kernel` on a fresh copy of `input` at every supported level
+template <typename T, typename Loop, typename Kernel>
+void runOp(const char* type, const char* op, const std::vector<T>& input, Loop&& loop,
+           Kernel&& kernel) {
+    size_t n = input.size() - 1;
+    double gb = 2.0 * n * sizeof(T) / 1e9;
+    std::vector<T> work(input.size()), reference(input.size());
+
+    auto span = [](std::vector<T>& v) { return Span<T>(v.data() + 1, v.size() - 1); };
+
+    // Reference: the scalar kernel
+    reference = input;
+    kernels::forceIsa(kernels::Isa::Scalar);
+    kernel(span(reference));
+
+    // Time only the kernel, not the refill
+    auto timeKernel = [&](auto&& fn) {
+        double best = 0;
+        for (int r = 0; r < 3; ++r) {
+            std::copy(input.begin(), input.end(), work.begin());
+            auto start = bench::Clock::now();
+            fn(span(work));
+            bench::clobberMemory();
+            double ns = std::chrono::duration<double, std::nano>(bench::Clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+        }
+        return best;
+    };
+    double loopNs = timeKernel(loop);
+    bool loopOk = closeEnough(work, reference);
+
+    std::printf("%-7s %-12s %-10s %8.2f GB/s%s\n", type, op, "range-for", gb / (loopNs / 1e9),
+                loopOk ? "" : "   MISMATCH");
+    for (kernels::Isa isa : kLevels) {
+        if (!kernels::forceIsa(isa)) continue;
+        double ns = timeKernel(kernel);
+        bool ok = closeEnough(work, reference);
+        std::printf("%-7s %-12s %-10s %8.2f GB/s   (%.1fx)%s\n", "", "", kernels::isaName(isa),
+                    gb / (ns / 1e9), loopNs / ns, ok ? "" : "   MISMATCH");
+    }
+}
+
+template <typename T>
+void runType(const char* type, size_t bytes) {
+    std::vector<T> input(bytes / sizeof(T) + 1);
+    for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<T>(static_cast<int>(i % 2001) - 1000);
+
+    runOp<T>(type, "scale x2", input,
+             [](Span<T> s) { for (auto& x : s) x *= T(2); },
+             [](Span<T> s) { kernels::scale(s, T(2)); });
+    runOp<T>(type, "add", input,
+             [](Span<T> s) { for (auto& x : s) x += T(7); },
+             [](Span<T> s) { kernels::add(s, T(7)); });
+    runOp<T>(type, "clamp", input,
+             [](Span<T> s) { for (auto& x : s) x = std::min(std::max(x, T(-100)), T(100)); },
+             [](Span<T> s) { kernels::clamp(s, T(-100), T(100)); });
+    runOp<T>(type, "multiplyAdd", input,
+             [](Span<T> s) { for (auto& x : s) x = x * T(3) + T(5); },
+             [](Span<T> s) { kernels::multiplyAdd(s, T(3), T(5)); });
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t mib = std::max<size_t>(1, bench::argOr(argc, argv, 1, 256));
+    size_t bytes = mib << 20;
+    kernels::Isa best = kernels::activeIsa();
+    std::printf("=== In-place Kernels (%zu MiB per buffer, detected %s) ===\n\n", mib,
+                kernels::isaName(best));
+
+    runType<int>("int", bytes);
+    runType<float>("float", bytes);
+    runType<double>("double", bytes);
+
+    // Small and odd sizes: heads and tails only
+    bool ok = true;
+    for (size_t n = 0; n < 70; ++n) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            std::vector<int> a(n + offset), b(n + offset);
+            for (size_t i = 0; i < a.size(); ++i) a[i] = b[i] = static_cast<int>(i) - 30;
+            kernels::forceIsa(best);
+            kernels::multiplyAdd(Span<int>(a.data() + offset, n), 3, -4);
+            kernels::forceIsa(kernels::Isa::Scalar);
+            kernels::multiplyAdd(Span<int>(b.data() + offset, n), 3, -4);
+            ok = ok && a == b;
+        }
+    }
+    std::printf("small sizes and offsets: %s\n", ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 
+#include "inplace_kernels.h"
+
 /*
  * SOLUTION 1: Implement a swap function using references
  */
@@ -34,6 +36,12 @@ void doubleAllValues(std::vector<int>& vec) {
     }
 }
 
+// Same result, for buffers large enough that throughput matters: SIMD kernel
+// chosen for this CPU at runtime (see inplace_kernels.h)
+void doubleAllValuesFast(std::vector<int>& vec) {
+    kernels::scale(Span<int>(vec), 2);
+}
+
 /*
  * SOLUTION 4: Return reference for chaining
  */
@@ -172,6 +180,11 @@ int main() {
     std::cout << "After doubling: ";
     for (int num : numbers) std::cout << num << " ";
     std::cout << std::endl;
+
+    doubleAllValuesFast(numbers);
+    std::cout << "Doubled again (" << kernels::isaName(kernels::activeIsa()) << " kernel): ";
+    for (int num : numbers) std::cout << num << " ";
+    std::cout << std::endl;
     std::cout << std::endl;
     
     std::cout << "=== Solution 4: Chaining ===" << std::endl;
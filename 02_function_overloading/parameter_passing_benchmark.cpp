@@ -0,0 +1,156 @@
+// What passing by value actually costs: ns/call and bytes copied, 8 B to 1 MB.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o parameter_passing_benchmark parameter_passing_benchmark.cpp
+//     ./parameter_passing_benchmark [bytes_per_size]      (default: 268435456)
+//
+// For each payload size, the same tiny function body (read the first and last
+// byte) is called through four signatures:
+//     f(Payload)            by value: the caller copies sizeof(Payload) bytes
+//     f(const Payload&)     by const reference
+//     f(Payload&&)          by rvalue reference (a reference too: no copy)
+//     f(const Payload*)     by pointer
+// once out of line (BENCH_NOINLINE, so the signature is what gets measured)
+// and once inlined, where the optimizer may remove the copy entirely.
+//
+// Calls per size are scaled so each size copies about the same total number
+// of bytes by value. The last rows repeat the measurement with
+// 01_references' LargeDataSet, whose std::string member makes a by-value copy
+// allocate as well.
+//
+// The 1 MB payload is passed on the stack: on Windows (1 MB default stack)
+// link with /STACK:8388608 or drop that size.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../common/benchmark.h"
+
+template <size_t N>
+struct Payload {
+    unsigned char bytes[N];
+};
+
+template <size_t N>
+BENCH_NOINLINE unsigned byValue(Payload<N> p) { return p.bytes[0] + p.bytes[N - 1]; }
+template <size_t N>
+BENCH_NOINLINE unsigned byConstRef(const Payload<N>& p) { return p.bytes[0] + p.bytes[N - 1]; }
+template <size_t N>
+BENCH_NOINLINE unsigned byRvalueRef(Payload<N>&& p) { return p.bytes[0] + p.bytes[N - 1]; }
+template <size_t N>
+BENCH_NOINLINE unsigned byPointer(const Payload<N>* p) { return p->bytes[0] + p->bytes[N - 1]; }
+
+template <size_t N>
+inline unsigned byValueInline(Payload<N> p) { return p.bytes[0] + p.bytes[N - 1]; }
+template <size_t N>
+inline unsigned byConstRefInline(const Payload<N>& p) { return p.bytes[0] + p.bytes[N - 1]; }
+
+struct Row {
+    size_t bytes;
+    double value, constRef, rvalueRef, pointer, valueInline, constRefInline;
+};
+
+// `calls` calls alternating between two sources, so nothing about the
+// argument is loop-invariant. (Mutating a byte of a single source instead
+// would add a store-forwarding stall to every by-value copy.)
+template <typename Fn, typename P>
+double nsPerCall(P* sources, size_t calls, Fn&& fn) {
+    unsigned sink = 0;
+    double ns = bench::bestOfNs([&] {
+        for (size_t i = 0; i < calls; ++i) sink += fn(sources[i & 1]);
+        bench::doNotOptimize(sink);
+    }, 3);
+    return ns / calls;
+}
+
+template <size_t N>
+Row measure(size_t bytesPerSize) {
+    auto sources = std::make_unique<Payload<N>[]>(2);
+    for (int k = 0; k < 2; ++k) {
+        std::fill(std::begin(sources[k].bytes), std::end(sources[k].bytes),
+                  static_cast<unsigned char>(k + 1));
+    }
+    size_t calls = std::max<size_t>(1000, bytesPerSize / N);
+    Payload<N>* p = sources.get();
+
+    Row row{N, 0, 0, 0, 0, 0, 0};
+    row.value = nsPerCall(p, calls, [](Payload<N>& s) { return byValue<N>(s); });
+    row.constRef = nsPerCall(p, calls, [](Payload<N>& s) { return byConstRef<N>(s); });
+    row.rvalueRef = nsPerCall(p, calls, [](Payload<N>& s) { return byRvalueRef<N>(std::move(s)); });
+    row.pointer = nsPerCall(p, calls, [](Payload<N>& s) { return byPointer<N>(&s); });
+    row.valueInline = nsPerCall(p, calls, [](Payload<N>& s) { return byValueInline<N>(s); });
+    row.constRefInline = nsPerCall(p, calls, [](Payload<N>& s) { return byConstRefInline<N>(s); });
+    return row;
+}
+
+void printRow(const Row& r) {
+    char size[32];
+    if (r.bytes >= 1024 * 1024) std::snprintf(size, sizeof(size), "%zu MB", r.bytes >> 20);
+    else if (r.bytes >= 1024) std::snprintf(size, sizeof(size), "%zu KB", r.bytes >> 10);
+    else std::snprintf(size, sizeof(size), "%zu B", r.bytes);
+    std::printf("%8s %10.2f %10.2f %10.2f %10.2f %12.2f %12.2f %12zu\n", size, r.value,
+                r.constRef, r.rvalueRef, r.pointer, r.valueInline, r.constRefInline, r.bytes);
+}
+
+// 01_references/solution.cpp's type
+struct LargeDataSet {
+    int data[1000];
+    std::string description;
+};
+
+BENCH_NOINLINE int dataSetByValue(LargeDataSet d) {
+    return d.data[0] + d.data[999] + static_cast<int>(d.description.size());
+}
+BENCH_NOINLINE int dataSetByConstRef(const LargeDataSet& d) {
+    return d.data[0] + d.data[999] + static_cast<int>(d.description.size());
+}
+
+template <size_t... Ns>
+void measureAll(size_t bytesPerSize, std::index_sequence<Ns...>) {
+    Row rows[] = {measure<(size_t{8} << Ns)>(bytesPerSize)...};
+
+    std::printf("%8s %10s %10s %10s %10s %12s %12s %12s\n", "size", "value", "const&",
+                "&&", "pointer", "value,inl", "const&,inl", "copied B");
+    for (const Row& r : rows) printRow(r);
+
+    // Largest size at which out-of-line by-value stays within 25% of const&
+    size_t threshold = 0;
+    for (const Row& r : rows) {
+        if (r.value > 1.25 * r.constRef + 0.1) break;
+        threshold = r.bytes;
+    }
+    std::printf("\nby value stays within 25%% of const& (out of line) up to %zu bytes on this machine\n",
+                threshold);
+}
+
+int main(int argc, char** argv) {
+    size_t bytesPerSize = std::max<size_t>(1 << 20, bench::argOr(argc, argv, 1, size_t{1} << 28));
+    std::printf("=== Parameter Passing Cost (ns/call; ~%zu MB copied per size by value) ===\n\n",
+                bytesPerSize >> 20);
+
+    // 8 B << 0 .. 17 = 8 B .. 1 MB
+    measureAll(bytesPerSize, std::make_index_sequence<18>{});
+
+    LargeDataSet datasets[2] = {};
+    for (auto& d : datasets) d.description = "Quarterly sensor readings, station 7 (too long for SSO)";
+    size_t calls = 200000;
+    int sink = 0;
+    double valueNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < calls; ++i) sink += dataSetByValue(datasets[i & 1]);
+        bench::doNotOptimize(sink);
+    }, 3) / calls;
+    double refNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < calls; ++i) sink += dataSetByConstRef(datasets[i & 1]);
+        bench::doNotOptimize(sink);
+    }, 3) / calls;
+    const LargeDataSet& dataset = datasets[0];
+    std::printf("\nLargeDataSet (%zu B + %zu B string on the heap):\n", sizeof(LargeDataSet),
+                dataset.description.size());
+    std::printf("  %-20s %10.2f ns/call   %zu bytes copied, 1 allocation\n", "by value", valueNs,
+                sizeof(LargeDataSet) + dataset.description.size());
+    std::printf("  %-20s %10.2f ns/call   0 bytes copied\n", "by const reference", refNs);
+    return 0;
+}
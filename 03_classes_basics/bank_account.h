@@ -0,0 +1,56 @@
+#pragma once
+
+// BankAccount from example.cpp, shared with cart_allocation_benchmark.cpp so
+// the benchmark measures the real class
+
+#include <string>
+#include <utility>
+
+#include "../common/expected.h"
+
+enum class WithdrawError { InvalidAmount, InsufficientFunds };
+
+inline const char* toString(WithdrawError e) {
+    switch (e) {
+        case WithdrawError::InvalidAmount: return "invalid amount";
+        case WithdrawError::InsufficientFunds: return "insufficient funds";
+    }
+    return "unknown error";
+}
+
+class BankAccount {
+private:
+    std::string owner;
+    double balance;
+    
+public:
+    // `name` is taken by value and moved: one copy at most, none for temporaries
+    BankAccount(std::string name, double initial) : owner(std::move(name)), balance(initial) {}
+    
+    // The new balance, or why the withdrawal was refused.
+    // Still reads like the old bool: if (account.withdraw(x)) ...
+    Expected<double, WithdrawError> withdraw(double amount) {
+        if (!(amount > 0)) {
+            return makeUnexpected(WithdrawError::InvalidAmount);
+        }
+        if (amount > balance) {
+            return makeUnexpected(WithdrawError::InsufficientFunds);
+        }
+        balance -= amount;
+        return balance;
+    }
+    
+    void deposit(double amount) {
+        if (amount > 0) {
+            balance += amount;
+        }
+    }
+    
+    double getBalance() const {
+        return balance;
+    }
+    
+    const std::string& getOwner() const {
+        return owner;
+    }
+};
@@ -0,0 +1,181 @@
+// String copies while bulk-loading ShoppingCart, Student and BankAccount,
+// counted with common/alloc_tracker.h.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o cart_allocation_benchmark cart_allocation_benchmark.cpp
+//     ./cart_allocation_benchmark [items]      (default: 10000000)
+//
+// Item names are 29 characters, past the small-string buffer, so every
+// std::string that owns one costs exactly one operator new. A cart of n items
+// therefore needs n name allocations plus its vector storage; anything beyond
+// that is a redundant copy. Every row states the count it expects, and the
+// program exits with status 1 if any count differs.
+//
+// The textbook cart is solution.cpp's original addItem(const std::string&):
+// a temporary name is built, then copied into the cart. The real ShoppingCart,
+// Student and BankAccount come from the headers solution.cpp and example.cpp
+// include, so a regression there shows up here.
+
+#define ALLOC_TRACKER_INSTALL
+#include "../common/alloc_tracker.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "bank_account.h"
+#include "shopping_cart.h"
+#include "student.h"
+
+namespace {
+
+// solution.cpp's ShoppingCart before the sink parameters
+class TextbookCart {
+private:
+    struct Item {
+        std::string name;
+        double price;
+    };
+    std::vector<Item> items;
+
+public:
+    TextbookCart& addItem(const std::string& name, double price) {
+        items.push_back({name, price});
+        return *this;
+    }
+
+    size_t size() const { return items.size(); }
+};
+
+bool allOk = true;
+
+// One row: run fn, compare its operator new count with the expectation
+template <typename Fn>
+void expectAllocations(const char* label, std::uint64_t expected, Fn&& fn) {
+    alloc_tracker::AllocationScope scope;
+    auto t0 = bench::Clock::now();
+    fn();
+    double ms = std::chrono::duration<double, std::milli>(bench::Clock::now() - t0).count();
+    std::uint64_t got = scope.allocations();
+    bool ok = got == expected;
+    allOk = allOk && ok;
+    std::printf("  %-46s %10llu allocs %9.1f ms   expected %-10llu %s\n", label,
+                static_cast<unsigned long long>(got), ms, static_cast<unsigned long long>(expected),
+                ok ? "ok" : "REGRESSION");
+}
+
+// Formats one SKU-like name; written into a caller's buffer so that no
+// std::string is involved until the caller makes one
+size_t formatName(char (&buffer)[48], size_t i) {
+    int n = std::snprintf(buffer, sizeof(buffer), "product-sku-%08zu-standard", i % 100000000);
+    return static_cast<size_t>(n);
+}
+
+std::string makeName(size_t i) {  // Exactly one allocation
+    char buffer[48];
+    return std::string(buffer, formatName(buffer, i));
+}
+
+double priceOf(size_t i) { return 0.99 + static_cast<double>(i % 500) * 0.25; }
+
+// operator new calls std::vector needs to grow to `count` elements one
+// push_back at a time (implementation-defined growth factor)
+std::uint64_t vectorGrowthAllocations(size_t count) {
+    alloc_tracker::AllocationScope scope;
+    std::vector<char> v;
+    for (size_t i = 0; i < count; ++i) v.push_back(0);
+    return scope.allocations();
+}
+
+void cartSection(size_t n) {
+    const std::uint64_t growth = vectorGrowthAllocations(n);
+    std::printf("ShoppingCart, %zu items (names of %zu chars):\n", n, makeName(0).size());
+
+    expectAllocations("textbook addItem(makeName(i)): name + copy", 2 * n + growth, [&] {
+        TextbookCart cart;
+        for (size_t i = 0; i < n; ++i) cart.addItem(makeName(i), priceOf(i));
+        bench::doNotOptimize(cart.size());
+    });
+    expectAllocations("addItem(makeName(i)): moved", n + growth, [&] {
+        ShoppingCart cart;
+        for (size_t i = 0; i < n; ++i) cart.addItem(makeName(i), priceOf(i));
+        bench::doNotOptimize(cart.size());
+    });
+    expectAllocations("same after reserve(n)", n + 1, [&] {
+        ShoppingCart cart;
+        cart.reserve(n);
+        for (size_t i = 0; i < n; ++i) cart.addItem(makeName(i), priceOf(i));
+        bench::doNotOptimize(cart.size());
+    });
+    expectAllocations("reserve(n) + emplaceItem(const char*, price)", n + 1, [&] {
+        ShoppingCart cart;
+        cart.reserve(n);
+        char buffer[48];
+        for (size_t i = 0; i < n; ++i) {
+            formatName(buffer, i);
+            cart.emplaceItem(buffer, priceOf(i));  // The string is built inside the Item
+        }
+        bench::doNotOptimize(cart.size());
+    });
+
+    // A reader reusing one line buffer keeps its name, so the cart must copy it
+    expectAllocations("reserve(n) + addItem(line), line reused", n + 2, [&] {
+        ShoppingCart cart;
+        cart.reserve(n);
+        std::string line;
+        char buffer[48];
+        for (size_t i = 0; i < n; ++i) {
+            line.assign(buffer, formatName(buffer, i));  // Allocates the first time only
+            cart.addItem(line, priceOf(i));              // The one copy the cart needs
+        }
+        bench::doNotOptimize(cart.size());
+    });
+    std::printf("\n");
+}
+
+void ownerSection(size_t grades) {
+    std::printf("Student and BankAccount:\n");
+    expectAllocations("Student(makeName(0)): name moved in", 1, [&] {
+        Student s(makeName(0));
+        bench::doNotOptimize(s.getName().size());
+    });
+    std::string kept = makeName(1);
+    expectAllocations("BankAccount(kept, 0): one copy, caller keeps it", 1, [&] {
+        BankAccount account(kept, 0.0);
+        bench::doNotOptimize(account.getOwner().size());
+    });
+    expectAllocations("BankAccount(std::move(kept), 0)", 0, [&] {
+        BankAccount account(std::move(kept), 0.0);
+        bench::doNotOptimize(account.getOwner().size());
+    });
+    Student student(makeName(2));
+    expectAllocations("reserveGrades(n) + n x addGrade", 1, [&] {
+        student.reserveGrades(grades);
+        for (size_t i = 0; i < grades; ++i) student.addGrade(static_cast<int>(i % 101));
+    });
+
+    // Accessors return const references: reading names must not allocate
+    BankAccount account(makeName(3), 100.0);
+    size_t total = 0;
+    {
+        alloc_tracker::NoAllocationScope hot;
+        for (int i = 0; i < 1000; ++i) total += student.getName().size() + account.getOwner().size();
+    }
+    bench::doNotOptimize(total);
+    std::printf("  %-46s %10d allocs (NoAllocationScope)              ok\n\n", "getName() / getOwner() x 1000", 0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 10000000);
+    if (n == 0) n = 1;
+
+    std::printf("=== Bulk Loading Without Redundant Copies (alloc_tracker %s) ===\n\n",
+                alloc_tracker::installed() ? "installed" : "NOT installed");
+    cartSection(n);
+    ownerSection(n);
+    alloc_tracker::printReport("at exit", stdout);
+    return allOk ? 0 : 1;
+}
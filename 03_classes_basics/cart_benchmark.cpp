@@ -0,0 +1,70 @@
+// Edit-and-retotal cost: textbook ShoppingCart vs IndexedShoppingCart.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o cart_benchmark cart_benchmark.cpp
+//     ./cart_benchmark [lines] [edits]      (defaults: 5000 lines, 20000 edits)
+//
+// Each edit removes one product, adds another, and re-reads the total, which
+// is how a checkout page that re-totals after every change behaves.
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "indexed_cart.h"
+#include "shopping_cart.h"
+
+int main(int argc, char** argv) {
+    size_t lines = std::max<size_t>(1, bench::argOr(argc, argv, 1, 5000));
+    size_t edits = bench::argOr(argc, argv, 2, 20000);
+
+    // Realistic SKU-like names: long enough to defeat the small-string buffer
+    std::vector<std::string> products;
+    for (size_t i = 0; i < lines; ++i) {
+        products.push_back("product-sku-" + std::to_string(100000 + i) + "-standard");
+    }
+    auto priceOf = [](size_t i) { return 0.99 + static_cast<double>(i % 500) * 0.25; };
+
+    // Edit e removes a scattered line and adds it back at the end
+    auto editTarget = [&](size_t e) { return (e * 7919) % lines; };
+
+    double plainTotal = 0.0;
+    double plainNs = bench::bestOfNs([&] {
+        ShoppingCart cart;
+        for (size_t i = 0; i < lines; ++i) cart.addItem(products[i], priceOf(i));
+        for (size_t e = 0; e < edits; ++e) {
+            size_t out = editTarget(e);
+            cart.removeItem(products[out]);
+            cart.addItem(products[out], priceOf(out));
+            plainTotal = cart.getTotal();
+        }
+        bench::doNotOptimize(plainTotal);
+    }, 3);
+
+    double indexedTotal = 0.0;
+    double indexedNs = bench::bestOfNs([&] {
+        NameTable names;
+        IndexedShoppingCart cart(names);
+        cart.reserve(lines);
+        for (size_t i = 0; i < lines; ++i) cart.addItem(products[i], priceOf(i));
+        for (size_t e = 0; e < edits; ++e) {
+            size_t out = editTarget(e);
+            cart.removeItem(products[out]);
+            cart.addItem(products[out], priceOf(out));
+            indexedTotal = cart.getTotal();
+        }
+        bench::doNotOptimize(indexedTotal);
+    }, 3);
+
+    std::printf("=== Shopping Cart (%zu lines, %zu remove+add+total edits) ===\n", lines, edits);
+    std::printf("%-28s %12s %14s\n", "cart", "total ms", "ns per edit");
+    std::printf("%-28s %12.2f %14.1f\n", "ShoppingCart (textbook)", plainNs / 1e6,
+                plainNs / std::max<size_t>(1, edits));
+    std::printf("%-28s %12.2f %14.1f\n", "IndexedShoppingCart", indexedNs / 1e6,
+                indexedNs / std::max<size_t>(1, edits));
+    std::printf("speedup: %.1fx, totals: %.2f vs %.2f\n", plainNs / indexedNs, plainTotal,
+                indexedTotal);
+    return 0;
+}
@@ -1,6 +1,12 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "../common/expected.h"
+#include "bank_account.h"  // Example 4: Encapsulation (Bank Account)
 
 // Example 1: Basic class with public and private members
 class Rectangle {
@@ -54,60 +60,31 @@ public:
     }
 };
 
-// Example 4: Encapsulation (Bank Account)
-class BankAccount {
-private:
-    std::string owner;
-    double balance;
-    
-public:
-    BankAccount(std::string name, double initial) : owner(name), balance(initial) {}
-    
-    bool withdraw(double amount) {
-        if (amount > 0 && amount <= balance) {
-            balance -= amount;
-            return true;
-        }
-        return false;
-    }
-    
-    void deposit(double amount) {
-        if (amount > 0) {
-            balance += amount;
-        }
-    }
-    
-    double getBalance() const {
-        return balance;
-    }
-    
-    std::string getOwner() const {
-        return owner;
-    }
-};
-
 // Example 5: Static members
+// The counter is a 64-bit atomic: objects may be created from several
+// threads, and a plain int++ there is a data race that can also overflow.
+// See id_generator.h for a per-thread block version that scales to many cores.
 class IDGenerator {
 private:
-    static int nextID;  // Shared across all instances
-    int myID;
+    static std::atomic<std::uint64_t> nextID;  // Shared across all instances
+    std::uint64_t myID;
     
 public:
     IDGenerator() {
-        myID = nextID++;
+        myID = nextID.fetch_add(1, std::memory_order_relaxed);
     }
     
-    int getID() const {
+    std::uint64_t getID() const {
         return myID;
     }
     
-    static int getNextID() {
-        return nextID;
+    static std::uint64_t getNextID() {
+        return nextID.load(std::memory_order_relaxed);
     }
 };
 
 // Must define static member outside class
-int IDGenerator::nextID = 1;
+std::atomic<std::uint64_t> IDGenerator::nextID{1};
 
 // Example 6: Const correctness
 class Temperature {
@@ -171,8 +148,8 @@ int main() {
     }
     std::cout << "Final balance: $" << account.getBalance() << std::endl;
     
-    if (!account.withdraw(2000.0)) {
-        std::cout << "Cannot withdraw $2000 (insufficient funds)" << std::endl;
+    if (auto result = account.withdraw(2000.0); !result) {
+        std::cout << "Cannot withdraw $2000 (" << toString(result.error()) << ")" << std::endl;
     }
     std::cout << std::endl;
     
@@ -24,7 +24,7 @@ private:
     // TODO: Add private members: name (string), grades (vector<int>)
     
 public:
-    // TODO: Constructor that takes name
+    // TODO: Constructor that takes name (by value, then std::move it into the member)
     // TODO: Method to add grade (validate 0-100)
     // TODO: Method to get average (const)
     // TODO: Method to get name (const)
@@ -51,7 +51,7 @@ private:
     // TODO: double total
     
 public:
-    // TODO: addItem(name, price) -> return *this for chaining
+    // TODO: addItem(name, price) -> return *this for chaining (name by value, moved in)
     // TODO: removeItem(name) -> return *this
     // TODO: getTotal() const
     // TODO: printItems() const
@@ -0,0 +1,158 @@
+#pragma once
+
+// Incremental statistics for 0-100 grades.
+//
+// Student::getAverage() in the textbook version re-runs std::accumulate over
+// every grade on each call. GradeStats keeps everything up to date as grades
+// arrive, so every query below is O(1):
+//   - count, sum, min, max
+//   - mean and variance via Welford's online algorithm (numerically stable,
+//     unlike the naive sum-of-squares formula)
+//   - optionally a 101-bucket histogram (one bucket per grade) for exact
+//     percentiles and the median
+//
+// addGrades(Span) is the bulk path: it validates and reduces blocks of grades
+// with plain integer loops the compiler auto-vectorizes, then merges each
+// block's exact count/sum/sum-of-squares into the running Welford state.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "../common/span.h"
+
+enum class Histogram { Off, On };
+
+class GradeStats {
+public:
+    static constexpr int kMinGrade = 0;
+    static constexpr int kMaxGrade = 100;
+
+    explicit GradeStats(Histogram histogram = Histogram::On)
+        : withHistogram(histogram == Histogram::On) {}
+
+    static constexpr bool isValid(int grade) { return grade >= kMinGrade && grade <= kMaxGrade; }
+
+    // Returns false (and records nothing) for grades outside 0-100
+    bool add(int grade) {
+        if (!isValid(grade)) return false;
+        ++n;
+        total += grade;
+        lowest = std::min(lowest, grade);
+        highest = std::max(highest, grade);
+
+        double delta = grade - runningMean;
+        runningMean += delta / static_cast<double>(n);
+        m2 += delta * (grade - runningMean);
+
+        if (withHistogram) ++buckets[grade];
+        return true;
+    }
+
+    // Bulk load; returns how many grades were valid and recorded
+    size_t addGrades(Span<const int> grades) {
+        size_t accepted = 0;
+        for (size_t offset = 0; offset < grades.size(); offset += kBlock) {
+            Span<const int> block = grades.subspan(offset, std::min(kBlock, grades.size() - offset));
+            if (allValid(block)) {
+                addValidBlock(block);
+                accepted += block.size();
+            } else {
+                for (int g : block) accepted += add(g);  // Rare: fall back to per-grade checks
+            }
+        }
+        return accepted;
+    }
+
+    size_t count() const { return n; }
+    bool empty() const { return n == 0; }
+    std::int64_t sum() const { return total; }
+    double mean() const { return n ? runningMean : 0.0; }
+    int min() const { return n ? lowest : 0; }
+    int max() const { return n ? highest : 0; }
+
+    // Population variance (divide by n); sampleVariance divides by n - 1
+    double variance() const { return n ? m2 / static_cast<double>(n) : 0.0; }
+    double sampleVariance() const { return n > 1 ? m2 / static_cast<double>(n - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+
+    bool hasHistogram() const { return withHistogram; }
+    size_t countOf(int grade) const { return withHistogram && isValid(grade) ? buckets[grade] : 0; }
+
+    // Smallest grade g such that at least p% of grades are <= g (nearest rank).
+    // Walks the fixed 101 buckets, independent of how many grades were added.
+    // Returns -1 when empty or when the histogram is off.
+    int percentile(double p) const {
+        if (!withHistogram || n == 0) return -1;
+        p = std::clamp(p, 0.0, 100.0);
+        auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(n)));
+        rank = std::max<size_t>(rank, 1);
+        size_t seen = 0;
+        for (int g = kMinGrade; g <= kMaxGrade; ++g) {
+            seen += buckets[g];
+            if (seen >= rank) return g;
+        }
+        return kMaxGrade;
+    }
+
+    int median() const { return percentile(50.0); }
+
+    void clear() { *this = GradeStats(withHistogram ? Histogram::On : Histogram::Off); }
+
+private:
+    // Keeps a block's sums exact in 32 bits (65536 * 100^2 < 2^32) and the
+    // block's n * sumSq - sum^2 exact in 64 bits
+    static constexpr size_t kBlock = 65536;
+
+    bool withHistogram;
+    size_t n = 0;
+    std::int64_t total = 0;
+    int lowest = std::numeric_limits<int>::max();
+    int highest = std::numeric_limits<int>::min();
+    double runningMean = 0.0;
+    double m2 = 0.0;  // Sum of squared deviations from the mean
+    std::array<std::uint32_t, kMaxGrade + 1> buckets{};
+
+    // Branch-free so it vectorizes: flags any out-of-range grade
+    static bool allValid(Span<const int> block) {
+        int bad = 0;
+        for (int g : block) bad |= (g < kMinGrade) | (g > kMaxGrade);
+        return bad == 0;
+    }
+
+    void addValidBlock(Span<const int> block) {
+        std::uint32_t blockSum = 0;  // 32-bit lanes: twice as many per vector
+        std::uint32_t blockSumSq = 0;
+        int blockMin = kMaxGrade;
+        int blockMax = kMinGrade;
+        for (int g : block) {  // Vectorizes: independent integer reductions
+            blockSum += static_cast<std::uint32_t>(g);
+            blockSumSq += static_cast<std::uint32_t>(g * g);
+            blockMin = std::min(blockMin, g);
+            blockMax = std::max(blockMax, g);
+        }
+        if (withHistogram) {
+            for (int g : block) ++buckets[g];
+        }
+
+        // Chan et al. parallel merge of (n, mean, M2) with the block's exact moments
+        auto nb = static_cast<std::int64_t>(block.size());
+        auto sum64 = static_cast<std::int64_t>(blockSum);
+        auto sumSq64 = static_cast<std::int64_t>(blockSumSq);
+        double blockMean = static_cast<double>(sum64) / nb;
+        double blockM2 = static_cast<double>(nb * sumSq64 - sum64 * sum64) / nb;
+
+        double na = static_cast<double>(n);
+        double combined = na + nb;
+        double delta = blockMean - runningMean;
+        runningMean += delta * nb / combined;
+        m2 += blockM2 + delta * delta * na * nb / combined;
+
+        n += block.size();
+        total += sum64;
+        lowest = std::min(lowest, blockMin);
+        highest = std::max(highest, blockMax);
+    }
+};
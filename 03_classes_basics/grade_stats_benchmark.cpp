@@ -0,0 +1,79 @@
+// Grade statistics: recompute-on-query vs incremental GradeStats.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o grade_stats_benchmark grade_stats_benchmark.cpp
+//     ./grade_stats_benchmark [grades]      (default: 20000000)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "grade_stats.h"
+
+int main(int argc, char** argv) {
+    size_t n = std::max<size_t>(1, bench::argOr(argc, argv, 1, 20000000));
+
+    std::mt19937 rng(7);
+    std::normal_distribution<double> dist(75.0, 12.0);
+    std::vector<int> grades(n);
+    for (int& g : grades) g = std::clamp(static_cast<int>(std::lround(dist(rng))), 0, 100);
+
+    std::printf("=== Grade Statistics (%zu grades) ===\n\n", n);
+
+    // 1. Average queried after every addGrade, as a live dashboard would
+    size_t live = std::min<size_t>(n, 20000);
+    double scanNs = bench::bestOfNs([&] {
+        std::vector<int> stored;
+        double avg = 0.0;
+        for (size_t i = 0; i < live; ++i) {
+            stored.push_back(grades[i]);
+            avg = std::accumulate(stored.begin(), stored.end(), 0.0) / stored.size();
+        }
+        bench::doNotOptimize(avg);
+    }, 3);
+    double incrementalNs = bench::bestOfNs([&] {
+        GradeStats stats;
+        double avg = 0.0;
+        for (size_t i = 0; i < live; ++i) {
+            stats.add(grades[i]);
+            avg = stats.mean();
+        }
+        bench::doNotOptimize(avg);
+    }, 3);
+    std::printf("add + getAverage, %zu times:\n", live);
+    std::printf("  %-32s %10.2f ms\n", "accumulate on every query", scanNs / 1e6);
+    std::printf("  %-32s %10.2f ms   (%.0fx)\n\n", "GradeStats (Welford)", incrementalNs / 1e6,
+                scanNs / incrementalNs);
+
+    // 2. Loading a whole dataset at once
+    GradeStats single, bulk, bulkNoHist(Histogram::Off);
+    double singleNs = bench::bestOfNs([&] {
+        single = GradeStats();
+        for (int g : grades) single.add(g);
+        bench::doNotOptimize(single);
+    }, 3);
+    double bulkNs = bench::bestOfNs([&] {
+        bulk = GradeStats();
+        bulk.addGrades(grades);
+        bench::doNotOptimize(bulk);
+    }, 3);
+    double bulkNoHistNs = bench::bestOfNs([&] {
+        bulkNoHist = GradeStats(Histogram::Off);
+        bulkNoHist.addGrades(grades);
+        bench::doNotOptimize(bulkNoHist);
+    }, 3);
+
+    auto rate = [n](double ns) { return n / ns * 1e3; };  // Million grades per second
+    std::printf("load %zu grades:\n", n);
+    std::printf("  %-32s %10.1f M grades/s\n", "add() per grade", rate(singleNs));
+    std::printf("  %-32s %10.1f M grades/s\n", "addGrades(span)", rate(bulkNs));
+    std::printf("  %-32s %10.1f M grades/s\n\n", "addGrades(span), no histogram",
+                rate(bulkNoHistNs));
+
+    std::printf("mean %.4f / %.4f, stddev %.4f / %.4f, median %d, p90 %d\n", single.mean(),
+                bulk.mean(), single.stddev(), bulk.stddev(), bulk.median(), bulk.percentile(90));
+    return 0;
+}
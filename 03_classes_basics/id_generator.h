@@ -0,0 +1,71 @@
+#pragma once
+
+// Thread-safe ID sources for objects created from many threads.
+//
+//   AtomicIdSource        - one shared 64-bit atomic counter. IDs are dense and
+//                           globally increasing, but every call touches the
+//                           same cache line, so it stops scaling past a few cores.
+//   BlockIdSource<Block>  - each thread reserves a range of `Block` IDs with a
+//                           single fetch_add and hands them out from a
+//                           thread_local cursor. The shared line is touched
+//                           once per Block IDs, so it scales with core count.
+//                           IDs stay unique, but they are only increasing per
+//                           thread, and a thread's unused range is skipped on exit.
+//
+// A 64-bit counter allocating a billion IDs per second lasts ~584 years.
+
+#include <atomic>
+#include <cstdint>
+
+// Own cache line: unrelated globals must not false-share with a hot counter
+struct alignas(64) PaddedIdCounter {
+    std::atomic<std::uint64_t> value{1};
+};
+
+class AtomicIdSource {
+public:
+    static std::uint64_t next() noexcept {
+        return counter.value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Next ID to be handed out (a snapshot; other threads may race past it)
+    static std::uint64_t peek() noexcept {
+        return counter.value.load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline PaddedIdCounter counter;
+};
+
+template <std::uint64_t Block = 4096>
+class BlockIdSource {
+    static_assert(Block > 0, "block size must be positive");
+
+public:
+    static std::uint64_t next() noexcept {
+        Range& range = local();
+        if (range.next == range.end) {
+            range.next = counter.value.fetch_add(Block, std::memory_order_relaxed);
+            range.end = range.next + Block;
+        }
+        return range.next++;
+    }
+
+    // Upper bound of every ID handed out so far, across all threads
+    static std::uint64_t reservedUpTo() noexcept {
+        return counter.value.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Range {
+        std::uint64_t next = 0;
+        std::uint64_t end = 0;
+    };
+
+    static inline PaddedIdCounter counter;
+
+    static Range& local() noexcept {
+        thread_local Range range;
+        return range;
+    }
+};
@@ -0,0 +1,93 @@
+// Scaling of ID generation across threads: mutex vs shared atomic vs per-thread blocks.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o id_generator_benchmark id_generator_benchmark.cpp
+//     ./id_generator_benchmark [ids_per_thread] [max_threads]
+//         defaults: 10000000 IDs per thread, threads up to hardware_concurrency
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "id_generator.h"
+
+// Baseline: the obvious way to make `nextID++` safe
+class MutexIdSource {
+public:
+    static std::uint64_t next() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return counter++;
+    }
+
+private:
+    static inline std::mutex mutex;
+    static inline std::uint64_t counter = 1;
+};
+
+// Run `threads` workers that each draw `perThread` IDs; returns total IDs/sec
+template <typename Source>
+double idsPerSecond(unsigned threads, size_t perThread) {
+    double ns = bench::bestOfNs([&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([perThread] {
+                std::uint64_t sink = 0;
+                for (size_t i = 0; i < perThread; ++i) {
+                    sink ^= Source::next();
+                }
+                bench::doNotOptimize(sink);
+            });
+        }
+        for (auto& w : workers) w.join();
+    }, 3);
+    return threads * perThread / ns * 1e9;
+}
+
+// Every ID handed out by concurrent threads must be unique
+template <typename Source>
+bool idsAreUnique(unsigned threads, size_t perThread) {
+    std::vector<std::vector<std::uint64_t>> seen(threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            seen[t].reserve(perThread);
+            for (size_t i = 0; i < perThread; ++i) seen[t].push_back(Source::next());
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<std::uint64_t> all;
+    for (auto& ids : seen) all.insert(all.end(), ids.begin(), ids.end());
+    std::sort(all.begin(), all.end());
+    return std::adjacent_find(all.begin(), all.end()) == all.end();
+}
+
+int main(int argc, char** argv) {
+    size_t perThread = bench::argOr(argc, argv, 1, 10000000);
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned maxThreads = std::max(1u, static_cast<unsigned>(bench::argOr(argc, argv, 2, hw)));
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    std::printf("=== ID Generator Scaling (%zu IDs/thread, %u hardware threads) ===\n",
+                perThread, hw);
+    std::printf("uniqueness check, 4 threads: atomic %s, block %s\n\n",
+                idsAreUnique<AtomicIdSource>(4, 200000) ? "ok" : "FAILED",
+                idsAreUnique<BlockIdSource<4096>>(4, 200000) ? "ok" : "FAILED");
+
+    std::printf("%8s %16s %16s %16s %16s\n", "threads", "mutex M/s", "atomic M/s",
+                "block(64) M/s", "block(4096) M/s");
+    for (unsigned threads : threadCounts) {
+        double mutexRate = idsPerSecond<MutexIdSource>(threads, perThread / 10);
+        double atomicRate = idsPerSecond<AtomicIdSource>(threads, perThread);
+        double smallBlockRate = idsPerSecond<BlockIdSource<64>>(threads, perThread);
+        double blockRate = idsPerSecond<BlockIdSource<4096>>(threads, perThread);
+        std::printf("%8u %16.1f %16.1f %16.1f %16.1f\n", threads, mutexRate / 1e6,
+                    atomicRate / 1e6, smallBlockRate / 1e6, blockRate / 1e6);
+    }
+    return 0;
+}
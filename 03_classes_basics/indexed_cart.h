@@ -0,0 +1,155 @@
+#pragma once
+
+// Indexed shopping cart for carts with thousands of lines.
+//
+// The ShoppingCart in solution.cpp is the textbook version: removeItem() is a
+// linear remove_if over every line comparing strings, and getTotal() walks all
+// lines on every call. IndexedShoppingCart keeps the same chaining interface
+// but:
+//   - interns item names in a NameTable, so a line is a 4-byte name id plus
+//     numbers instead of a heap-allocated std::string
+//   - keeps a name id -> slot hash index, so lookup is O(1)
+//   - removes by swap-and-pop: the last line moves into the freed slot, O(1)
+//     (line order is therefore not preserved)
+//   - keeps a running total, so getTotal() is O(1)
+//
+// Adding a name that is already in the cart stacks it onto the existing line
+// (quantity + subtotal), and removeItem() removes that whole line - the same
+// "remove every item with this name" result as the textbook cart.
+//
+// The running total is kept in integer cents: adding and subtracting doubles
+// thousands of times would slowly drift (0.1 + 0.2 - 0.2 != 0.1).
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Each distinct string is stored once; callers hold small integer ids.
+// Not thread-safe: share one table per thread (or guard it) if needed.
+class NameTable {
+public:
+    using Id = std::uint32_t;
+    static constexpr Id kNotFound = UINT32_MAX;
+
+    Id intern(std::string_view name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        Id id = static_cast<Id>(strings.size());
+        strings.emplace_back(name);
+        ids.emplace(strings.back(), id);  // Key views the stable deque element
+        return id;
+    }
+
+    // Lookup without inserting
+    Id find(std::string_view name) const {
+        auto it = ids.find(name);
+        return it == ids.end() ? kNotFound : it->second;
+    }
+
+    const std::string& name(Id id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+
+    // Process-wide table used by carts that are not given their own
+    static NameTable& global() {
+        static NameTable table;
+        return table;
+    }
+
+private:
+    std::deque<std::string> strings;  // deque: growth never moves elements
+    std::unordered_map<std::string_view, Id> ids;
+};
+
+class IndexedShoppingCart {
+public:
+    struct Line {
+        NameTable::Id name;
+        std::uint32_t quantity;
+        std::int64_t subtotalCents;
+    };
+
+    explicit IndexedShoppingCart(NameTable& nameTable = NameTable::global())
+        : names(&nameTable) {}
+
+    IndexedShoppingCart& addItem(std::string_view name, double price) {
+        std::int64_t cents = toCents(price);
+        NameTable::Id id = names->intern(name);
+        auto [it, inserted] = slots.try_emplace(id, static_cast<std::uint32_t>(lines.size()));
+        if (inserted) {
+            lines.push_back({id, 1, cents});
+        } else {
+            Line& line = lines[it->second];
+            ++line.quantity;
+            line.subtotalCents += cents;
+        }
+        totalCents += cents;
+        return *this;
+    }
+
+    IndexedShoppingCart& removeItem(std::string_view name) {
+        NameTable::Id id = names->find(name);
+        if (id == NameTable::kNotFound) return *this;
+        auto it = slots.find(id);
+        if (it == slots.end()) return *this;
+
+        std::uint32_t slot = it->second;
+        totalCents -= lines[slot].subtotalCents;
+        slots.erase(it);
+
+        // Swap-and-pop: move the last line into the hole and re-point its index
+        if (slot != lines.size() - 1) {
+            lines[slot] = lines.back();
+            slots[lines[slot].name] = slot;
+        }
+        lines.pop_back();
+        return *this;
+    }
+
+    bool contains(std::string_view name) const {
+        NameTable::Id id = names->find(name);
+        return id != NameTable::kNotFound && slots.count(id) != 0;
+    }
+
+    double getTotal() const { return totalCents / 100.0; }
+    std::int64_t getTotalCents() const { return totalCents; }
+
+    size_t lineCount() const { return lines.size(); }
+    bool empty() const { return lines.empty(); }
+
+    void reserve(size_t n) {
+        lines.reserve(n);
+        slots.reserve(n);
+    }
+
+    void clear() {
+        lines.clear();
+        slots.clear();
+        totalCents = 0;
+    }
+
+    const std::vector<Line>& getLines() const { return lines; }
+    const std::string& nameOf(const Line& line) const { return names->name(line.name); }
+
+    void printItems() const {
+        std::cout << "Shopping Cart:" << std::endl;
+        for (const auto& line : lines) {
+            std::cout << "  - " << nameOf(line);
+            if (line.quantity > 1) std::cout << " x" << line.quantity;
+            std::cout << ": $" << line.subtotalCents / 100.0 << std::endl;
+        }
+        std::cout << "Total: $" << getTotal() << std::endl;
+    }
+
+private:
+    NameTable* names;
+    std::vector<Line> lines;
+    std::unordered_map<NameTable::Id, std::uint32_t> slots;  // Name id -> index in lines
+    std::int64_t totalCents = 0;
+
+    static std::int64_t toCents(double price) { return std::llround(price * 100.0); }
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+// Concurrent account ledger: the multi-threaded, many-account big brother of
+// the BankAccount class in example.cpp.
+//
+//   - Money is integer cents (std::int64_t), never double: 0.1 + 0.2 != 0.3.
+//   - All balances live in one contiguous table indexed by account id.
+//   - Each ledger runs in one of two modes, fixed at construction:
+//       LockFree - single-account operations are CAS loops on the balance; a
+//                  transfer CAS-withdraws from the source, then fetch_adds
+//                  into the target. Never overdraws and always conserves
+//                  money, but a concurrent observer may briefly see it
+//                  "in flight".
+//       Locked   - every operation takes the stripe locks of the accounts it
+//                  touches, in a fixed (ascending) order, and updates balances
+//                  with plain read-modify-writes inside them. A transfer is
+//                  atomic to every reader, total() is an exact snapshot even
+//                  while transfers run, and batches can never deadlock.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "../common/span.h"
+
+using Cents = std::int64_t;
+using AccountId = std::uint32_t;
+
+struct Transfer {
+    AccountId from;
+    AccountId to;
+    Cents amount;
+};
+
+struct BatchResult {
+    size_t applied = 0;
+    size_t rejected = 0;  // Insufficient funds, bad amount, or from == to
+};
+
+enum class TransferMode { LockFree, Locked };
+
+class Ledger {
+public:
+    static constexpr size_t kStripes = 4096;  // Power of two
+
+    explicit Ledger(size_t accountCount, Cents initialBalance = 0,
+                    TransferMode transferMode = TransferMode::LockFree)
+        : accounts(new Account[accountCount]), count(accountCount), mode(transferMode) {
+        for (size_t i = 0; i < count; ++i) {
+            accounts[i].balance.store(initialBalance, std::memory_order_relaxed);
+        }
+    }
+
+    Ledger(const Ledger&) = delete;
+    Ledger& operator=(const Ledger&) = delete;
+
+    size_t size() const { return count; }
+    TransferMode transferMode() const { return mode; }
+
+    Cents balance(AccountId id) const {
+        const Account& account = at(id);
+        if (mode == TransferMode::LockFree) return account.balance.load(std::memory_order_acquire);
+        StripeGuard guard(*this, id, id);
+        return account.balance.load(std::memory_order_relaxed);
+    }
+
+    bool deposit(AccountId id, Cents amount) {
+        if (amount <= 0) return false;
+        Account& account = at(id);
+        if (mode == TransferMode::LockFree) {
+            account.balance.fetch_add(amount, std::memory_order_acq_rel);
+        } else {
+            StripeGuard guard(*this, id, id);
+            add(account, amount);
+        }
+        return true;
+    }
+
+    // Fails (and changes nothing) if the balance would go negative
+    bool withdraw(AccountId id, Cents amount) {
+        if (amount <= 0) return false;
+        Account& account = at(id);
+        if (mode == TransferMode::Locked) {
+            StripeGuard guard(*this, id, id);
+            return take(account, amount);
+        }
+        std::atomic<Cents>& balance = account.balance;
+        Cents current = balance.load(std::memory_order_relaxed);
+        while (current >= amount) {
+            if (balance.compare_exchange_weak(current, current - amount,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool transfer(const Transfer& t) {
+        if (t.from == t.to || t.amount <= 0) return false;
+        at(t.from);
+        at(t.to);  // Validate both ids before touching either balance
+        return mode == TransferMode::LockFree ? transferLockFree(t) : transferLocked(t);
+    }
+
+    // Apply a batch in order. Safe to call from many threads at once.
+    BatchResult applyTransfers(Span<const Transfer> batch) {
+        BatchResult result;
+        for (const Transfer& t : batch) {
+            if (transfer(t)) {
+                ++result.applied;
+            } else {
+                ++result.rejected;
+            }
+        }
+        return result;
+    }
+
+    // Sum of all balances. Locked: an exact snapshot (holds every stripe).
+    // LockFree: only exact while no transfers are running.
+    Cents total() const {
+        if (mode == TransferMode::Locked) {
+            for (size_t i = 0; i < kStripes; ++i) stripes[i].lock();
+        }
+        Cents sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += accounts[i].balance.load(std::memory_order_relaxed);
+        }
+        if (mode == TransferMode::Locked) {
+            for (size_t i = kStripes; i-- > 0;) stripes[i].unlock();
+        }
+        return sum;
+    }
+
+private:
+    // One balance per cache line so neighbouring accounts don't false-share
+    struct alignas(64) Account {
+        std::atomic<Cents> balance{0};
+    };
+
+    // Test-and-test-and-set spinlock: critical sections are a few instructions
+    struct alignas(64) SpinLock {
+        std::atomic<bool> locked{false};
+
+        void lock() noexcept {
+            for (;;) {
+                if (!locked.exchange(true, std::memory_order_acquire)) return;
+                while (locked.load(std::memory_order_relaxed)) std::this_thread::yield();
+            }
+        }
+
+        void unlock() noexcept { locked.store(false, std::memory_order_release); }
+    };
+
+    std::unique_ptr<Account[]> accounts;
+    size_t count;
+    TransferMode mode;
+    std::unique_ptr<SpinLock[]> stripes{new SpinLock[kStripes]};
+
+    // Holds the stripes of two accounts (or one), always locked low to high
+    class StripeGuard {
+    public:
+        StripeGuard(const Ledger& ledger, AccountId a, AccountId b) : locks(ledger.stripes.get()) {
+            size_t sa = a & (kStripes - 1);
+            size_t sb = b & (kStripes - 1);
+            first = sa < sb ? sa : sb;
+            second = sa < sb ? sb : sa;
+            locks[first].lock();
+            if (second != first) locks[second].lock();
+        }
+
+        ~StripeGuard() {
+            if (second != first) locks[second].unlock();
+            locks[first].unlock();
+        }
+
+        StripeGuard(const StripeGuard&) = delete;
+        StripeGuard& operator=(const StripeGuard&) = delete;
+
+    private:
+        SpinLock* locks;
+        size_t first;
+        size_t second;
+    };
+
+    Account& at(AccountId id) const {
+        if (id >= count) throw std::out_of_range("Ledger: unknown account id");
+        return accounts[id];
+    }
+
+    // Locked mode only: the caller holds the account's stripe, so relaxed
+    // loads and stores are a plain read-modify-write
+    static void add(Account& account, Cents amount) {
+        Cents current = account.balance.load(std::memory_order_relaxed);
+        account.balance.store(current + amount, std::memory_order_relaxed);
+    }
+
+    static bool take(Account& account, Cents amount) {
+        Cents current = account.balance.load(std::memory_order_relaxed);
+        if (current < amount) return false;
+        account.balance.store(current - amount, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool transferLockFree(const Transfer& t) {
+        if (!withdraw(t.from, t.amount)) return false;
+        accounts[t.to].balance.fetch_add(t.amount, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool transferLocked(const Transfer& t) {
+        StripeGuard guard(*this, t.from, t.to);
+        if (!take(accounts[t.from], t.amount)) return false;
+        add(accounts[t.to], t.amount);
+        return true;
+    }
+};
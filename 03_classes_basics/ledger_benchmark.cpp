@@ -0,0 +1,165 @@
+// Transfer throughput of the concurrent Ledger across threads.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o ledger_benchmark ledger_benchmark.cpp
+//     ./ledger_benchmark [transfers_per_thread] [accounts] [max_threads]
+//         defaults: 2000000 transfers per thread, 100000 accounts,
+//                   threads up to hardware_concurrency
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "ledger.h"
+
+constexpr Cents kInitialBalance = 100000;  // $1000.00 per account
+
+// Baseline: one mutex around a plain table, the "just lock it" fix for BankAccount
+class GlobalMutexLedger {
+public:
+    GlobalMutexLedger(size_t accounts, Cents initial) : balances(accounts, initial) {}
+
+    BatchResult applyTransfers(Span<const Transfer> batch) {
+        BatchResult result;
+        for (const Transfer& t : batch) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (t.from != t.to && t.amount > 0 && balances[t.from] >= t.amount) {
+                balances[t.from] -= t.amount;
+                balances[t.to] += t.amount;
+                ++result.applied;
+            } else {
+                ++result.rejected;
+            }
+        }
+        return result;
+    }
+
+    Cents total() const {
+        Cents sum = 0;
+        for (Cents b : balances) sum += b;
+        return sum;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<Cents> balances;
+};
+
+// Ledger in Locked mode, constructible like the other ledger types
+struct LockedLedger : Ledger {
+    LockedLedger(size_t accounts, Cents initial) : Ledger(accounts, initial, TransferMode::Locked) {}
+};
+
+std::vector<Transfer> randomTransfers(size_t count, size_t accounts, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<AccountId> account(0, static_cast<AccountId>(accounts - 1));
+    std::uniform_int_distribution<Cents> amount(1, 50000);
+    std::vector<Transfer> transfers(count);
+    for (Transfer& t : transfers) t = {account(rng), account(rng), amount(rng)};
+    return transfers;
+}
+
+struct RunResult {
+    double transfersPerSecond;
+    bool conserved;
+    size_t rejected;
+};
+
+// Each thread applies its own pre-generated batch, in chunks of 1024
+template <typename LedgerType, typename Apply>
+RunResult run(const std::vector<std::vector<Transfer>>& batches, size_t accounts, Apply apply) {
+    RunResult result{0.0, true, 0};
+    size_t total = 0;
+    for (const auto& b : batches) total += b.size();
+
+    double ns = bench::bestOfNs([&] {
+        LedgerType ledger(accounts, kInitialBalance);
+        std::vector<size_t> rejected(batches.size());
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < batches.size(); ++t) {
+            workers.emplace_back([&, t] {
+                Span<const Transfer> all(batches[t]);
+                for (size_t i = 0; i < all.size(); i += 1024) {
+                    size_t n = std::min<size_t>(1024, all.size() - i);
+                    rejected[t] += apply(ledger, all.subspan(i, n)).rejected;
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        result.conserved = result.conserved &&
+                           ledger.total() == static_cast<Cents>(accounts) * kInitialBalance;
+        result.rejected = 0;
+        for (size_t r : rejected) result.rejected += r;
+    }, 3);
+
+    result.transfersPerSecond = total / ns * 1e9;
+    return result;
+}
+
+// Locked mode promises that total() never sees a transfer half done: sample
+// it from one thread while two others move money around
+bool lockedSnapshotsExact(size_t accounts) {
+    LockedLedger ledger(accounts, kInitialBalance);
+    const Cents expected = static_cast<Cents>(accounts) * kInitialBalance;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> writers;
+    for (unsigned t = 0; t < 2; ++t) {
+        writers.emplace_back([&, t] {
+            std::vector<Transfer> batch = randomTransfers(200000, accounts, 7 + t);
+            ledger.applyTransfers(batch);
+        });
+    }
+    bool exact = true;
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) exact = exact && ledger.total() == expected;
+    });
+    for (auto& w : writers) w.join();
+    done.store(true, std::memory_order_release);
+    reader.join();
+    return exact && ledger.total() == expected;
+}
+
+int main(int argc, char** argv) {
+    size_t perThread = bench::argOr(argc, argv, 1, 2000000);
+    size_t accounts = std::max<size_t>(2, bench::argOr(argc, argv, 2, 100000));
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned maxThreads = std::max(1u, static_cast<unsigned>(bench::argOr(argc, argv, 3, hw)));
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    std::printf("=== Ledger Transfer Throughput (%zu transfers/thread, %zu accounts, "
+                "%u hardware threads) ===\n\n", perThread, accounts, hw);
+    bool snapshotsOk = lockedSnapshotsExact(accounts);
+    std::printf("Locked mode, total() during transfers: %s\n\n", snapshotsOk ? "always exact" : "FAILED");
+    std::printf("%8s %16s %16s %16s %12s\n", "threads", "mutex M/s", "striped M/s",
+                "lock-free M/s", "conserved");
+
+    bool allConserved = true;
+    for (unsigned threads : threadCounts) {
+        std::vector<std::vector<Transfer>> batches;
+        for (unsigned t = 0; t < threads; ++t) {
+            batches.push_back(randomTransfers(perThread, accounts, 42 + t));
+        }
+
+        RunResult mutexRun = run<GlobalMutexLedger>(batches, accounts,
+            [](GlobalMutexLedger& l, Span<const Transfer> b) { return l.applyTransfers(b); });
+        RunResult stripedRun = run<LockedLedger>(batches, accounts,
+            [](LockedLedger& l, Span<const Transfer> b) { return l.applyTransfers(b); });
+        RunResult lockFreeRun = run<Ledger>(batches, accounts,
+            [](Ledger& l, Span<const Transfer> b) { return l.applyTransfers(b); });
+
+        allConserved = allConserved && mutexRun.conserved && stripedRun.conserved && lockFreeRun.conserved;
+        bool conserved = mutexRun.conserved && stripedRun.conserved && lockFreeRun.conserved;
+        std::printf("%8u %16.1f %16.1f %16.1f %12s\n", threads,
+                    mutexRun.transfersPerSecond / 1e6, stripedRun.transfersPerSecond / 1e6,
+                    lockFreeRun.transfersPerSecond / 1e6, conserved ? "yes" : "NO");
+    }
+    return snapshotsOk && allConserved ? 0 : 1;
+}
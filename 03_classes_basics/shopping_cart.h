@@ -0,0 +1,72 @@
+#pragma once
+
+// Item and ShoppingCart from solution.cpp, shared with cart_benchmark.cpp and
+// cart_allocation_benchmark.cpp so the benchmarks measure the real classes
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Item {
+    std::string name;
+    double price;
+
+    Item(std::string itemName, double itemPrice) : name(std::move(itemName)), price(itemPrice) {}
+};
+
+class ShoppingCart {
+private:
+    std::vector<Item> items;
+    
+public:
+    // Sink parameter: pass std::move(name) or a temporary and no copy is made
+    ShoppingCart& addItem(std::string name, double price) {
+        items.emplace_back(std::move(name), price);
+        return *this;
+    }
+
+    // Builds the Item in place from Item's constructor arguments, so
+    // emplaceItem("Apple", 1.50) creates the name string once, in the cart
+    template <typename... Args>
+    ShoppingCart& emplaceItem(Args&&... args) {
+        items.emplace_back(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    // One allocation up front instead of regrowing while bulk loading
+    ShoppingCart& reserve(size_t n) {
+        items.reserve(n);
+        return *this;
+    }
+
+    size_t size() const {
+        return items.size();
+    }
+    
+    ShoppingCart& removeItem(const std::string& name) {
+        items.erase(
+            std::remove_if(items.begin(), items.end(),
+                [&name](const Item& item) { return item.name == name; }),
+            items.end()
+        );
+        return *this;
+    }
+    
+    double getTotal() const {
+        double total = 0.0;
+        for (const auto& item : items) {
+            total += item.price;
+        }
+        return total;
+    }
+    
+    void printItems() const {
+        std::cout << "Shopping Cart:" << std::endl;
+        for (const auto& item : items) {
+            std::cout << "  - " << item.name << ": $" << item.price << std::endl;
+        }
+        std::cout << "Total: $" << getTotal() << std::endl;
+    }
+};
@@ -4,6 +4,12 @@
 #include <numeric>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+
+#include "grade_stats.h"
+#include "indexed_cart.h"
+#include "shopping_cart.h"  // SOLUTION 4: Shopping cart with chaining
+#include "student.h"        // SOLUTION 2: Student class
 
 const double PI = 3.14159265359;
 
@@ -30,37 +36,6 @@ public:
     }
 };
 
-// SOLUTION 2: Student class
-class Student {
-private:
-    std::string name;
-    std::vector<int> grades;
-    
-public:
-    Student(const std::string& studentName) : name(studentName) {}
-    
-    void addGrade(int grade) {
-        if (grade >= 0 && grade <= 100) {
-            grades.push_back(grade);
-        } else {
-            std::cout << "Invalid grade: " << grade << " (must be 0-100)" << std::endl;
-        }
-    }
-    
-    double getAverage() const {
-        if (grades.empty()) return 0.0;
-        return std::accumulate(grades.begin(), grades.end(), 0.0) / grades.size();
-    }
-    
-    std::string getName() const {
-        return name;
-    }
-    
-    size_t getGradeCount() const {
-        return grades.size();
-    }
-};
-
 // SOLUTION 3: Counter with static member
 class GlobalCounter {
 private:
@@ -83,48 +58,6 @@ public:
 
 int GlobalCounter::totalCount = 0;
 
-// SOLUTION 4: Shopping cart with chaining
-struct Item {
-    std::string name;
-    double price;
-};
-
-class ShoppingCart {
-private:
-    std::vector<Item> items;
-    
-public:
-    ShoppingCart& addItem(const std::string& name, double price) {
-        items.push_back({name, price});
-        return *this;
-    }
-    
-    ShoppingCart& removeItem(const std::string& name) {
-        items.erase(
-            std::remove_if(items.begin(), items.end(),
-                [&name](const Item& item) { return item.name == name; }),
-            items.end()
-        );
-        return *this;
-    }
-    
-    double getTotal() const {
-        double total = 0.0;
-        for (const auto& item : items) {
-            total += item.price;
-        }
-        return total;
-    }
-    
-    void printItems() const {
-        std::cout << "Shopping Cart:" << std::endl;
-        for (const auto& item : items) {
-            std::cout << "  - " << item.name << ": $" << item.price << std::endl;
-        }
-        std::cout << "Total: $" << getTotal() << std::endl;
-    }
-};
-
 int main() {
     std::cout << "=== Solution 1: Circle ===" << std::endl;
     Circle c;
@@ -141,6 +74,14 @@ int main() {
     alice.addGrade(78);
     alice.addGrade(150);  // Invalid
     std::cout << alice.getName() << "'s average: " << alice.getAverage() << std::endl;
+
+    int termGrades[] = {92, 67, 88, -5, 75};
+    size_t added = alice.addGrades(termGrades);
+    const GradeStats& stats = alice.getStats();
+    std::cout << "Bulk-added " << added << " grades; now " << stats.count()
+              << " grades, mean " << stats.mean() << ", stddev " << stats.stddev()
+              << ", min " << stats.min() << ", max " << stats.max()
+              << ", median " << stats.median() << std::endl;
     std::cout << std::endl;
     
     std::cout << "=== Solution 3: Global Counter ===" << std::endl;
@@ -153,14 +94,28 @@ int main() {
     
     std::cout << "=== Solution 4: Shopping Cart ===" << std::endl;
     ShoppingCart cart;
-    cart.addItem("Apple", 1.50)
+    cart.reserve(3)
+        .addItem("Apple", 1.50)
         .addItem("Banana", 0.75)
-        .addItem("Orange", 1.25);
+        .emplaceItem("Orange", 1.25);
     cart.printItems();
     
     std::cout << "\nAfter removing Banana:" << std::endl;
     cart.removeItem("Banana");
     cart.printItems();
-    
+
+    // BONUS: same interface, O(1) remove and total (see indexed_cart.h)
+    std::cout << "\n=== Bonus: Indexed Shopping Cart ===" << std::endl;
+    IndexedShoppingCart indexed;
+    indexed.addItem("Apple", 1.50)
+           .addItem("Banana", 0.75)
+           .addItem("Orange", 1.25)
+           .addItem("Apple", 1.50);  // Stacks onto the Apple line
+    indexed.printItems();
+
+    std::cout << "\nAfter removing Banana:" << std::endl;
+    indexed.removeItem("Banana");  // Orange moves into Banana's slot
+    indexed.printItems();
+
     return 0;
 }
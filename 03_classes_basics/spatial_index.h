@@ -0,0 +1,557 @@
+#pragma once
+
+// Spatial indexes over 2D points: "which points fall in this rectangle?" and
+// "which k points are closest?" without scanning every point.
+//
+//     PointStore points;                           // SoA: all x, then all y
+//     for (...) points.add(x, y);                  // Ids are insertion order
+//
+//     UniformGrid grid(points);                    // Or: PackedRTree tree(points);
+//     std::vector<PointId> hits;
+//     grid.query({0, 0, 10, 10}, hits);            // Appends ids inside the box (edges count)
+//     grid.nearest(5, 5, 8, hits);                 // Appends the 8 closest, nearest first
+//
+//     par::ThreadPool pool;                        // 12_lambda_expressions
+//     QueryResults r = queryBatch(tree, boxes, pool);   // r[q]: the ids for boxes[q]
+//
+// UniformGrid buckets the points into square cells of about kPointsPerCell
+// points (one counting sort) and stores them cell by cell, row-major, so a
+// rectangle query reads one contiguous run per row of cells it overlaps. It is
+// the fastest choice when points are spread evenly.
+//
+// PackedRTree sorts the points along a Hilbert curve and packs them into a
+// static R-tree: 16 points per leaf, 16 nodes per parent, every level a flat
+// array of SoA bounding boxes (no pointers, no per-node allocation). Built in
+// O(n log n), it adapts to clustered data where fixed cells would be mostly
+// empty or overfull, and a subtree that lies entirely inside the query is
+// emitted as one contiguous range without testing its points.
+//
+// Both are immutable snapshots of the PointStore they were built from:
+// rebuild after the points change. Queries are const and may run from many
+// threads at once. queryBatch() and nearestBatch() split a batch over a
+// par::ThreadPool and return all results in one flat array. Coordinates must
+// be finite.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../12_lambda_expressions/parallel_algorithms.h"
+#include "../common/span.h"
+
+using PointId = std::uint32_t;
+
+struct PointF {
+    float x, y;
+};
+
+struct BoundingBox {
+    float minX, minY, maxX, maxY;
+
+    static BoundingBox empty() {
+        const float inf = std::numeric_limits<float>::infinity();
+        return {inf, inf, -inf, -inf};
+    }
+
+    bool contains(float x, float y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+    bool contains(const BoundingBox& b) const {
+        return b.minX >= minX && b.maxX <= maxX && b.minY >= minY && b.maxY <= maxY;
+    }
+    bool intersects(const BoundingBox& b) const {
+        return b.minX <= maxX && b.maxX >= minX && b.minY <= maxY && b.maxY >= minY;
+    }
+
+    // From (x, y) to the closest point of the box; 0 inside
+    float distanceSquared(float x, float y) const {
+        float dx = std::max(std::max(minX - x, x - maxX), 0.0f);
+        float dy = std::max(std::max(minY - y, y - maxY), 0.0f);
+        return dx * dx + dy * dy;
+    }
+
+    void expand(float x, float y) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+    void expand(const BoundingBox& b) {
+        minX = std::min(minX, b.minX);
+        minY = std::min(minY, b.minY);
+        maxX = std::max(maxX, b.maxX);
+        maxY = std::max(maxY, b.maxY);
+    }
+};
+
+// Structure-of-arrays point storage; a point's id is its insertion index
+class PointStore {
+public:
+    PointId add(float x, float y) {
+        xs.push_back(x);
+        ys.push_back(y);
+        return static_cast<PointId>(xs.size() - 1);
+    }
+
+    void reserve(size_t n) {
+        xs.reserve(n);
+        ys.reserve(n);
+    }
+
+    size_t size() const { return xs.size(); }
+    float x(PointId id) const { return xs[id]; }
+    float y(PointId id) const { return ys[id]; }
+    const float* xData() const { return xs.data(); }
+    const float* yData() const { return ys.data(); }
+
+    BoundingBox bounds() const {
+        BoundingBox b = BoundingBox::empty();
+        for (size_t i = 0; i < xs.size(); ++i) b.expand(xs[i], ys[i]);
+        return b;
+    }
+
+private:
+    std::vector<float> xs, ys;
+};
+
+namespace spatial_detail {
+
+struct Neighbor {
+    float distanceSquared;
+    PointId id;
+
+    // Ties go to the lower id, so every index returns the same neighbours
+    bool operator<(const Neighbor& other) const {
+        return distanceSquared < other.distanceSquared ||
+               (distanceSquared == other.distanceSquared && id < other.id);
+    }
+};
+
+// The k best candidates seen so far, as a max-heap (worst on top). The
+// storage is per thread and reused, so a query does not allocate.
+class KBest {
+public:
+    explicit KBest(size_t k) : k(k), heap(scratch()) { heap.clear(); }
+
+    float worst() const {
+        return heap.size() < k ? std::numeric_limits<float>::infinity() : heap.front().distanceSquared;
+    }
+
+    void offer(float distanceSquared, PointId id) {
+        Neighbor n{distanceSquared, id};
+        if (heap.size() < k) {
+            heap.push_back(n);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (n < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = n;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    // Appends the ids, nearest first
+    void appendSorted(std::vector<PointId>& out) {
+        std::sort_heap(heap.begin(), heap.end());
+        for (const Neighbor& n : heap) out.push_back(n.id);
+    }
+
+private:
+    size_t k;
+    std::vector<Neighbor>& heap;
+
+    static std::vector<Neighbor>& scratch() {
+        static thread_local std::vector<Neighbor> storage;
+        return storage;
+    }
+};
+
+// Position along a Hilbert curve through a 65536 x 65536 grid
+inline std::uint32_t hilbertIndex(std::uint32_t x, std::uint32_t y) {
+    const std::uint32_t n = 1u << 16;
+    std::uint32_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) ? 1 : 0;
+        std::uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {  // Rotate the quadrant
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+}  // namespace spatial_detail
+
+class UniformGrid {
+public:
+    static constexpr size_t kPointsPerCell = 8;
+    static constexpr size_t kMaxCellsPerAxis = 1 << 12;  // At most 16M cells
+
+    // cellSize 0: chosen so that cells hold about kPointsPerCell points on average
+    explicit UniformGrid(const PointStore& points, float cellSize = 0) : bounds(points.bounds()) {
+        size_t n = points.size();
+        if (n == 0) {
+            bounds = {0, 0, 0, 0};
+            cellStart.assign(2, 0);
+            return;
+        }
+        double w = static_cast<double>(bounds.maxX) - bounds.minX;
+        double h = static_cast<double>(bounds.maxY) - bounds.minY;
+        if (!(cellSize > 0)) {
+            double cells = std::max<double>(1.0, static_cast<double>(n) / kPointsPerCell);
+            double across = h > 0 ? std::sqrt(cells * w / h) : cells;  // Cells along x
+            across = std::min(std::max(across, 1.0), cells);
+            double side = std::max(w / across, h / std::max(1.0, std::floor(cells / across)));
+            cellSize = side > 0 ? static_cast<float>(side) : 1.0f;
+        }
+        this->cellSize = cellSize;
+        inverseCellSize = 1.0f / cellSize;
+        cellsX = std::min(kMaxCellsPerAxis, static_cast<size_t>(w / cellSize) + 1);
+        cellsY = std::min(kMaxCellsPerAxis, static_cast<size_t>(h / cellSize) + 1);
+
+        // Counting sort by cell
+        std::vector<std::uint32_t> cellOf(n);
+        cellStart.assign(cellsX * cellsY + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            cellOf[i] = static_cast<std::uint32_t>(cellY(points.y(static_cast<PointId>(i))) * cellsX +
+                                                   cellX(points.x(static_cast<PointId>(i))));
+            ++cellStart[cellOf[i] + 1];
+        }
+        for (size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+        std::vector<std::uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+        xs.resize(n);
+        ys.resize(n);
+        ids.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            std::uint32_t slot = cursor[cellOf[i]]++;
+            xs[slot] = points.x(static_cast<PointId>(i));
+            ys[slot] = points.y(static_cast<PointId>(i));
+            ids[slot] = static_cast<PointId>(i);
+        }
+    }
+
+    size_t size() const { return ids.size(); }
+    size_t cellCountX() const { return cellsX; }
+    size_t cellCountY() const { return cellsY; }
+    float getCellSize() const { return cellSize; }
+
+    // f(id) for every point inside box
+    template <typename F>
+    void forEachInBox(const BoundingBox& box, F&& f) const {
+        if (ids.empty() || !box.intersects(bounds)) return;
+        size_t x0 = cellX(box.minX), x1 = cellX(box.maxX);
+        size_t y0 = cellY(box.minY), y1 = cellY(box.maxY);
+        for (size_t row = y0; row <= y1; ++row) {  // Cells x0..x1 of a row are one run
+            std::uint32_t begin = cellStart[row * cellsX + x0], end = cellStart[row * cellsX + x1 + 1];
+            for (std::uint32_t i = begin; i < end; ++i) {
+                if (box.contains(xs[i], ys[i])) f(ids[i]);
+            }
+        }
+    }
+
+    void query(const BoundingBox& box, std::vector<PointId>& out) const {
+        forEachInBox(box, [&out](PointId id) { out.push_back(id); });
+    }
+
+    size_t count(const BoundingBox& box) const {
+        size_t n = 0;
+        forEachInBox(box, [&n](PointId) { ++n; });
+        return n;
+    }
+
+    // Appends the k points closest to (x, y), nearest first. Searches rings of
+    // cells outward until no unvisited cell can beat the k-th best.
+    void nearest(float x, float y, size_t k, std::vector<PointId>& out) const {
+        if (k == 0 || ids.empty()) return;
+        spatial_detail::KBest best(k);
+        const long cx = static_cast<long>(cellX(x)), cy = static_cast<long>(cellY(y));
+        const long lastX = static_cast<long>(cellsX) - 1, lastY = static_cast<long>(cellsY) - 1;
+
+        auto visitRun = [&](long row, long from, long to) {
+            if (row < 0 || row > lastY) return;
+            from = std::max(from, 0L);
+            to = std::min(to, lastX);
+            if (from > to) return;
+            std::uint32_t begin = cellStart[row * cellsX + from], end = cellStart[row * cellsX + to + 1];
+            for (std::uint32_t i = begin; i < end; ++i) {
+                float dx = xs[i] - x, dy = ys[i] - y;
+                best.offer(dx * dx + dy * dy, ids[i]);
+            }
+        };
+
+        for (long r = 0;; ++r) {
+            if (r == 0) {
+                visitRun(cy, cx, cx);
+            } else {
+                visitRun(cy - r, cx - r, cx + r);
+                visitRun(cy + r, cx - r, cx + r);
+                for (long row = std::max(cy - r + 1, 0L); row <= std::min(cy + r - 1, lastY); ++row) {
+                    visitRun(row, cx - r, cx - r);
+                    visitRun(row, cx + r, cx + r);
+                }
+            }
+            bool left = cx - r > 0, right = cx + r < lastX, below = cy - r > 0, above = cy + r < lastY;
+            if (!left && !right && !below && !above) break;  // Every cell visited
+
+            // Anything unvisited lies beyond the nearest open side of the square
+            float reach = std::numeric_limits<float>::infinity();
+            if (left) reach = std::min(reach, x - (bounds.minX + (cx - r) * cellSize));
+            if (right) reach = std::min(reach, bounds.minX + (cx + r + 1) * cellSize - x);
+            if (below) reach = std::min(reach, y - (bounds.minY + (cy - r) * cellSize));
+            if (above) reach = std::min(reach, bounds.minY + (cy + r + 1) * cellSize - y);
+            reach -= cellSize * 1e-3f;  // Slack for points rounded into the next cell
+            if (reach > 0 && reach * reach > best.worst()) break;
+        }
+        best.appendSorted(out);
+    }
+
+private:
+    BoundingBox bounds;
+    float cellSize = 1, inverseCellSize = 1;
+    size_t cellsX = 1, cellsY = 1;
+    std::vector<std::uint32_t> cellStart;  // Points of cell c: [cellStart[c], cellStart[c + 1])
+    std::vector<float> xs, ys;             // Sorted by cell
+    std::vector<PointId> ids;
+
+    // Clamped, so points and query corners outside the grid map to edge cells
+    size_t cellX(float x) const {
+        float f = (x - bounds.minX) * inverseCellSize;
+        return f <= 0 ? 0 : std::min(static_cast<size_t>(f), cellsX - 1);
+    }
+    size_t cellY(float y) const {
+        float f = (y - bounds.minY) * inverseCellSize;
+        return f <= 0 ? 0 : std::min(static_cast<size_t>(f), cellsY - 1);
+    }
+};
+
+class PackedRTree {
+public:
+    static constexpr size_t kNodeSize = 16;  // Points per leaf, children per node
+
+    explicit PackedRTree(const PointStore& points) {
+        size_t n = points.size();
+        if (n == 0) return;
+
+        // Hilbert order keeps nearby points in nearby slots at every level
+        BoundingBox b = points.bounds();
+        double sx = b.maxX > b.minX ? 65535.0 / (static_cast<double>(b.maxX) - b.minX) : 0.0;
+        double sy = b.maxY > b.minY ? 65535.0 / (static_cast<double>(b.maxY) - b.minY) : 0.0;
+        std::vector<std::pair<std::uint32_t, PointId>> order(n);
+        for (size_t i = 0; i < n; ++i) {
+            PointId id = static_cast<PointId>(i);
+            auto hx = static_cast<std::uint32_t>((points.x(id) - b.minX) * sx);
+            auto hy = static_cast<std::uint32_t>((points.y(id) - b.minY) * sy);
+            order[i] = {spatial_detail::hilbertIndex(hx, hy), id};
+        }
+        std::sort(order.begin(), order.end());
+        xs.resize(n);
+        ys.resize(n);
+        ids.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            ids[i] = order[i].second;
+            xs[i] = points.x(ids[i]);
+            ys[i] = points.y(ids[i]);
+        }
+
+        // Leaves, then each level above, until a single root
+        levelStart.push_back(0);
+        size_t count = (n + kNodeSize - 1) / kNodeSize;
+        for (size_t j = 0; j < count; ++j) {
+            BoundingBox box = BoundingBox::empty();
+            for (size_t i = j * kNodeSize; i < std::min(n, (j + 1) * kNodeSize); ++i) box.expand(xs[i], ys[i]);
+            pushNode(box);
+        }
+        levelStart.push_back(nodeCount());
+        while (count > 1) {
+            size_t below = levelStart[levelStart.size() - 2];
+            size_t parents = (count + kNodeSize - 1) / kNodeSize;
+            for (size_t j = 0; j < parents; ++j) {
+                BoundingBox box = BoundingBox::empty();
+                for (size_t c = j * kNodeSize; c < std::min(count, (j + 1) * kNodeSize); ++c) {
+                    box.expand(nodeBox(below + c));
+                }
+                pushNode(box);
+            }
+            levelStart.push_back(nodeCount());
+            count = parents;
+        }
+    }
+
+    size_t size() const { return ids.size(); }
+    size_t height() const { return levelStart.empty() ? 0 : levelStart.size() - 1; }  // Levels incl. leaves
+
+    // f(id) for every point inside box
+    template <typename F>
+    void forEachInBox(const BoundingBox& box, F&& f) const {
+        if (ids.empty()) return;
+        const size_t root = height() - 1;
+        if (!box.intersects(nodeBox(levelStart[root]))) return;
+
+        struct Entry {
+            size_t level, index;
+        };
+        Entry stack[kNodeSize * 8 + 1];  // 8 levels hold 16^8 = 2^32 points
+        size_t top = 0;
+        stack[top++] = {root, 0};
+        while (top > 0) {
+            Entry e = stack[--top];
+            if (e.level == 0) {
+                for (size_t i = e.index * kNodeSize, end = std::min(ids.size(), i + kNodeSize); i < end; ++i) {
+                    if (box.contains(xs[i], ys[i])) f(ids[i]);
+                }
+                continue;
+            }
+            size_t first = e.index * kNodeSize;
+            size_t last = std::min(levelSize(e.level - 1), first + kNodeSize);
+            for (size_t c = first; c < last; ++c) {
+                size_t g = levelStart[e.level - 1] + c;
+                BoundingBox child = nodeBox(g);
+                if (!box.intersects(child)) continue;
+                if (box.contains(child)) {  // Whole subtree: one contiguous run of points
+                    size_t span = subtreePoints(e.level - 1);
+                    for (size_t i = c * span, end = std::min(ids.size(), i + span); i < end; ++i) f(ids[i]);
+                } else {
+                    stack[top++] = {e.level - 1, c};
+                }
+            }
+        }
+    }
+
+    void query(const BoundingBox& box, std::vector<PointId>& out) const {
+        forEachInBox(box, [&out](PointId id) { out.push_back(id); });
+    }
+
+    size_t count(const BoundingBox& box) const {
+        size_t n = 0;
+        forEachInBox(box, [&n](PointId) { ++n; });
+        return n;
+    }
+
+    // Appends the k points closest to (x, y), nearest first (best-first search)
+    void nearest(float x, float y, size_t k, std::vector<PointId>& out) const {
+        if (k == 0 || ids.empty()) return;
+        spatial_detail::KBest best(k);
+
+        struct Entry {  // 12 bytes: the heap stays small and cheap to sift
+            float distanceSquared;
+            std::uint32_t level, index;
+            bool operator<(const Entry& o) const { return distanceSquared > o.distanceSquared; }  // Min-heap
+        };
+        static thread_local std::vector<Entry> storage;  // Reused: no allocation per query
+        std::vector<Entry>& queue = storage;
+        queue.clear();
+        const size_t root = height() - 1;
+        queue.push_back({nodeBox(levelStart[root]).distanceSquared(x, y), static_cast<std::uint32_t>(root), 0});
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end());
+            Entry e = queue.back();
+            queue.pop_back();
+            if (e.distanceSquared > best.worst()) break;  // Nothing left can be closer
+            if (e.level == 0) {
+                for (size_t i = e.index * kNodeSize, end = std::min(ids.size(), i + kNodeSize); i < end; ++i) {
+                    float dx = xs[i] - x, dy = ys[i] - y;
+                    best.offer(dx * dx + dy * dy, ids[i]);
+                }
+                continue;
+            }
+            size_t first = e.index * kNodeSize;
+            size_t last = std::min(levelSize(e.level - 1), first + kNodeSize);
+            for (size_t c = first; c < last; ++c) {
+                float d = nodeBox(levelStart[e.level - 1] + c).distanceSquared(x, y);
+                if (d <= best.worst()) {
+                    queue.push_back({d, e.level - 1, static_cast<std::uint32_t>(c)});
+                    std::push_heap(queue.begin(), queue.end());
+                }
+            }
+        }
+        best.appendSorted(out);
+    }
+
+private:
+    std::vector<float> xs, ys;  // Hilbert order
+    std::vector<PointId> ids;
+    // Node boxes, leaves first, one level after another
+    std::vector<float> minX, minY, maxX, maxY;
+    std::vector<size_t> levelStart;  // Level L is nodes [levelStart[L], levelStart[L + 1])
+
+    size_t nodeCount() const { return minX.size(); }
+    size_t levelSize(size_t level) const { return levelStart[level + 1] - levelStart[level]; }
+    BoundingBox nodeBox(size_t g) const { return {minX[g], minY[g], maxX[g], maxY[g]}; }
+
+    // Points under one node of the given level (the last node may have fewer)
+    static size_t subtreePoints(size_t level) {
+        size_t span = kNodeSize;
+        for (size_t l = 0; l < level; ++l) span *= kNodeSize;
+        return span;
+    }
+
+    void pushNode(const BoundingBox& b) {
+        minX.push_back(b.minX);
+        minY.push_back(b.minY);
+        maxX.push_back(b.maxX);
+        maxY.push_back(b.maxY);
+    }
+};
+
+// All results of a batch in one array: the ids for query q are results[q]
+struct QueryResults {
+    std::vector<size_t> offsets;  // Query q: ids[offsets[q], offsets[q + 1])
+    std::vector<PointId> ids;
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    Span<const PointId> operator[](size_t q) const {
+        return {ids.data() + offsets[q], offsets[q + 1] - offsets[q]};
+    }
+};
+
+namespace spatial_detail {
+
+// run(q, out) appends query q's ids. Queries are split into a few chunks per
+// thread; each chunk collects into its own array, then the arrays are joined.
+template <typename Run>
+QueryResults runBatch(size_t queries, par::ThreadPool& pool, Run run) {
+    QueryResults results;
+    results.offsets.assign(queries + 1, 0);
+    size_t chunks = std::min(queries, static_cast<size_t>(pool.size()) * 4);
+    if (chunks == 0) return results;
+    std::vector<std::vector<PointId>> found(chunks);
+    pool.run(chunks, [&](size_t c) {
+        std::vector<PointId>& out = found[c];
+        for (size_t q = queries * c / chunks, end = queries * (c + 1) / chunks; q < end; ++q) {
+            size_t before = out.size();
+            run(q, out);
+            results.offsets[q + 1] = out.size() - before;  // A count for now
+        }
+    });
+    for (size_t q = 0; q < queries; ++q) results.offsets[q + 1] += results.offsets[q];
+    results.ids.resize(results.offsets[queries]);
+    for (size_t c = 0; c < chunks; ++c) {
+        std::copy(found[c].begin(), found[c].end(), results.ids.begin() + results.offsets[queries * c / chunks]);
+    }
+    return results;
+}
+
+}  // namespace spatial_detail
+
+// Rectangle queries against UniformGrid or PackedRTree, spread over the pool
+template <typename Index>
+QueryResults queryBatch(const Index& index, Span<const BoundingBox> boxes,
+                        par::ThreadPool& pool = par::ThreadPool::instance()) {
+    return spatial_detail::runBatch(boxes.size(), pool,
+                                    [&](size_t q, std::vector<PointId>& out) { index.query(boxes[q], out); });
+}
+
+// k-nearest-neighbour queries; each result lists min(k, size) ids, nearest first
+template <typename Index>
+QueryResults nearestBatch(const Index& index, Span<const PointF> centers, size_t k,
+                          par::ThreadPool& pool = par::ThreadPool::instance()) {
+    return spatial_detail::runBatch(centers.size(), pool, [&](size_t q, std::vector<PointId>& out) {
+        index.nearest(centers[q].x, centers[q].y, k, out);
+    });
+}
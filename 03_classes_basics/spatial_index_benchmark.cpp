@@ -0,0 +1,283 @@
+// Rectangle and k-nearest queries: linear scan vs UniformGrid vs PackedRTree.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o spatial_index_benchmark spatial_index_benchmark.cpp
+//     ./spatial_index_benchmark [points] [queries] [max_threads]
+//         defaults: 1000000 points, 200000 queries, threads up to hardware_concurrency
+//
+// Two point sets on a 10000 x 10000 map: uniform, and 64 dense clusters (where
+// a fixed grid is at its worst). Rectangle queries are centred on data points
+// and sized for about 32 hits on uniform data; k-nearest queries ask for 8.
+// The linear scan runs a sample of the queries and checks both indexes; the
+// single-threaded index results then check the batched ones.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "spatial_index.h"
+
+namespace {
+
+constexpr float kMapSize = 10000.0f;
+constexpr size_t kNeighbors = 8;
+constexpr size_t kScanQueries = 500;
+
+PointStore makePoints(size_t n, bool clustered, std::mt19937& rng) {
+    PointStore points;
+    points.reserve(n);
+    std::uniform_real_distribution<float> anywhere(0.0f, kMapSize);
+    if (!clustered) {
+        for (size_t i = 0; i < n; ++i) points.add(anywhere(rng), anywhere(rng));
+        return points;
+    }
+    std::vector<PointF> centers(64);
+    for (PointF& c : centers) c = {anywhere(rng), anywhere(rng)};
+    std::normal_distribution<float> spread(0.0f, 60.0f);
+    for (size_t i = 0; i < n; ++i) {
+        const PointF& c = centers[i % centers.size()];
+        float x = std::min(std::max(c.x + spread(rng), 0.0f), kMapSize);
+        float y = std::min(std::max(c.y + spread(rng), 0.0f), kMapSize);
+        points.add(x, y);
+    }
+    return points;
+}
+
+// Baselines: every point, every query
+void scanQuery(const PointStore& points, const BoundingBox& box, std::vector<PointId>& out) {
+    const float* xs = points.xData();
+    const float* ys = points.yData();
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (box.contains(xs[i], ys[i])) out.push_back(static_cast<PointId>(i));
+    }
+}
+
+void scanNearest(const PointStore& points, float x, float y, size_t k, std::vector<PointId>& out) {
+    spatial_detail::KBest best(k);
+    const float* xs = points.xData();
+    const float* ys = points.yData();
+    for (size_t i = 0; i < points.size(); ++i) {
+        float dx = xs[i] - x, dy = ys[i] - y;
+        best.offer(dx * dx + dy * dy, static_cast<PointId>(i));
+    }
+    best.appendSorted(out);
+}
+
+// Range results come back in index order; compare them as sets
+bool sameSet(std::vector<PointId> a, Span<const PointId> b) {
+    std::vector<PointId> sortedB(b.begin(), b.end());
+    std::sort(a.begin(), a.end());
+    std::sort(sortedB.begin(), sortedB.end());
+    return a == sortedB;
+}
+
+bool sameList(const std::vector<PointId>& a, Span<const PointId> b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+Span<const PointId> asSpan(const std::vector<PointId>& v) { return {v.data(), v.size()}; }
+
+void row(const char* name, double ms, size_t queries, double baselineRate, bool same) {
+    double rate = queries / ms * 1e3;
+    std::printf("  %-34s %12.0f queries/s %9.1fx%s\n", name, rate, rate / baselineRate,
+                same ? "" : "   MISMATCH");
+}
+
+// All queries one after another on this thread, into one QueryResults
+template <typename Run>
+QueryResults runSerial(size_t queries, Run run) {
+    QueryResults results;
+    results.offsets.assign(1, 0);
+    for (size_t q = 0; q < queries; ++q) {
+        run(q, results.ids);
+        results.offsets.push_back(results.ids.size());
+    }
+    return results;
+}
+
+bool sameResults(const QueryResults& a, const QueryResults& b, bool ordered) {
+    if (a.size() != b.size()) return false;
+    for (size_t q = 0; q < a.size(); ++q) {
+        std::vector<PointId> expected(a[q].begin(), a[q].end());
+        if (ordered ? !sameList(expected, b[q]) : !sameSet(expected, b[q])) return false;
+    }
+    return true;
+}
+
+template <typename Index>
+bool benchIndex(const char* name, const Index& index, const PointStore& points, const std::vector<BoundingBox>& boxes,
+                const std::vector<PointF>& centers, double scanBoxRate, double scanNearestRate,
+                unsigned maxThreads) {
+    bool ok = true;
+    std::printf("%s\n", name);
+
+    // Against the linear scan on the first kScanQueries queries
+    std::vector<PointId> expected, got;
+    bool boxesMatch = true, nearestMatch = true;
+    for (size_t q = 0; q < kScanQueries && q < boxes.size(); ++q) {
+        expected.clear();
+        got.clear();
+        scanQuery(points, boxes[q], expected);
+        index.query(boxes[q], got);
+        boxesMatch = boxesMatch && sameSet(expected, asSpan(got));
+        expected.clear();
+        got.clear();
+        scanNearest(points, centers[q].x, centers[q].y, kNeighbors, expected);
+        index.nearest(centers[q].x, centers[q].y, kNeighbors, got);
+        nearestMatch = nearestMatch && sameList(expected, asSpan(got));
+    }
+
+    QueryResults serialBoxes, serialNearest;
+    double boxMs = bench::bestOfMs([&] {
+        serialBoxes = runSerial(boxes.size(), [&](size_t q, std::vector<PointId>& out) { index.query(boxes[q], out); });
+    }, 3);
+    double nearestMs = bench::bestOfMs([&] {
+        serialNearest = runSerial(centers.size(), [&](size_t q, std::vector<PointId>& out) {
+            index.nearest(centers[q].x, centers[q].y, kNeighbors, out);
+        });
+    }, 3);
+    row("rectangle, one thread", boxMs, boxes.size(), scanBoxRate, boxesMatch);
+    row("8-nearest, one thread", nearestMs, centers.size(), scanNearestRate, nearestMatch);
+    ok = ok && boxesMatch && nearestMatch;
+
+    Span<const BoundingBox> boxSpan(boxes.data(), boxes.size());
+    Span<const PointF> centerSpan(centers.data(), centers.size());
+    for (unsigned threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        par::ThreadPool pool(threads);
+        QueryResults batchBoxes, batchNearest;
+        double ms = bench::bestOfMs([&] { batchBoxes = queryBatch(index, boxSpan, pool); }, 3);
+        char label[64];
+        std::snprintf(label, sizeof(label), "queryBatch, %u thread%s", threads, threads == 1 ? "" : "s");
+        bool same = sameResults(serialBoxes, batchBoxes, false);
+        row(label, ms, boxes.size(), scanBoxRate, same);
+        ok = ok && same;
+
+        ms = bench::bestOfMs([&] { batchNearest = nearestBatch(index, centerSpan, kNeighbors, pool); }, 3);
+        std::snprintf(label, sizeof(label), "nearestBatch, %u thread%s", threads, threads == 1 ? "" : "s");
+        same = sameResults(serialNearest, batchNearest, true);
+        row(label, ms, centers.size(), scanNearestRate, same);
+        ok = ok && same;
+        if (threads == maxThreads) break;
+    }
+    std::printf("\n");
+    return ok;
+}
+
+bool runDataset(const char* label, size_t n, size_t queries, bool clustered, unsigned maxThreads) {
+    std::mt19937 rng(clustered ? 7 : 42);
+    PointStore points = makePoints(n, clustered, rng);
+
+    // Centred on data points, so queries land where the data is
+    float half = 0.5f * std::sqrt(32.0f * kMapSize * kMapSize / static_cast<float>(n));
+    std::normal_distribution<float> jitter(0.0f, half);
+    std::uniform_int_distribution<PointId> pick(0, static_cast<PointId>(n - 1));
+    std::vector<BoundingBox> boxes(queries);
+    std::vector<PointF> centers(queries);
+    for (size_t q = 0; q < queries; ++q) {
+        PointId id = pick(rng);
+        float x = points.x(id) + jitter(rng), y = points.y(id) + jitter(rng);
+        boxes[q] = {x - half, y - half, x + half, y + half};
+        centers[q] = {points.x(pick(rng)) + jitter(rng), points.y(pick(rng)) + jitter(rng)};
+    }
+
+    auto t0 = bench::Clock::now();
+    UniformGrid grid(points);
+    double gridBuildMs = std::chrono::duration<double, std::milli>(bench::Clock::now() - t0).count();
+    t0 = bench::Clock::now();
+    PackedRTree tree(points);
+    double treeBuildMs = std::chrono::duration<double, std::milli>(bench::Clock::now() - t0).count();
+
+    size_t hits = 0;
+    for (size_t q = 0; q < std::min(queries, kScanQueries); ++q) hits += grid.count(boxes[q]);
+    std::printf("=== %s: %zu points, %zu queries, ~%.0f hits per rectangle ===\n", label, n, queries,
+                static_cast<double>(hits) / std::min(queries, kScanQueries));
+    std::printf("build: grid %zu x %zu cells in %.1f ms, R-tree of height %zu in %.1f ms\n\n",
+                grid.cellCountX(), grid.cellCountY(), gridBuildMs, tree.height(), treeBuildMs);
+
+    size_t sample = std::min(queries, kScanQueries);
+    std::vector<PointId> out;
+    double scanBoxMs = bench::bestOfMs([&] {
+        out.clear();
+        for (size_t q = 0; q < sample; ++q) scanQuery(points, boxes[q], out);
+        bench::doNotOptimize(out.data());
+    }, 3);
+    double scanNearestMs = bench::bestOfMs([&] {
+        out.clear();
+        for (size_t q = 0; q < sample; ++q) scanNearest(points, centers[q].x, centers[q].y, kNeighbors, out);
+        bench::doNotOptimize(out.data());
+    }, 3);
+    double scanBoxRate = sample / scanBoxMs * 1e3, scanNearestRate = sample / scanNearestMs * 1e3;
+    std::printf("Linear scan (%zu queries)\n", sample);
+    row("rectangle", scanBoxMs, sample, scanBoxRate, true);
+    row("8-nearest", scanNearestMs, sample, scanNearestRate, true);
+    std::printf("\n");
+
+    bool ok = benchIndex("UniformGrid", grid, points, boxes, centers, scanBoxRate, scanNearestRate, maxThreads);
+    ok = benchIndex("PackedRTree", tree, points, boxes, centers, scanBoxRate, scanNearestRate, maxThreads) && ok;
+    return ok;
+}
+
+// Small and degenerate inputs, where edge handling goes wrong first
+bool checkEdgeCases() {
+    bool ok = true;
+    PointStore empty;
+    UniformGrid emptyGrid(empty);
+    PackedRTree emptyTree(empty);
+    std::vector<PointId> out;
+    emptyGrid.query({0, 0, 1, 1}, out);
+    emptyTree.query({0, 0, 1, 1}, out);
+    emptyGrid.nearest(0, 0, 3, out);
+    emptyTree.nearest(0, 0, 3, out);
+    ok = ok && out.empty();
+
+    PointStore line;  // All on one horizontal line, with duplicates
+    for (int i = 0; i < 1000; ++i) line.add(static_cast<float>(i % 500), 5.0f);
+    UniformGrid lineGrid(line);
+    PackedRTree lineTree(line);
+    std::vector<PointId> expected, got;
+    const BoundingBox probes[] = {{10, 5, 20, 5}, {-100, -100, 1e6f, 1e6f}, {499, 0, 600, 10}, {0, 6, 10, 7}};
+    for (const BoundingBox& box : probes) {
+        expected.clear();
+        scanQuery(line, box, expected);
+        got.clear();
+        lineGrid.query(box, got);
+        ok = ok && sameSet(expected, asSpan(got));
+        got.clear();
+        lineTree.query(box, got);
+        ok = ok && sameSet(expected, asSpan(got));
+    }
+    const PointF far[] = {{-1000, -1000}, {250.5f, 5}, {1e5f, 5}};
+    for (const PointF& p : far) {  // Far outside the data, and k larger than the set
+        for (size_t k : {size_t(1), size_t(7), size_t(2000)}) {
+            expected.clear();
+            scanNearest(line, p.x, p.y, k, expected);
+            got.clear();
+            lineGrid.nearest(p.x, p.y, k, got);
+            ok = ok && sameList(expected, asSpan(got));
+            got.clear();
+            lineTree.nearest(p.x, p.y, k, got);
+            ok = ok && sameList(expected, asSpan(got));
+        }
+    }
+    std::printf("Empty set, collinear duplicates, far queries, k > size: %s\n", ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 1000000);
+    size_t queries = bench::argOr(argc, argv, 2, 200000);
+    unsigned maxThreads = static_cast<unsigned>(
+        bench::argOr(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency())));
+    if (n == 0 || queries == 0 || maxThreads == 0) return 1;
+
+    bool ok = checkEdgeCases();
+    std::printf("\n");
+    ok = runDataset("Uniform", n, queries, false, maxThreads) && ok;
+    ok = runDataset("64 clusters", n, queries, true, maxThreads) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+// Student from solution.cpp, shared with cart_allocation_benchmark.cpp so the
+// benchmark measures the real class
+
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "grade_stats.h"
+
+class Student {
+private:
+    std::string name;
+    std::vector<int> grades;
+    GradeStats stats;  // Kept in step with grades, so queries below are O(1)
+    
+public:
+    // Sink parameter: a temporary name is moved in, a named one copied once
+    Student(std::string studentName) : name(std::move(studentName)) {}
+    
+    void addGrade(int grade) {
+        if (stats.add(grade)) {
+            grades.push_back(grade);
+        } else {
+            std::cout << "Invalid grade: " << grade << " (must be 0-100)" << std::endl;
+        }
+    }
+
+    void reserveGrades(size_t n) {
+        grades.reserve(n);
+    }
+
+    // Bulk load (e.g. a whole term imported at once); invalid grades are skipped
+    size_t addGrades(Span<const int> newGrades) {
+        grades.reserve(grades.size() + newGrades.size());
+        for (int g : newGrades) {
+            if (GradeStats::isValid(g)) grades.push_back(g);
+        }
+        return stats.addGrades(newGrades);
+    }
+    
+    double getAverage() const {
+        return stats.mean();
+    }
+
+    // Textbook version: recomputes from scratch on every call
+    double getAverageByScan() const {
+        if (grades.empty()) return 0.0;
+        return std::accumulate(grades.begin(), grades.end(), 0.0) / grades.size();
+    }
+
+    const GradeStats& getStats() const {
+        return stats;
+    }
+    
+    const std::string& getName() const {  // No copy unless the caller keeps one
+        return name;
+    }
+    
+    size_t getGradeCount() const {
+        return grades.size();
+    }
+};
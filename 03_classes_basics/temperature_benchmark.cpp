@@ -0,0 +1,183 @@
+// Bulk temperature conversion: a loop over Temperature objects vs TemperatureSeries kernels.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o temperature_benchmark temperature_benchmark.cpp
+//     ./temperature_benchmark [readings]      (default: 4000000)
+//
+// Every variant converts the same Celsius readings to Fahrenheit and reports
+// min, max and mean. The object loop calls getFahrenheit() per reading (as
+// written in example.cpp, with its division), then makes a second pass for
+// the statistics. The kernels do both in one pass over a double array, over a
+// float array, and in place on a TemperatureSeries. Add -mavx2 (or
+// -march=native) for the AVX kernels.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "temperature_series.h"
+
+namespace {
+
+// As in example.cpp
+class Temperature {
+private:
+    double celsius;
+
+public:
+    Temperature(double c) : celsius(c) {}
+
+    double getCelsius() const { return celsius; }
+    double getFahrenheit() const { return celsius * 9.0 / 5.0 + 32.0; }
+    void setCelsius(double c) { celsius = c; }
+};
+
+bool close(double a, double b, double relative) {
+    return std::abs(a - b) <= relative * std::max(1.0, std::abs(b));
+}
+
+// Stats recomputed the plain way, to check the kernel's single pass. Float sums
+// are rounded per block, so their mean is only float-accurate.
+template <typename T>
+bool sameStats(const std::vector<T>& values, const TemperatureStats& s) {
+    TemperatureStats expected;
+    double lo = expected.min, hi = expected.max, sum = 0;
+    for (T v : values) {
+        lo = std::min(lo, static_cast<double>(v));
+        hi = std::max(hi, static_cast<double>(v));
+        sum += v;
+    }
+    return s.count == values.size() && s.min == lo && s.max == hi &&
+           (values.empty() || close(s.mean(), sum / values.size(), sizeof(T) == 4 ? 1e-6 : 1e-12));
+}
+
+// Every unit pair, lengths around the SIMD widths (tails), in place and not
+bool checkConversions() {
+    const TemperatureUnit units[] = {TemperatureUnit::Celsius, TemperatureUnit::Fahrenheit,
+                                     TemperatureUnit::Kelvin};
+    auto scalar = [](double x, TemperatureUnit from, TemperatureUnit to) {
+        double c = from == TemperatureUnit::Fahrenheit ? (x - 32.0) * 5.0 / 9.0
+                   : from == TemperatureUnit::Kelvin   ? x - 273.15
+                                                       : x;
+        return to == TemperatureUnit::Fahrenheit ? c * 9.0 / 5.0 + 32.0 : to == TemperatureUnit::Kelvin ? c + 273.15 : c;
+    };
+    bool ok = true;
+    for (size_t n = 0; n <= 37; ++n) {
+        std::vector<double> in(n), out(n);
+        std::vector<float> inF(n), outF(n);
+        for (size_t i = 0; i < n; ++i) {
+            in[i] = -40.0 + 7.3 * static_cast<double>(i);
+            inF[i] = static_cast<float>(in[i]);
+        }
+        for (TemperatureUnit from : units) {
+            for (TemperatureUnit to : units) {
+                TemperatureStats s = convertTemperatures(in, out, from, to);
+                TemperatureStats sF = convertTemperatures(inF, outF, from, to);
+                ok = ok && sameStats(out, s) && sameStats(outF, sF);
+                for (size_t i = 0; i < n; ++i) {
+                    double expected = scalar(in[i], from, to);
+                    // The float path rounds around the offset too (32 or 273.15)
+                    ok = ok && close(out[i], expected, 1e-12) && close(outF[i], expected, 1e-5);
+                }
+                std::vector<double> inPlace = in;
+                convertTemperatures(inPlace, inPlace, from, to);
+                ok = ok && inPlace == out;
+            }
+        }
+    }
+    TemperatureSeries series(TemperatureUnit::Celsius);
+    series.append(std::vector<float>{-40.0f, 0.0f, 100.0f});
+    TemperatureStats s = series.convertTo(TemperatureUnit::Fahrenheit);
+    ok = ok && series.unit() == TemperatureUnit::Fahrenheit && close(series[0], -40.0, 1e-6) &&
+         close(series[1], 32.0, 1e-6) && close(series[2], 212.0, 1e-6) && close(s.mean(), 68.0, 1e-6);
+    s = series.convertTo(TemperatureUnit::Kelvin);
+    ok = ok && close(s.min, 233.15, 1e-6) && close(s.max, 373.15, 1e-6);
+    std::printf("All unit pairs, lengths 0-37, in place and float: %s\n\n", ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+void row(const char* name, double ns, size_t n, double baselineNs, const TemperatureStats& s, bool same) {
+    std::printf("  %-36s %8.2f ms %9.0f M/s %6.1fx   min %.2f max %.2f mean %.4f%s\n", name, ns / 1e6,
+                n / ns * 1e3, baselineNs / ns, s.min, s.max, s.mean(), same ? "" : "   MISMATCH");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = std::max<size_t>(1, bench::argOr(argc, argv, 1, 4000000));
+    bool ok = checkConversions();
+
+    std::mt19937 rng(11);
+    std::normal_distribution<double> noise(0.0, 0.5);
+    std::vector<Temperature> objects;
+    std::vector<double> celsius(n);
+    std::vector<float> celsiusF(n);
+    objects.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        celsius[i] = 18.0 + 6.0 * std::sin(static_cast<double>(i) * 1e-4) + noise(rng);  // A day of readings
+        celsiusF[i] = static_cast<float>(celsius[i]);
+        objects.emplace_back(celsius[i]);
+    }
+
+    std::printf("=== Celsius -> Fahrenheit with min/max/mean, %zu readings, %s kernels ===\n\n", n,
+                temperature_simd::Pack<double>::name);
+
+    std::vector<double> fahrenheit(n), fromObjects(n);
+    TemperatureStats objectStats;
+    double objectsNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < n; ++i) fromObjects[i] = objects[i].getFahrenheit();
+        objectStats = TemperatureStats();
+        objectStats.count = n;
+        for (double f : fromObjects) {
+            objectStats.min = std::min(objectStats.min, f);
+            objectStats.max = std::max(objectStats.max, f);
+            objectStats.sum += f;
+        }
+        bench::doNotOptimize(objectStats);
+    }, 5);
+    row("Temperature::getFahrenheit + pass", objectsNs, n, objectsNs, objectStats, true);
+
+    TemperatureStats stats;
+    double doubleNs = bench::bestOfNs([&] {
+        stats = convertTemperatures(celsius, fahrenheit, TemperatureUnit::Celsius, TemperatureUnit::Fahrenheit);
+        bench::doNotOptimize(stats);
+    }, 5);
+    bool same = sameStats(fahrenheit, stats);
+    for (size_t i = 0; i < n && same; ++i) same = close(fahrenheit[i], fromObjects[i], 1e-12);
+    row("convertTemperatures, double", doubleNs, n, objectsNs, stats, same);
+    ok = ok && same;
+
+    std::vector<float> fahrenheitF(n);
+    double floatNs = bench::bestOfNs([&] {
+        stats = convertTemperatures(celsiusF, fahrenheitF, TemperatureUnit::Celsius, TemperatureUnit::Fahrenheit);
+        bench::doNotOptimize(stats);
+    }, 5);
+    same = sameStats(fahrenheitF, stats) && close(stats.mean(), objectStats.mean(), 1e-6);
+    for (size_t i = 0; i < n && same; ++i) same = close(fahrenheitF[i], fromObjects[i], 1e-6);
+    row("convertTemperatures, float", floatNs, n, objectsNs, stats, same);
+    ok = ok && same;
+
+    // In place: alternate directions so the readings stay in range
+    TemperatureSeries series(celsiusF, TemperatureUnit::Celsius);
+    TemperatureStats back;
+    double seriesNs = bench::bestOfNs([&] {
+        stats = series.convertTo(TemperatureUnit::Fahrenheit);
+        back = series.convertTo(TemperatureUnit::Celsius);
+        bench::doNotOptimize(back);
+    }, 5) / 2;
+    same = close(stats.mean(), objectStats.mean(), 1e-5) &&
+           close(back.mean(), (objectStats.mean() - 32.0) * 5.0 / 9.0, 1e-5);
+    row("TemperatureSeries::convertTo", seriesNs, n, objectsNs, stats, same);
+    ok = ok && same;
+
+    double statsNs = bench::bestOfNs([&] {
+        stats = series.stats();
+        bench::doNotOptimize(stats);
+    }, 5);
+    std::vector<float> current(series.values().begin(), series.values().end());
+    same = sameStats(current, stats);
+    row("TemperatureSeries::stats (no convert)", statsNs, n, objectsNs, stats, same);
+    return ok && same ? 0 : 1;
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+// Columnar temperature readings with bulk unit conversion.
+//
+// Temperature in example.cpp holds one double and converts it one call at a
+// time. Converting a million sensor readings that way means a million calls,
+// and statistics need another pass over the results. TemperatureSeries keeps
+// the readings in one contiguous array; conversion is a single SIMD pass
+// that also returns min, max and mean of the converted values:
+//
+//     TemperatureSeries series(TemperatureUnit::Celsius);
+//     series.append(readings);                               // Span<const float>
+//     TemperatureStats s = series.convertTo(TemperatureUnit::Kelvin);   // In place
+//     std::printf("%.2f..%.2f K, mean %.2f\n", s.min, s.max, s.mean());
+//
+//     // Or directly on caller-owned arrays, float or double:
+//     convertTemperatures(celsius, fahrenheit, TemperatureUnit::Celsius,
+//                         TemperatureUnit::Fahrenheit);
+//
+// Every conversion between Celsius, Fahrenheit and Kelvin is
+// out = in * scale + offset. The pair is worked out once per call in double,
+// so the loop is a multiply and an add per value, with no division.
+// Results can differ from c * 9.0 / 5.0 + 32.0 in the last bit.
+//
+// Series readings are float: sensors resolve about 0.01 degree, and at half
+// the bytes per reading twice as many readings fit in cache and memory
+// bandwidth. Float sums are accumulated in blocks and added up in double,
+// so the mean stays accurate over long series. Readings must not be NaN
+// (min and max would be unreliable).
+//
+// The kernel width is chosen at compile time: AVX (-mavx / -march=native),
+// SSE2 (default on x86-64), NEON (AArch64) or plain scalar code. Define
+// TEMPERATURE_SERIES_FORCE_SCALAR to compare against the scalar fallback.
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../common/span.h"
+
+#if !defined(TEMPERATURE_SERIES_FORCE_SCALAR)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TEMPERATURE_SERIES_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEMPERATURE_SERIES_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TEMPERATURE_SERIES_NEON 1
+#endif
+#endif
+
+enum class TemperatureUnit { Celsius, Fahrenheit, Kelvin };
+
+inline const char* unitSymbol(TemperatureUnit unit) {
+    switch (unit) {
+        case TemperatureUnit::Celsius: return "C";
+        case TemperatureUnit::Fahrenheit: return "F";
+        case TemperatureUnit::Kelvin: return "K";
+    }
+    return "?";
+}
+
+struct TemperatureStats {
+    size_t count = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0;
+
+    double mean() const { return count ? sum / static_cast<double>(count) : std::numeric_limits<double>::quiet_NaN(); }
+};
+
+namespace temperature_simd {
+
+// One SIMD register of T plus the handful of operations the kernels need
+template <typename T>
+struct Pack;
+
+#if defined(TEMPERATURE_SERIES_AVX)
+template <>
+struct Pack<float> {
+    static constexpr size_t width = 8;
+    static constexpr const char* name = "AVX";
+    __m256 v;
+    static Pack broadcast(float x) { return {_mm256_set1_ps(x)}; }
+    static Pack load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend Pack min(Pack a, Pack b) { return {_mm256_min_ps(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {_mm256_max_ps(a.v, b.v)}; }
+};
+template <>
+struct Pack<double> {
+    static constexpr size_t width = 4;
+    static constexpr const char* name = "AVX";
+    __m256d v;
+    static Pack broadcast(double x) { return {_mm256_set1_pd(x)}; }
+    static Pack load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {_mm256_mul_pd(a.v, b.v)}; }
+    friend Pack min(Pack a, Pack b) { return {_mm256_min_pd(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {_mm256_max_pd(a.v, b.v)}; }
+};
+#elif defined(TEMPERATURE_SERIES_SSE2)
+template <>
+struct Pack<float> {
+    static constexpr size_t width = 4;
+    static constexpr const char* name = "SSE2";
+    __m128 v;
+    static Pack broadcast(float x) { return {_mm_set1_ps(x)}; }
+    static Pack load(const float* p) { return {_mm_loadu_ps(p)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend Pack min(Pack a, Pack b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {_mm_max_ps(a.v, b.v)}; }
+};
+template <>
+struct Pack<double> {
+    static constexpr size_t width = 2;
+    static constexpr const char* name = "SSE2";
+    __m128d v;
+    static Pack broadcast(double x) { return {_mm_set1_pd(x)}; }
+    static Pack load(const double* p) { return {_mm_loadu_pd(p)}; }
+    void store(double* p) const { _mm_storeu_pd(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {_mm_add_pd(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {_mm_mul_pd(a.v, b.v)}; }
+    friend Pack min(Pack a, Pack b) { return {_mm_min_pd(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {_mm_max_pd(a.v, b.v)}; }
+};
+#elif defined(TEMPERATURE_SERIES_NEON)
+template <>
+struct Pack<float> {
+    static constexpr size_t width = 4;
+    static constexpr const char* name = "NEON";
+    float32x4_t v;
+    static Pack broadcast(float x) { return {vdupq_n_f32(x)}; }
+    static Pack load(const float* p) { return {vld1q_f32(p)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {vaddq_f32(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {vmulq_f32(a.v, b.v)}; }
+    friend Pack min(Pack a, Pack b) { return {vminq_f32(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {vmaxq_f32(a.v, b.v)}; }
+};
+template <>
+struct Pack<double> {
+    static constexpr size_t width = 2;
+    static constexpr const char* name = "NEON";
+    float64x2_t v;
+    static Pack broadcast(double x) { return {vdupq_n_f64(x)}; }
+    static Pack load(const double* p) { return {vld1q_f64(p)}; }
+    void store(double* p) const { vst1q_f64(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {vaddq_f64(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {vmulq_f64(a.v, b.v)}; }
+    friend Pack min(Pack a, Pack b) { return {vminq_f64(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {vmaxq_f64(a.v, b.v)}; }
+};
+#else
+template <typename T>
+struct Pack {
+    static constexpr size_t width = 1;
+    static constexpr const char* name = "scalar";
+    T v;
+    static Pack broadcast(T x) { return {x}; }
+    static Pack load(const T* p) { return {*p}; }
+    void store(T* p) const { *p = v; }
+    friend Pack operator+(Pack a, Pack b) { return {a.v + b.v}; }
+    friend Pack operator*(Pack a, Pack b) { return {a.v * b.v}; }
+    friend Pack min(Pack a, Pack b) { return {std::min(a.v, b.v)}; }
+    friend Pack max(Pack a, Pack b) { return {std::max(a.v, b.v)}; }
+};
+#endif
+
+// out = in * scale + offset
+struct Affine {
+    double scale, offset;
+};
+
+inline Affine toCelsius(TemperatureUnit unit) {
+    switch (unit) {
+        case TemperatureUnit::Fahrenheit: return {5.0 / 9.0, -32.0 * 5.0 / 9.0};
+        case TemperatureUnit::Kelvin: return {1.0, -273.15};
+        case TemperatureUnit::Celsius: break;
+    }
+    return {1.0, 0.0};
+}
+
+inline Affine fromCelsius(TemperatureUnit unit) {
+    switch (unit) {
+        case TemperatureUnit::Fahrenheit: return {9.0 / 5.0, 32.0};
+        case TemperatureUnit::Kelvin: return {1.0, 273.15};
+        case TemperatureUnit::Celsius: break;
+    }
+    return {1.0, 0.0};
+}
+
+// from -> Celsius -> to, folded into one multiply-add
+inline Affine conversion(TemperatureUnit from, TemperatureUnit to) {
+    if (from == to) return {1.0, 0.0};
+    Affine a = toCelsius(from), b = fromCelsius(to);
+    return {a.scale * b.scale, a.offset * b.scale + b.offset};
+}
+
+template <typename T>
+void reduce(const T* values, size_t n, TemperatureStats& stats) {
+    for (size_t i = 0; i < n; ++i) {
+        stats.min = std::min(stats.min, static_cast<double>(values[i]));
+        stats.max = std::max(stats.max, static_cast<double>(values[i]));
+    }
+}
+
+// One pass: out[i] = in[i] * scale + offset (skipped when out is null, for
+// stats only) and min/max/sum of the results. Two registers per step keep
+// the add and min/max latencies from serializing the loop.
+template <typename T>
+TemperatureStats convert(const T* in, T* out, size_t n, Affine affine) {
+    using P = Pack<T>;
+    constexpr size_t kStep = 2 * P::width;
+    constexpr size_t kBlock = 4096;  // Values summed in T before moving into the double total
+
+    const T scale = static_cast<T>(affine.scale), offset = static_cast<T>(affine.offset);
+    const P s = P::broadcast(scale), o = P::broadcast(offset);
+    const bool identity = affine.scale == 1.0 && affine.offset == 0.0;
+    P lo0 = P::broadcast(std::numeric_limits<T>::infinity()), lo1 = lo0;
+    P hi0 = P::broadcast(-std::numeric_limits<T>::infinity()), hi1 = hi0;
+    TemperatureStats stats;
+    stats.count = n;
+
+    size_t i = 0;
+    while (n - i >= kStep) {
+        const size_t blockEnd = i + std::min(kBlock, (n - i) / kStep * kStep);
+        P sum0 = P::broadcast(0), sum1 = sum0;
+        for (; i < blockEnd; i += kStep) {
+            P v0 = P::load(in + i), v1 = P::load(in + i + P::width);
+            if (!identity) {
+                v0 = v0 * s + o;
+                v1 = v1 * s + o;
+            }
+            if (out) {
+                v0.store(out + i);
+                v1.store(out + i + P::width);
+            }
+            lo0 = min(lo0, v0);
+            lo1 = min(lo1, v1);
+            hi0 = max(hi0, v0);
+            hi1 = max(hi1, v1);
+            sum0 = sum0 + v0;
+            sum1 = sum1 + v1;
+        }
+        T lanes[P::width];
+        (sum0 + sum1).store(lanes);
+        for (T lane : lanes) stats.sum += lane;
+    }
+    if (i > 0) {
+        T lanes[P::width];
+        min(lo0, lo1).store(lanes);
+        reduce(lanes, P::width, stats);
+        max(hi0, hi1).store(lanes);
+        reduce(lanes, P::width, stats);
+    }
+    for (; i < n; ++i) {
+        T v = identity ? in[i] : in[i] * scale + offset;
+        if (out) out[i] = v;
+        stats.min = std::min(stats.min, static_cast<double>(v));
+        stats.max = std::max(stats.max, static_cast<double>(v));
+        stats.sum += v;
+    }
+    return stats;
+}
+
+template <typename T>
+TemperatureStats checkedConvert(Span<const T> in, Span<T> out, TemperatureUnit from, TemperatureUnit to) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("convertTemperatures: input and output sizes differ");
+    }
+    return convert(in.data(), out.data(), in.size(), conversion(from, to));
+}
+
+}  // namespace temperature_simd
+
+// out[i] = in[i] converted from `from` to `to`; returns stats of the converted
+// values. `out` may be `in` itself. Throws std::invalid_argument if the sizes differ.
+inline TemperatureStats convertTemperatures(Span<const float> in, Span<float> out, TemperatureUnit from,
+                                            TemperatureUnit to) {
+    return temperature_simd::checkedConvert(in, out, from, to);
+}
+inline TemperatureStats convertTemperatures(Span<const double> in, Span<double> out, TemperatureUnit from,
+                                            TemperatureUnit to) {
+    return temperature_simd::checkedConvert(in, out, from, to);
+}
+
+// min/max/mean without converting
+inline TemperatureStats temperatureStats(Span<const float> values) {
+    return temperature_simd::convert<float>(values.data(), nullptr, values.size(), {1.0, 0.0});
+}
+inline TemperatureStats temperatureStats(Span<const double> values) {
+    return temperature_simd::convert<double>(values.data(), nullptr, values.size(), {1.0, 0.0});
+}
+
+class TemperatureSeries {
+public:
+    explicit TemperatureSeries(TemperatureUnit unit = TemperatureUnit::Celsius) : currentUnit(unit) {}
+    TemperatureSeries(Span<const float> values, TemperatureUnit unit)
+        : readings(values.begin(), values.end()), currentUnit(unit) {}
+
+    TemperatureUnit unit() const { return currentUnit; }
+    size_t size() const { return readings.size(); }
+    bool empty() const { return readings.empty(); }
+    float operator[](size_t i) const { return readings[i]; }
+    Span<const float> values() const { return readings; }
+
+    void reserve(size_t n) { readings.reserve(n); }
+    void add(float reading) { readings.push_back(reading); }
+    void append(Span<const float> values) { readings.insert(readings.end(), values.begin(), values.end()); }
+    void clear() { readings.clear(); }
+
+    // One pass over the readings, in the current unit
+    TemperatureStats stats() const { return temperatureStats(values()); }
+
+    // Converts every reading in place; returns the stats in the new unit
+    TemperatureStats convertTo(TemperatureUnit unit) {
+        TemperatureStats s = temperature_simd::convert(readings.data(), readings.data(), readings.size(),
+                                                       temperature_simd::conversion(currentUnit, unit));
+        currentUnit = unit;
+        return s;
+    }
+
+    // Converted copy into out (same size as the series), series unchanged
+    TemperatureStats convertInto(TemperatureUnit unit, Span<float> out) const {
+        return convertTemperatures(values(), out, currentUnit, unit);
+    }
+
+private:
+    std::vector<float> readings;
+    TemperatureUnit currentUnit;
+};
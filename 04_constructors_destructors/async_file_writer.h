@@ -0,0 +1,270 @@
+#pragma once
+
+// Write-combining output file: the batched counterpart of FileHandler::write().
+//
+// write() only copies bytes into the current buffer of a fixed ring. Full
+// buffers are handed to a background thread that writes every ready buffer in
+// one writev() call (fwrite() on Windows). The caller never waits on the disk
+// unless the whole ring is full, which is the back-pressure point.
+//
+// Durability:
+//   None          - data reaches the OS on flush()/close, no fsync
+//   FsyncOnClose  - one fsync when the writer is destroyed
+//   FsyncEveryN   - fsync whenever `syncEveryBytes` more bytes have been written
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+enum class Durability { None, FsyncOnClose, FsyncEveryN };
+
+struct AsyncWriterOptions {
+    size_t bufferSize = 256 << 10;      // Bytes per ring slot
+    size_t bufferCount = 8;             // Ring slots
+    Durability durability = Durability::None;
+    size_t syncEveryBytes = 64 << 20;   // Used by Durability::FsyncEveryN
+};
+
+class AsyncFileWriter {
+public:
+    explicit AsyncFileWriter(const char* path, AsyncWriterOptions opts = {})
+        : options(sanitize(opts)),
+          ring(options.bufferCount, std::vector<char>(options.bufferSize)),
+          used(options.bufferCount, 0) {
+#if defined(_WIN32)
+        handle = std::fopen(path, "wb");
+        if (handle) std::setvbuf(handle, nullptr, _IONBF, 0);
+        opened = handle != nullptr;
+#else
+        fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        opened = fd >= 0;
+#endif
+        if (opened) {
+            worker = std::thread([this] { drainLoop(); });
+        } else {
+            failed = true;
+        }
+    }
+
+    ~AsyncFileWriter() { close(); }
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    bool isOpen() const { return opened; }
+
+    // Copy text into the ring; blocks only when every slot is waiting on I/O.
+    // Thread-safe: several producers may share one writer.
+    void write(std::string_view text) {
+        if (!opened) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!text.empty()) {
+            waitForFreeSlot(lock);
+            size_t slot = head % ring.size();
+            size_t room = options.bufferSize - used[slot];
+            size_t n = text.size() < room ? text.size() : room;
+            std::memcpy(ring[slot].data() + used[slot], text.data(), n);
+            used[slot] += n;
+            text.remove_prefix(n);
+            if (used[slot] == options.bufferSize) {
+                publish();
+            }
+        }
+    }
+
+    void write(const char* text) { write(std::string_view(text)); }
+
+    // Hand the partially filled buffer to the writer thread and wait until
+    // everything written so far has reached the OS.
+    void flush() {
+        if (!opened) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        waitForFreeSlot(lock);
+        if (used[head % ring.size()] > 0) {
+            publish();
+        }
+        size_t target = head;
+        drainedCv.wait(lock, [&] { return tail >= target; });
+    }
+
+    // Flush, stop the writer thread, fsync (unless Durability::None) and close
+    // the file. True if every write, fsync and the close itself succeeded.
+    // The destructor calls this and drops the result; call it yourself when
+    // durability matters. Must not race with write(); later calls are no-ops.
+    bool close() {
+        if (!opened) return good();
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        readyCv.notify_one();
+        worker.join();
+        bool ok = options.durability == Durability::None || syncToDisk();
+#if defined(_WIN32)
+        ok = std::fclose(handle) == 0 && ok;
+#else
+        ok = ::close(fd) == 0 && ok;
+#endif
+        opened = false;
+        if (!ok) markFailed();
+        return good();
+    }
+
+    size_t bytesWritten() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return totalWritten;
+    }
+
+    // False if the file never opened, or once any write(), fsync() or close
+    // has failed. The buffers of a failed batch are lost; later writes are
+    // still attempted, so check after flush() or close()
+    bool good() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !failed;
+    }
+
+private:
+    AsyncWriterOptions options;
+    std::vector<std::vector<char>> ring;
+    std::vector<size_t> used;           // Filled bytes per slot
+
+    // Slots [tail, head) are full and queued; slot head is being filled, but
+    // only while head - tail < ring.size(), otherwise the writer still owns it.
+    size_t head = 0;
+    size_t tail = 0;
+    size_t totalWritten = 0;
+    size_t sinceSync = 0;
+    bool stopping = false;
+    bool failed = false;
+    bool opened = false;
+
+    mutable std::mutex mutex;
+    std::condition_variable readyCv;    // Producer -> writer: a slot is full
+    std::condition_variable drainedCv;  // Writer -> producers: slots were freed
+    std::thread worker;
+
+#if defined(_WIN32)
+    FILE* handle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    static AsyncWriterOptions sanitize(AsyncWriterOptions opts) {
+        if (opts.bufferSize == 0) opts.bufferSize = 1;
+        if (opts.bufferCount < 2) opts.bufferCount = 2;
+        return opts;
+    }
+
+    // Slot head may alias one the writer thread is still draining. Every
+    // producer waits here before touching it, since another producer may have
+    // published the last free slot while this one was blocked.
+    void waitForFreeSlot(std::unique_lock<std::mutex>& lock) {
+        drainedCv.wait(lock, [&] { return head - tail < ring.size(); });
+    }
+
+    // Queue the current slot; the next one is claimed by waitForFreeSlot()
+    void publish() {  // Caller holds mutex
+        ++head;
+        readyCv.notify_one();
+    }
+
+    void drainLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            readyCv.wait(lock, [&] { return tail < head || stopping; });
+            if (tail == head && stopping) return;
+
+            // Slots [first, last) are owned by this thread until tail advances
+            size_t first = tail;
+            size_t last = head;
+            lock.unlock();
+            size_t bytes = writeSlots(first, last);
+            bool syncFailed = false;
+            if (options.durability == Durability::FsyncEveryN) {
+                sinceSync += bytes;
+                if (sinceSync >= options.syncEveryBytes) {
+                    syncFailed = !syncToDisk();
+                    sinceSync = 0;
+                }
+            }
+            lock.lock();
+
+            for (size_t i = first; i < last; ++i) used[i % ring.size()] = 0;
+            tail = last;
+            totalWritten += bytes;
+            failed = failed || syncFailed;
+            drainedCv.notify_all();
+        }
+    }
+
+    // Write slots [first, last) in as few system calls as possible
+    size_t writeSlots(size_t first, size_t last) {
+        size_t total = 0;
+#if defined(_WIN32)
+        for (size_t i = first; i < last; ++i) {
+            size_t slot = i % ring.size();
+            size_t n = std::fwrite(ring[slot].data(), 1, used[slot], handle);
+            if (n != used[slot]) markFailed();
+            total += n;
+        }
+#else
+        std::vector<iovec> pending;
+        pending.reserve(last - first);
+        for (size_t i = first; i < last; ++i) {
+            size_t slot = i % ring.size();
+            pending.push_back({ring[slot].data(), used[slot]});
+        }
+        size_t index = 0;
+        while (index < pending.size()) {
+            int count = static_cast<int>(std::min<size_t>(pending.size() - index, 1024));
+            ssize_t n = ::writev(fd, &pending[index], count);
+            if (n < 0) {
+                if (errno == EINTR) continue;  // Interrupted before writing anything
+                markFailed();
+                break;
+            }
+            total += static_cast<size_t>(n);
+            // Skip fully written iovecs, trim a partially written one
+            size_t left = static_cast<size_t>(n);
+            while (index < pending.size() && left >= pending[index].iov_len) {
+                left -= pending[index].iov_len;
+                ++index;
+            }
+            if (index < pending.size()) {
+                pending[index].iov_base = static_cast<char*>(pending[index].iov_base) + left;
+                pending[index].iov_len -= left;
+            }
+        }
+#endif
+        return total;
+    }
+
+    bool syncToDisk() {
+#if defined(_WIN32)
+        return _commit(_fileno(handle)) == 0;
+#else
+        return ::fsync(fd) == 0;
+#endif
+    }
+
+    void markFailed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        failed = true;
+    }
+};
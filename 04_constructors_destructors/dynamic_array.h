@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+// Tag for constructors that skip zero-filling. Use it when every element is
+// about to be overwritten anyway (e.g. reading a file straight into the buffer).
+struct UninitializedTag {
+    explicit UninitializedTag() = default;
+};
+inline constexpr UninitializedTag uninitialized{};
+
+// RAII growable int array following the Rule of Five.
+//
+//   - copy constructor/assignment: deep copy (O(n))
+//   - move constructor/assignment: steal the pointer (O(1), noexcept)
+//   - reserve/push_back/resize: geometric growth, amortized O(1) push_back
+//
+// The move operations are noexcept so std::vector<DynamicArray> moves
+// elements on reallocation instead of falling back to deep copies.
+class DynamicArray {
+public:
+    // Lifetime counters so benchmarks and examples can show what happened
+    // without printing from inside the hot path.
+    struct Stats {
+        size_t allocations = 0;
+        size_t deepCopies = 0;
+        size_t moves = 0;
+    };
+
+    DynamicArray() noexcept : data(nullptr), size(0), capacity(0) {}
+
+    // Allocates n zero-filled elements (same behavior as before)
+    explicit DynamicArray(size_t n) : DynamicArray(n, uninitialized) {
+        std::fill(data, data + size, 0);
+    }
+
+    // Allocates n elements without initializing them
+    DynamicArray(size_t n, UninitializedTag)
+        : data(allocate(n)), size(n), capacity(n) {}
+
+    ~DynamicArray() {
+        delete[] data;
+    }
+
+    // Copy constructor (deep copy)
+    DynamicArray(const DynamicArray& other)
+        : data(allocate(other.size)), size(other.size), capacity(other.size) {
+        std::copy(other.data, other.data + size, data);
+        ++stats.deepCopies;
+    }
+
+    // Copy assignment: copy-and-swap gives the strong exception guarantee
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            DynamicArray copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // Move constructor: steal the buffer, leave other empty but valid
+    DynamicArray(DynamicArray&& other) noexcept
+        : data(std::exchange(other.data, nullptr)),
+          size(std::exchange(other.size, 0)),
+          capacity(std::exchange(other.capacity, 0)) {
+        ++stats.moves;
+    }
+
+    // Move assignment
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            delete[] data;
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+            capacity = std::exchange(other.capacity, 0);
+            ++stats.moves;
+        }
+        return *this;
+    }
+
+    void swap(DynamicArray& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+    }
+
+    // Make room for at least n elements; never shrinks
+    void reserve(size_t n) {
+        if (n <= capacity) return;
+        int* fresh = allocate(n);
+        std::copy(data, data + size, fresh);
+        delete[] data;
+        data = fresh;
+        capacity = n;
+    }
+
+    void push_back(int value) {
+        if (size == capacity) {
+            reserve(grownCapacity(size + 1));
+        }
+        data[size++] = value;
+    }
+
+    // Grow (zero-filling new elements) or shrink the logical size
+    void resize(size_t n) {
+        size_t old = size;
+        resize(n, uninitialized);
+        if (n > old) {
+            std::fill(data + old, data + n, 0);
+        }
+    }
+
+    // Grow without touching the new elements
+    void resize(size_t n, UninitializedTag) {
+        if (n > capacity) {
+            reserve(grownCapacity(n));
+        }
+        size = n;
+    }
+
+    void clear() noexcept { size = 0; }
+
+    int& operator[](size_t index) { return data[index]; }
+    const int& operator[](size_t index) const { return data[index]; }
+
+    int* begin() { return data; }
+    int* end() { return data + size; }
+    const int* begin() const { return data; }
+    const int* end() const { return data + size; }
+
+    size_t getSize() const { return size; }
+    size_t getCapacity() const { return capacity; }
+    bool empty() const { return size == 0; }
+
+    static const Stats& getStats() { return stats; }
+    static void resetStats() { stats = Stats{}; }
+
+private:
+    int* data;
+    size_t size;
+    size_t capacity;
+
+    static Stats stats;
+
+    static int* allocate(size_t n) {
+        if (n == 0) return nullptr;
+        ++stats.allocations;
+        return new int[n];  // default-init: no zero fill
+    }
+
+    // Double the capacity (at least to `needed`) so push_back is amortized O(1)
+    size_t grownCapacity(size_t needed) const {
+        return std::max(needed, capacity * 2);
+    }
+};
+
+inline DynamicArray::Stats DynamicArray::stats{};
+
+inline void swap(DynamicArray& a, DynamicArray& b) noexcept {
+    a.swap(b);
+}
@@ -1,7 +1,12 @@
 #include <iostream>
 #include <cstring>
+#include <vector>
+
+#include "dynamic_array.h"
+#include "../common/lifecycle_trace.h"
 
 // Example 1: Basic constructors and destructor
+// (traced into a per-thread buffer rather than flushing std::cout on every event)
 class Demo {
 private:
     int value;
@@ -10,22 +15,22 @@ private:
 public:
     // Default constructor
     Demo() : value(0), name("default") {
-        std::cout << "Default constructor called" << std::endl;
+        LIFECYCLE_EVENT("Demo", Construct, this, value, name);
     }
     
     // Parameterized constructor
     Demo(int v, const std::string& n) : value(v), name(n) {
-        std::cout << "Parameterized constructor: " << name << std::endl;
+        LIFECYCLE_EVENT("Demo", Construct, this, value, name);
     }
     
     // Copy constructor
     Demo(const Demo& other) : value(other.value), name(other.name) {
-        std::cout << "Copy constructor: copying " << name << std::endl;
+        LIFECYCLE_EVENT("Demo", CopyConstruct, this, value, name);
     }
     
     // Destructor
     ~Demo() {
-        std::cout << "Destructor called for " << name << std::endl;
+        LIFECYCLE_EVENT("Demo", Destruct, this, value, name);
     }
     
     void print() const {
@@ -34,36 +39,8 @@ public:
 };
 
 // Example 2: RAII Pattern
-class DynamicArray {
-private:
-    int* data;
-    size_t size;
-    
-public:
-    // Constructor acquires resource
-    DynamicArray(size_t n) : size(n), data(new int[n]) {
-        std::cout << "Allocated array of size " << size << std::endl;
-        for (size_t i = 0; i < size; ++i) {
-            data[i] = 0;
-        }
-    }
-    
-    // Destructor releases resource
-    ~DynamicArray() {
-        std::cout << "Freeing array of size " << size << std::endl;
-        delete[] data;
-    }
-    
-    // Copy constructor (deep copy)
-    DynamicArray(const DynamicArray& other) : size(other.size), data(new int[other.size]) {
-        std::cout << "Deep copying array" << std::endl;
-        std::copy(other.data, other.data + size, data);
-    }
-    
-    int& operator[](size_t index) { return data[index]; }
-    const int& operator[](size_t index) const { return data[index]; }
-    size_t getSize() const { return size; }
-};
+// DynamicArray lives in dynamic_array.h: the constructor acquires the buffer,
+// the destructor frees it, and copy/move follow the Rule of Five.
 
 // Example 3: Constructor delegation
 class Point {
@@ -103,11 +80,13 @@ void takeInteger(Integer i) {
 
 int main() {
     std::cout << "=== Example 1: Constructor/Destructor Calls ===" << std::endl;
+    std::uint64_t mark = lifecycle::now();
     {
         Demo d1;                        // Default constructor
         Demo d2(42, "test");           // Parameterized
         Demo d3 = d2;                  // Copy constructor
     }  // All destructors called here
+    lifecycle::printEvents(std::cout, mark);
     std::cout << std::endl;
     
     std::cout << "=== Example 2: RAII Pattern ===" << std::endl;
@@ -121,6 +100,28 @@ int main() {
         arr2[0] = 99;
         std::cout << "After modifying copy:" << std::endl;
         std::cout << "arr[0] = " << arr[0] << ", arr2[0] = " << arr2[0] << std::endl;
+
+        DynamicArray arr3 = std::move(arr2);  // Move constructor (steals buffer)
+        std::cout << "After move: arr3[0] = " << arr3[0]
+                  << ", arr2 size = " << arr2.getSize() << std::endl;
+
+        // Geometric growth: capacity doubles, so 1000 push_backs need ~10 allocations
+        DynamicArray grown;
+        for (int i = 0; i < 1000; ++i) {
+            grown.push_back(i);
+        }
+        std::cout << "1000 push_backs -> size " << grown.getSize()
+                  << ", capacity " << grown.getCapacity() << std::endl;
+
+        // noexcept move: vector reallocation moves arrays instead of copying them
+        std::vector<DynamicArray> buffers;
+        buffers.push_back(DynamicArray(1000000, uninitialized));  // No zero-fill
+        buffers.push_back(std::move(arr3));
+
+        const DynamicArray::Stats& stats = DynamicArray::getStats();
+        std::cout << "Allocations: " << stats.allocations
+                  << ", deep copies: " << stats.deepCopies
+                  << ", moves: " << stats.moves << std::endl;
     }  // Resources automatically freed
     std::cout << std::endl;
     
@@ -0,0 +1,104 @@
+// Read throughput: FileHandler's fgets loop vs ChunkedReader vs MappedFile.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o file_read_benchmark file_read_benchmark.cpp
+//     ./file_read_benchmark [megabytes] [path]
+//
+// Without a path, a text file of the requested size (default 256 MB) is
+// generated as bench_input.txt and removed afterwards. Pass e.g. 4096 for a
+// multi-GB run. Numbers are for a warm page cache; drop caches between runs
+// (Linux: echo 3 > /proc/sys/vm/drop_caches) to measure the disk instead.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "../common/benchmark.h"
+#include "mapped_file.h"
+
+// The read loop from FileHandler::read() in solution.cpp
+std::string fgetsRead(const char* path) {
+    FILE* handle = std::fopen(path, "r");
+    if (!handle) return "";
+    char buffer[256];
+    std::string result;
+    while (fgets(buffer, sizeof(buffer), handle)) {
+        result += buffer;
+    }
+    std::fclose(handle);
+    return result;
+}
+
+size_t countLines(std::string_view text) {
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+bool writeInput(const char* path, size_t bytes) {
+    FILE* out = std::fopen(path, "wb");
+    if (!out) return false;
+    const char line[] = "2026-01-01T00:00:00Z INFO ingest: accepted record id=1234567 size=512\n";
+    const size_t lineLength = sizeof(line) - 1;
+    std::string block;
+    while (block.size() + lineLength <= (1 << 20)) block += line;
+    for (size_t written = 0; written < bytes; written += block.size()) {
+        std::fwrite(block.data(), 1, block.size(), out);
+    }
+    std::fclose(out);
+    return true;
+}
+
+void report(const char* label, size_t bytes, double ns, size_t lines) {
+    double gbPerSec = static_cast<double>(bytes) / ns;  // bytes/ns == GB/s
+    std::printf("  %-36s %8.3f GB/s   (%zu lines)\n", label, gbPerSec, lines);
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = bench::argOr(argc, argv, 1, 256);
+    bool generated = argc <= 2;
+    const char* path = generated ? "bench_input.txt" : argv[2];
+
+    if (generated && !writeInput(path, megabytes << 20)) {
+        std::printf("Cannot create %s\n", path);
+        return 1;
+    }
+
+    MappedFile probe(path);
+    if (!probe.isOpen()) {
+        std::printf("Cannot open %s\n", path);
+        return 1;
+    }
+    size_t bytes = probe.size();
+    std::printf("=== File Read Benchmark: %s (%.1f MB) ===\n", path, bytes / 1048576.0);
+
+    // Warm the page cache so every method reads from memory
+    bench::doNotOptimize(countLines(probe.view()));
+
+    size_t lines = 0;
+    double ns = bench::bestOfNs([&] {
+        std::string text = fgetsRead(path);
+        lines = countLines(text);
+    }, 3);
+    report("fgets loop (FileHandler::read)", bytes, ns, lines);
+
+    for (size_t block : {64u << 10, 1u << 20, 8u << 20}) {
+        ns = bench::bestOfNs([&] {
+            ChunkedReader reader(path, block);
+            lines = 0;
+            for (std::string_view chunk : reader) {
+                lines += countLines(chunk);
+            }
+        }, 3);
+        std::string label = "ChunkedReader, " + std::to_string(block >> 10) + " KiB blocks";
+        report(label.c_str(), bytes, ns, lines);
+    }
+
+    ns = bench::bestOfNs([&] {
+        MappedFile file(path);
+        lines = countLines(file.view());
+    }, 3);
+    report("MappedFile (map + scan)", bytes, ns, lines);
+
+    if (generated) std::remove(path);
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Cost of logging every constructor/destructor: std::endl vs '\n' vs
+// common/lifecycle_trace.h vs no logging at all.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o lifecycle_trace_benchmark lifecycle_trace_benchmark.cpp
+//     ./lifecycle_trace_benchmark [objects] [threads]      (default: 100000 per thread, 4 threads)
+//
+// Each object logs two events (construct, destruct). The stream variants write
+// to a temporary file through one shared std::ofstream behind a mutex, which
+// is what std::cout does for you; std::endl adds a write() system call per
+// event. Build with -DLIFECYCLE_TRACE=0 to check that the traced row drops to
+// the untraced one.
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/lifecycle_trace.h"
+
+namespace {
+
+const char* kLogPath = "lifecycle_bench.log";
+std::ofstream logFile;
+std::mutex logMutex;
+
+struct Untraced {
+    int id;
+    explicit Untraced(int i) : id(i) {}
+};
+
+struct EndlLogged {
+    int id;
+    explicit EndlLogged(int i) : id(i) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logFile << "Widget " << id << " created" << std::endl;
+    }
+    ~EndlLogged() {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logFile << "Widget " << id << " destroyed" << std::endl;
+    }
+};
+
+struct NewlineLogged {
+    int id;
+    explicit NewlineLogged(int i) : id(i) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logFile << "Widget " << id << " created\n";
+    }
+    ~NewlineLogged() {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logFile << "Widget " << id << " destroyed\n";
+    }
+};
+
+struct Traced {
+    int id;
+    explicit Traced(int i) : id(i) { LIFECYCLE_EVENT("Widget", Construct, this, id); }
+    ~Traced() { LIFECYCLE_EVENT("Widget", Destruct, this, id); }
+};
+
+template <typename T>
+BENCH_NOINLINE void churn(int count) {
+    for (int i = 0; i < count; ++i) {
+        T object(i);
+        bench::doNotOptimize(object);
+    }
+}
+
+// ns per object (two events) with `threads` threads each churning `count` objects
+template <typename T>
+double perObjectNs(int count, int threads) {
+    double ns = bench::bestOfNs([&] {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (int t = 0; t < threads; ++t) pool.emplace_back(churn<T>, count);
+        for (auto& th : pool) th.join();
+        logFile.flush();
+    }, 3);
+    return ns / (static_cast<double>(count) * threads);
+}
+
+template <typename T>
+void row(const char* name, int count, int threads) {
+    double one = perObjectNs<T>(count, 1);
+    double many = perObjectNs<T>(count, threads);
+    std::printf("%-28s %9.1f ns %9.1f ns\n", name, one, many);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int count = static_cast<int>(bench::argOr(argc, argv, 1, 100000));
+    int threads = static_cast<int>(bench::argOr(argc, argv, 2, 4));
+    if (count < 1) count = 1;
+    if (threads < 1) threads = 1;
+
+    logFile.open(kLogPath);
+    if (!logFile) {
+        std::printf("cannot create %s\n", kLogPath);
+        return 1;
+    }
+
+    std::printf("=== Lifecycle Logging Cost (ns per object = 2 events, LIFECYCLE_TRACE=%d) ===\n\n",
+                LIFECYCLE_TRACE);
+    std::printf("%-28s %12s %9d threads\n", "", "1 thread", threads);
+    row<EndlLogged>("stream + std::endl", count, threads);
+    row<NewlineLogged>("stream + '\\n'", count, threads);
+    lifecycle::clear();
+    row<Traced>("LIFECYCLE_EVENT", count, threads);
+    row<Untraced>("no logging", count, threads);
+
+    // Threads that exited passed their rings on, so at most `threads` are in use;
+    // events() merges them in time order
+    std::vector<lifecycle::Record> kept = lifecycle::events();
+    bool ok = kept.size() <= static_cast<size_t>(threads) * lifecycle::detail::kRingCapacity;
+    for (size_t i = 1; i < kept.size(); ++i) {
+        ok = ok && kept[i - 1].timestampNs <= kept[i].timestampNs;
+    }
+    if (LIFECYCLE_TRACE) ok = ok && !kept.empty();
+    std::printf("\nretained %zu events, overwritten %llu%s\n", kept.size(),
+                static_cast<unsigned long long>(lifecycle::droppedEvents()), ok ? "" : "   MISMATCH");
+
+    logFile.close();
+    std::remove(kLogPath);
+    return ok ? 0 : 1;
+}
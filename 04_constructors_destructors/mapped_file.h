@@ -0,0 +1,229 @@
+#pragma once
+
+// High-throughput read paths to complement FileHandler::read() in solution.cpp.
+//
+//   MappedFile     - maps the whole file into memory and exposes it as a
+//                    std::string_view. No copy, no per-line stdio calls; the
+//                    OS pages data in on demand.
+//   ChunkedReader  - streams the file in fixed-size blocks through one reused
+//                    buffer, for files larger than RAM or address space.
+//
+// Both are RAII types: the mapping / FILE* is released in the destructor.
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const char* path) {
+        map(path);
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { steal(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            steal(other);
+        }
+        return *this;
+    }
+
+    // An empty file opens successfully and yields an empty view
+    bool isOpen() const { return opened; }
+    size_t size() const { return length; }
+
+    // Valid for the lifetime of this MappedFile
+    std::string_view view() const {
+        return std::string_view(static_cast<const char*>(address), length);
+    }
+
+private:
+    const void* address = nullptr;
+    size_t length = 0;
+    bool opened = false;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+#if defined(_WIN32)
+    void map(const char* path) {
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            unmap();
+            return;
+        }
+        length = static_cast<size_t>(fileSize.QuadPart);
+        if (length > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+                unmap();
+                return;
+            }
+            address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!address) {
+                unmap();
+                return;
+            }
+        }
+        opened = true;
+    }
+
+    void unmap() {
+        if (address) UnmapViewOfFile(address);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        address = nullptr;
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+        length = 0;
+        opened = false;
+    }
+
+    void steal(MappedFile& other) {
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+        opened = std::exchange(other.opened, false);
+        file = std::exchange(other.file, INVALID_HANDLE_VALUE);
+        mapping = std::exchange(other.mapping, nullptr);
+    }
+#else
+    void map(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return;
+            }
+            ::madvise(mapped, length, MADV_SEQUENTIAL);  // Aggressive read-ahead
+            address = mapped;
+        }
+        ::close(fd);  // The mapping keeps the file alive
+        opened = true;
+    }
+
+    void unmap() {
+        if (address) ::munmap(const_cast<void*>(address), length);
+        address = nullptr;
+        length = 0;
+        opened = false;
+    }
+
+    void steal(MappedFile& other) {
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+        opened = std::exchange(other.opened, false);
+    }
+#endif
+};
+
+class ChunkedReader {
+public:
+    static constexpr size_t kDefaultBlockSize = 1 << 20;  // 1 MiB
+
+    explicit ChunkedReader(const char* path, size_t blockSize = kDefaultBlockSize)
+        : handle(std::fopen(path, "rb")),
+          buffer(new char[blockSize > 0 ? blockSize : 1]),
+          blockSize(blockSize > 0 ? blockSize : 1) {
+        if (handle) {
+            // We already read in big blocks; stdio's own buffer would only add a copy
+            std::setvbuf(handle, nullptr, _IONBF, 0);
+        }
+    }
+
+    ~ChunkedReader() {
+        if (handle) std::fclose(handle);
+    }
+
+    ChunkedReader(const ChunkedReader&) = delete;
+    ChunkedReader& operator=(const ChunkedReader&) = delete;
+
+    bool isOpen() const { return handle != nullptr; }
+    size_t getBlockSize() const { return blockSize; }
+
+    // Next block of up to blockSize bytes; empty at end of file. The view
+    // points into the internal buffer and is invalidated by the next call.
+    std::string_view next() {
+        if (!handle) return {};
+        size_t got = std::fread(buffer.get(), 1, blockSize, handle);
+        return std::string_view(buffer.get(), got);
+    }
+
+    // Input iterator so a file can be consumed with range-for:
+    //     for (std::string_view block : reader) { ... }
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        iterator() = default;
+        explicit iterator(ChunkedReader* reader) : reader(reader) { ++*this; }
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+
+        iterator& operator++() {
+            current = reader->next();
+            if (current.empty()) reader = nullptr;  // Become the end iterator
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return reader == other.reader; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        ChunkedReader* reader = nullptr;
+        std::string_view current;
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+private:
+    FILE* handle;
+    std::unique_ptr<char[]> buffer;
+    size_t blockSize;
+};
@@ -1,6 +1,15 @@
 #include <iostream>
+#include <cerrno>
 #include <cstring>
 #include <cstdio>
+#include <memory>
+#include <system_error>
+
+#include "../common/expected.h"
+#include "../common/lifecycle_trace.h"
+#include "async_file_writer.h"
+#include "mapped_file.h"
+#include "sso_string.h"
 
 // SOLUTION: String class with RAII
 class String {
@@ -11,7 +20,7 @@ private:
 public:
     // Default constructor
     String() : data(nullptr), length(0) {
-        std::cout << "String: default constructor" << std::endl;
+        LIFECYCLE_EVENT("String", Construct, this);
     }
     
     // Constructor from C-string
@@ -24,7 +33,7 @@ public:
             data = nullptr;
             length = 0;
         }
-        std::cout << "String: constructor from \"" << (str ? str : "nullptr") << "\"" << std::endl;
+        LIFECYCLE_EVENT("String", Construct, this, 0, str ? str : "nullptr");
     }
     
     // Copy constructor (deep copy)
@@ -35,12 +44,12 @@ public:
         } else {
             data = nullptr;
         }
-        std::cout << "String: copy constructor" << std::endl;
+        LIFECYCLE_EVENT("String", CopyConstruct, this, 0, c_str());
     }
     
     // Destructor
     ~String() {
-        std::cout << "String: destructor (freeing \"" << (data ? data : "nullptr") << "\")" << std::endl;
+        LIFECYCLE_EVENT("String", Destruct, this, 0, data ? data : "nullptr");
         delete[] data;
     }
     
@@ -56,32 +65,85 @@ class FileHandler {
 private:
     FILE* handle;
     std::string filename;
+    std::unique_ptr<AsyncFileWriter> combined;  // Write-combining mode only
+    bool movedFrom = false;  // Not the same as closed: a failed open has no handle either
     
 public:
     FileHandler(const char* name, const char* mode) : filename(name) {
         handle = fopen(name, mode);
-        if (handle) {
-            std::cout << "FileHandler: opened " << filename << std::endl;
-        } else {
-            std::cout << "FileHandler: failed to open " << filename << std::endl;
+        LIFECYCLE_EVENT("FileHandler", Construct, this, handle ? 0 : -1, filename);  // -1: open failed
+    }
+    
+    // Write-combining mode: the file is created for writing and write() only
+    // copies into a buffer ring that a background thread drains with writev
+    FileHandler(const char* name, AsyncWriterOptions options)
+        : handle(nullptr), filename(name), combined(std::make_unique<AsyncFileWriter>(name, options)) {
+        if (!combined->isOpen()) combined.reset();
+        LIFECYCLE_EVENT("FileHandler", Construct, this, combined ? 0 : -1, filename);
+    }
+    
+    // Same as the constructor, but a failure says why (errno) and there is
+    // no closed FileHandler to forget to check
+    static Expected<FileHandler, std::error_code> open(const char* name, const char* mode) {
+        FILE* f = fopen(name, mode);
+        if (!f) {
+            return makeUnexpected(std::error_code(errno, std::generic_category()));
         }
+        return FileHandler(f, name);
+    }
+    
+    // Move-only: two handlers closing the same FILE* would be a double fclose
+    FileHandler(FileHandler&& other) noexcept
+        : handle(other.handle), filename(std::move(other.filename)), combined(std::move(other.combined)) {
+        other.handle = nullptr;
+        other.movedFrom = true;
+        LIFECYCLE_EVENT("FileHandler", MoveConstruct, this, 0, filename);
     }
+    FileHandler(const FileHandler&) = delete;
+    FileHandler& operator=(const FileHandler&) = delete;
     
     ~FileHandler() {
         if (handle) {
             fclose(handle);
-            std::cout << "FileHandler: closed " << filename << std::endl;
         }
+        LIFECYCLE_EVENT("FileHandler", Destruct, this, 0, movedFrom ? "moved-from" : filename);
     }
     
-    bool isOpen() const { return handle != nullptr; }
+    bool isOpen() const { return handle != nullptr || combined != nullptr; }
+    bool isWriteCombining() const { return combined != nullptr; }
     
     void write(const char* text) {
-        if (handle) {
+        if (combined) {
+            combined->write(text);
+        } else if (handle) {
             fputs(text, handle);
         }
     }
     
+    // Push everything written so far to the OS; false if any write failed
+    bool flush() {
+        if (combined) {
+            combined->flush();
+            return combined->good();
+        }
+        return handle && fflush(handle) == 0;
+    }
+    
+    // Close now instead of in the destructor, to see whether the final
+    // writes (and the fsync, with Durability::FsyncOnClose) succeeded
+    bool close() {
+        bool ok = false;
+        if (combined) {
+            ok = combined->close();
+            combined.reset();
+        } else if (handle) {
+            ok = fclose(handle) == 0;
+            handle = nullptr;
+        }
+        return ok;
+    }
+    
+    // Write-combining handlers are write-only and read nothing
     std::string read() {
         if (!handle) return "";
         char buffer[256];
@@ -91,10 +153,18 @@ public:
         }
         return result;
     }
+    
+private:
+    FileHandler(FILE* f, const char* name) : handle(f), filename(name) {
+        LIFECYCLE_EVENT("FileHandler", Construct, this, 0, filename);
+    }
 };
 
 int main() {
+    // Constructors and destructors record into a per-thread buffer instead
+    // of flushing std::cout; each section prints what it traced at the end
     std::cout << "=== Solution: String Class ===" << std::endl;
+    std::uint64_t mark = lifecycle::now();
     {
         String s1;
         String s2("Hello");
@@ -104,9 +174,25 @@ int main() {
         std::cout << "s2: "; s2.print();
         std::cout << "s3: "; s3.print();
     }  // Destructors called
+    lifecycle::printEvents(std::cout, mark);
+    std::cout << std::endl;
+    
+    std::cout << "=== Bonus: Small-String Optimization ===" << std::endl;
+    {
+        SsoString shortStr("Hi");                          // Fits inline: no new[]
+        SsoString longStr("This one is too long for SSO");  // Heap buffer
+        SsoString moved = std::move(longStr);              // Steals the buffer
+
+        std::cout << "\"" << shortStr << "\" inline: " << std::boolalpha
+                  << shortStr.isInline() << std::endl;
+        std::cout << "\"" << moved << "\" inline: " << moved.isInline()
+                  << ", length " << moved.size() << std::endl;
+        std::cout << "moved-from is empty: " << longStr.empty() << std::endl;
+    }
     std::cout << std::endl;
     
     std::cout << "=== Solution: RAII File Handler ===" << std::endl;
+    mark = lifecycle::now();
     {
         FileHandler file("test.txt", "w");
         if (file.isOpen()) {
@@ -122,5 +208,55 @@ int main() {
         }
     }
     
+    // Many small writes: write-combining mode batches them into a few writev calls
+    {
+        AsyncWriterOptions options;
+        options.durability = Durability::FsyncOnClose;
+        FileHandler log("test_log.txt", options);
+        for (int i = 0; i < 1000; ++i) {
+            log.write("ingest: accepted record\n");
+        }
+        bool ok = log.close();  // Reports the fsync result; the destructor can't
+        std::cout << "Write-combining log of 1000 lines " << (ok ? "saved" : "FAILED") << std::endl;
+        std::remove("test_log.txt");
+    }
+    
+    // Failure as a value: the error says why, no isOpen() check to forget
+    {
+        auto file = FileHandler::open("missing/test.txt", "r");
+        if (!file) {
+            std::cout << "FileHandler::open failed: " << file.error().message() << std::endl;
+        }
+        
+        auto again = FileHandler::open("test.txt", "r");
+        if (again) {
+            std::cout << "Reopened, " << again->read().size() << " bytes" << std::endl;
+        }
+    }
+    lifecycle::printEvents(std::cout, mark);
+    
+    // Same file without copying: the view points straight at the mapped pages
+    {
+        MappedFile mapped("test.txt");
+        if (mapped.isOpen()) {
+            std::cout << "Mapped " << mapped.size() << " bytes, first line: "
+                      << mapped.view().substr(0, mapped.view().find('\n')) << std::endl;
+        }
+        
+        ChunkedReader reader("test.txt", 16);  // Tiny blocks to show streaming
+        size_t blocks = 0;
+        for (std::string_view block : reader) {
+            (void)block;
+            ++blocks;
+        }
+        std::cout << "Streamed in " << blocks << " blocks of up to "
+                  << reader.getBlockSize() << " bytes" << std::endl;
+    }
+    
+#if LIFECYCLE_TRACE
+    if (lifecycle::writeChromeTrace("lifecycle_trace.json")) {
+        std::cout << "\nLifetimes written to lifecycle_trace.json (open in chrome://tracing)" << std::endl;
+    }
+#endif
     return 0;
 }
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+// String with the small-string optimization (SSO).
+//
+// Strings of up to kInlineCapacity characters live in an inline buffer inside
+// the object, so constructing or copying them never touches the heap. Longer
+// strings fall back to a heap buffer that grows geometrically on append.
+// The length is cached, so size() and append() never call strlen.
+//
+// Layout (64-bit): data pointer + length + 16-byte union = 32 bytes,
+// the same footprint as libstdc++'s std::string.
+class SsoString {
+public:
+    static constexpr size_t kInlineCapacity = 15;
+
+    SsoString() noexcept : data(local), length(0) {
+        local[0] = '\0';
+    }
+
+    SsoString(const char* str) : SsoString(str, str ? std::strlen(str) : 0) {}
+
+    SsoString(const char* str, size_t n) : data(local), length(0) {
+        local[0] = '\0';
+        assign(str, n);
+    }
+
+    // Copy constructor: deep copy, but short strings stay inline
+    SsoString(const SsoString& other) : SsoString(other.data, other.length) {}
+
+    // Move constructor: steal the heap buffer, or copy the inline bytes
+    SsoString(SsoString&& other) noexcept : data(local), length(other.length) {
+        if (other.isInline()) {
+            std::memcpy(local, other.local, other.length + 1);
+        } else {
+            data = other.data;
+            heapCapacity = other.heapCapacity;
+            other.data = other.local;
+        }
+        other.length = 0;
+        other.local[0] = '\0';
+    }
+
+    SsoString& operator=(const SsoString& other) {
+        if (this != &other) {
+            assign(other.data, other.length);
+        }
+        return *this;
+    }
+
+    SsoString& operator=(SsoString&& other) noexcept {
+        if (this != &other) {
+            release();
+            length = other.length;
+            if (other.isInline()) {
+                std::memcpy(local, other.local, other.length + 1);
+            } else {
+                data = other.data;
+                heapCapacity = other.heapCapacity;
+                other.data = other.local;
+            }
+            other.length = 0;
+            other.local[0] = '\0';
+        }
+        return *this;
+    }
+
+    ~SsoString() {
+        release();
+    }
+
+    SsoString& append(const char* str, size_t n) {
+        if (length + n > capacity()) {
+            // Build the new buffer before releasing the old one: str may alias it
+            size_t newCapacity = std::max(length + n, capacity() * 2);
+            char* fresh = new char[newCapacity + 1];
+            std::memcpy(fresh, data, length);
+            std::memcpy(fresh + length, str, n);
+            release();
+            data = fresh;
+            heapCapacity = newCapacity;
+        } else if (n) {
+            std::memmove(data + length, str, n);
+        }
+        length += n;
+        data[length] = '\0';
+        return *this;
+    }
+
+    SsoString& operator+=(const SsoString& other) { return append(other.data, other.length); }
+    SsoString& operator+=(const char* str) { return append(str, std::strlen(str)); }
+    SsoString& operator+=(char ch) { return append(&ch, 1); }
+
+    void reserve(size_t n) {
+        if (n > capacity()) grow(n);
+    }
+
+    void clear() noexcept {
+        length = 0;
+        data[0] = '\0';
+    }
+
+    size_t size() const noexcept { return length; }
+    bool empty() const noexcept { return length == 0; }
+    size_t capacity() const noexcept { return isInline() ? kInlineCapacity : heapCapacity; }
+    bool isInline() const noexcept { return data == local; }
+
+    const char* c_str() const noexcept { return data; }
+    char& operator[](size_t index) { return data[index]; }
+    const char& operator[](size_t index) const { return data[index]; }
+
+    void print() const {
+        std::cout << (length ? data : "(empty)") << std::endl;
+    }
+
+    friend bool operator==(const SsoString& a, const SsoString& b) {
+        return a.length == b.length && std::memcmp(a.data, b.data, a.length) == 0;
+    }
+    friend bool operator!=(const SsoString& a, const SsoString& b) { return !(a == b); }
+
+private:
+    char* data;      // Points at `local` or at a heap buffer
+    size_t length;   // Cached, excludes the terminator
+    union {
+        char local[kInlineCapacity + 1];
+        size_t heapCapacity;  // Valid only when !isInline()
+    };
+
+    void assign(const char* str, size_t n) {
+        if (n > capacity()) {
+            // Old contents are not kept: allocate exactly and copy once
+            char* fresh = new char[n + 1];
+            std::memcpy(fresh, str, n);
+            release();
+            data = fresh;
+            heapCapacity = n;
+        } else if (n) {
+            std::memmove(data, str, n);  // str may alias our own buffer
+        }
+        length = n;
+        data[length] = '\0';
+    }
+
+    void grow(size_t newCapacity) {
+        char* fresh = new char[newCapacity + 1];
+        std::memcpy(fresh, data, length + 1);
+        release();
+        data = fresh;
+        heapCapacity = newCapacity;
+    }
+
+    void release() noexcept {
+        if (!isInline()) {
+            delete[] data;
+            data = local;
+        }
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const SsoString& s) {
+    return os.write(s.c_str(), static_cast<std::streamsize>(s.size()));
+}
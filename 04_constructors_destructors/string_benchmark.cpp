@@ -0,0 +1,120 @@
+// Construction / copy / append throughput: naive String vs SsoString vs std::string.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o string_benchmark string_benchmark.cpp
+//     ./string_benchmark [iterations]     (default: 1000000)
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "sso_string.h"
+
+// The String from solution.cpp without its logging: new[] + strlen + strcpy
+// on every construction and copy, no moves, no cached capacity.
+class NaiveString {
+private:
+    char* data;
+    size_t length;
+
+public:
+    NaiveString() : data(nullptr), length(0) {}
+
+    NaiveString(const char* str) {
+        length = strlen(str);
+        data = new char[length + 1];
+        strcpy(data, str);
+    }
+
+    NaiveString(const NaiveString& other) : length(other.length) {
+        if (other.data) {
+            data = new char[length + 1];
+            strcpy(data, other.data);
+        } else {
+            data = nullptr;
+        }
+    }
+
+    ~NaiveString() { delete[] data; }
+
+    // Reallocates on every call, as a first attempt at append usually does
+    NaiveString& operator+=(const char* str) {
+        size_t extra = strlen(str);
+        char* fresh = new char[length + extra + 1];
+        if (data) strcpy(fresh, data);
+        strcpy(fresh + length, str);
+        delete[] data;
+        data = fresh;
+        length += extra;
+        return *this;
+    }
+
+    size_t size() const { return length; }
+    const char* c_str() const { return data ? data : ""; }
+};
+
+// Mostly short strings, like identifiers and keys in real workloads
+const char* kShort[] = {"id", "name", "price", "qty", "user_42", "en-US", "OK", "total"};
+const char* kLong = "a string that is definitely longer than sixteen bytes";
+
+template <typename Str>
+void runSuite(const char* label, size_t iterations) {
+    std::printf("%s\n", label);
+
+    double constructNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            Str s(kShort[i & 7]);
+            bench::doNotOptimize(s);
+        }
+    });
+    bench::printRow("construct short", constructNs / iterations, "ns/op");
+
+    double constructLongNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            Str s(kLong);
+            bench::doNotOptimize(s);
+        }
+    });
+    bench::printRow("construct long", constructLongNs / iterations, "ns/op");
+
+    std::vector<Str> sources;
+    for (const char* word : kShort) sources.emplace_back(word);
+
+    double copyNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            Str copy = sources[i & 7];
+            bench::doNotOptimize(copy);
+        }
+    });
+    bench::printRow("copy short", copyNs / iterations, "ns/op");
+
+    double appendNs = bench::bestOfNs([&] {
+        Str s("");
+        for (size_t i = 0; i < iterations; ++i) {
+            s += "ab";
+        }
+        bench::doNotOptimize(s);
+    }, 1);
+    bench::printRow("append 2 chars", appendNs / iterations, "ns/op");
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = bench::argOr(argc, argv, 1, 1000000);
+    // NaiveString append is O(n^2); cap it so the run finishes
+    size_t naiveIterations = iterations > 100000 ? 100000 : iterations;
+
+    std::printf("=== String Benchmark (%zu iterations) ===\n", iterations);
+    std::printf("sizeof: NaiveString=%zu SsoString=%zu std::string=%zu\n\n",
+                sizeof(NaiveString), sizeof(SsoString), sizeof(std::string));
+
+    if (naiveIterations < iterations) {
+        std::printf("(NaiveString append is quadratic: capped at %zu iterations)\n\n",
+                    naiveIterations);
+    }
+    runSuite<NaiveString>("NaiveString (solution.cpp)", naiveIterations);
+    runSuite<SsoString>("SsoString", iterations);
+    runSuite<std::string>("std::string", iterations);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <iostream>
+
+#include "../common/output_sink.h"
+
+// Example: Complex number class with operator overloading
+class Complex {
+private:
+    double real, imag;
+    
+public:
+    Complex(double r = 0, double i = 0) : real(r), imag(i) {}
+    
+    // Arithmetic operators
+    Complex operator+(const Complex& other) const {
+        return Complex(real + other.real, imag + other.imag);
+    }
+    
+    Complex operator-(const Complex& other) const {
+        return Complex(real - other.real, imag - other.imag);
+    }
+    
+    Complex operator*(const Complex& other) const {
+        return Complex(
+            real * other.real - imag * other.imag,
+            real * other.imag + imag * other.real
+        );
+    }
+    
+    // Compound assignment
+    Complex& operator+=(const Complex& other) {
+        real += other.real;
+        imag += other.imag;
+        return *this;
+    }
+    
+    // Comparison
+    bool operator==(const Complex& other) const {
+        return real == other.real && imag == other.imag;
+    }
+    
+    bool operator!=(const Complex& other) const {
+        return !(*this == other);
+    }
+    
+    // Accessors (used by bulk containers such as ComplexBuffer)
+    double getReal() const { return real; }
+    double getImag() const { return imag; }
+    
+    // Unary operators
+    Complex operator-() const {
+        return Complex(-real, -imag);
+    }
+    
+    // Stream operators (must be non-member!)
+    friend std::ostream& operator<<(std::ostream& os, const Complex& c);
+    friend std::istream& operator>>(std::istream& is, Complex& c);
+    
+    // Same text as operator<<, formatted straight into an OutputSink buffer
+    friend void formatTo(OutputSink& out, const Complex& c);
+};
+
+// Stream operators (non-member)
+inline std::ostream& operator<<(std::ostream& os, const Complex& c) {
+    os << c.real;
+    if (c.imag >= 0) os << "+";
+    os << c.imag << "i";
+    return os;
+}
+
+inline void formatTo(OutputSink& out, const Complex& c) {
+    char* p = out.reserve(2 * OutputSink::kMaxDoubleChars + 2);
+    p = out.format(p, c.real);
+    if (c.imag >= 0) *p++ = '+';
+    p = out.format(p, c.imag);
+    *p++ = 'i';
+    out.commit(p);
+}
+
+inline std::istream& operator>>(std::istream& is, Complex& c) {
+    is >> c.real >> c.imag;
+    return is;
+}
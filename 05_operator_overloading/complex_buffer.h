@@ -0,0 +1,316 @@
+#pragma once
+
+// Structure-of-arrays container for many Complex values.
+//
+// A std::vector<Complex> stores re,im,re,im,... (array of structs), and each
+// operator+/operator* call builds a temporary Complex. ComplexBuffer keeps all
+// real parts in one 64-byte aligned array and all imaginary parts in another,
+// so bulk arithmetic becomes straight-line SIMD over two streams:
+//
+//     ComplexBuffer a(n), b(n), out(n);
+//     multiply(a, b, out);     // out[i] = a[i] * b[i], no temporaries
+//     a += b;
+//
+// The kernel width is chosen at compile time: AVX (-mavx2 / -march=native),
+// SSE2 (default on x86-64), NEON (AArch64) or plain scalar code. Define
+// COMPLEX_BUFFER_FORCE_SCALAR to compare against the scalar fallback.
+// Single elements still go through the ordinary Complex API via get()/set().
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "complex.h"
+
+#if !defined(COMPLEX_BUFFER_FORCE_SCALAR)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define COMPLEX_BUFFER_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COMPLEX_BUFFER_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define COMPLEX_BUFFER_NEON 1
+#endif
+#endif
+
+namespace complex_simd {
+
+// One SIMD register of doubles plus the handful of operations the kernels need
+#if defined(COMPLEX_BUFFER_AVX)
+struct Pack {
+    static constexpr size_t width = 4;
+    static constexpr const char* name = "AVX";
+    __m256d v;
+    static Pack load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend Pack operator-(Pack a, Pack b) { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {_mm256_mul_pd(a.v, b.v)}; }
+};
+#elif defined(COMPLEX_BUFFER_SSE2)
+struct Pack {
+    static constexpr size_t width = 2;
+    static constexpr const char* name = "SSE2";
+    __m128d v;
+    static Pack load(const double* p) { return {_mm_loadu_pd(p)}; }
+    void store(double* p) const { _mm_storeu_pd(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {_mm_add_pd(a.v, b.v)}; }
+    friend Pack operator-(Pack a, Pack b) { return {_mm_sub_pd(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {_mm_mul_pd(a.v, b.v)}; }
+};
+#elif defined(COMPLEX_BUFFER_NEON)
+struct Pack {
+    static constexpr size_t width = 2;
+    static constexpr const char* name = "NEON";
+    float64x2_t v;
+    static Pack load(const double* p) { return {vld1q_f64(p)}; }
+    void store(double* p) const { vst1q_f64(p, v); }
+    friend Pack operator+(Pack a, Pack b) { return {vaddq_f64(a.v, b.v)}; }
+    friend Pack operator-(Pack a, Pack b) { return {vsubq_f64(a.v, b.v)}; }
+    friend Pack operator*(Pack a, Pack b) { return {vmulq_f64(a.v, b.v)}; }
+};
+#else
+struct Pack {
+    static constexpr size_t width = 1;
+    static constexpr const char* name = "scalar";
+    double v;
+    static Pack load(const double* p) { return {*p}; }
+    void store(double* p) const { *p = v; }
+    friend Pack operator+(Pack a, Pack b) { return {a.v + b.v}; }
+    friend Pack operator-(Pack a, Pack b) { return {a.v - b.v}; }
+    friend Pack operator*(Pack a, Pack b) { return {a.v * b.v}; }
+};
+#endif
+
+// Run op over [0, n) one register at a time. op is generic in its argument
+// type, so the same lambda handles the SIMD body (Pack) and the tail (double).
+template <typename Op>
+inline void forEach(size_t n, const double* ar, const double* ai,
+                    const double* br, const double* bi,
+                    double* outR, double* outI, Op op) {
+    size_t i = 0;
+    for (; i + Pack::width <= n; i += Pack::width) {
+        Pack r, im;
+        op(Pack::load(ar + i), Pack::load(ai + i), Pack::load(br + i), Pack::load(bi + i), r, im);
+        r.store(outR + i);
+        im.store(outI + i);
+    }
+    for (; i < n; ++i) {
+        op(ar[i], ai[i], br[i], bi[i], outR[i], outI[i]);
+    }
+}
+
+}  // namespace complex_simd
+
+class ComplexBuffer {
+public:
+    static constexpr size_t kAlignment = 64;  // One cache line, enough for AVX-512
+
+    ComplexBuffer() = default;
+
+    // n values, all 0+0i
+    explicit ComplexBuffer(size_t n) : ComplexBuffer() {
+        resize(n);
+    }
+
+    ComplexBuffer(const ComplexBuffer& other) : ComplexBuffer() {
+        reserve(other.count);
+        std::copy(other.re, other.re + other.count, re);
+        std::copy(other.im, other.im + other.count, im);
+        count = other.count;
+    }
+
+    // Reuses the existing allocation when it is large enough
+    ComplexBuffer& operator=(const ComplexBuffer& other) {
+        if (this != &other) {
+            if (other.count > capacity) {
+                ComplexBuffer copy(other);
+                swap(copy);
+            } else {
+                std::copy(other.re, other.re + other.count, re);
+                std::copy(other.im, other.im + other.count, im);
+                count = other.count;
+            }
+        }
+        return *this;
+    }
+
+    ComplexBuffer(ComplexBuffer&& other) noexcept { swap(other); }
+
+    ComplexBuffer& operator=(ComplexBuffer&& other) noexcept {
+        if (this != &other) {
+            ComplexBuffer dead(std::move(*this));
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~ComplexBuffer() {
+        release(re);
+    }
+
+    void swap(ComplexBuffer& other) noexcept {
+        std::swap(re, other.re);
+        std::swap(im, other.im);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+    }
+
+    void reserve(size_t n) {
+        if (n <= capacity) return;
+        // One allocation holds both streams, each a whole number of cache
+        // lines so the imaginary part is 64-byte aligned too. An odd number of
+        // lines keeps the distance between them off a multiple of 4 KiB, so
+        // re[i] and im[i] never share a page offset (avoids 4K aliasing stalls).
+        size_t lines = (n + kLine - 1) / kLine;
+        if (lines % 2 == 0) ++lines;
+        size_t newCapacity = lines * kLine;
+        double* newRe = allocate(2 * newCapacity);
+        double* newIm = newRe + newCapacity;
+        std::copy(re, re + count, newRe);
+        std::copy(im, im + count, newIm);
+        release(re);
+        re = newRe;
+        im = newIm;
+        capacity = newCapacity;
+    }
+
+    // New elements are 0+0i
+    void resize(size_t n) {
+        if (n > capacity) reserve(std::max(n, capacity * 2));
+        if (n > count) {
+            std::fill(re + count, re + n, 0.0);
+            std::fill(im + count, im + n, 0.0);
+        }
+        count = n;
+    }
+
+    void push_back(const Complex& c) {
+        if (count == capacity) reserve(std::max<size_t>(16, capacity * 2));
+        re[count] = c.getReal();
+        im[count] = c.getImag();
+        ++count;
+    }
+
+    void clear() noexcept { count = 0; }
+
+    // Single-element access through the regular Complex API
+    Complex get(size_t i) const { return Complex(re[i], im[i]); }
+    Complex operator[](size_t i) const { return get(i); }
+    void set(size_t i, const Complex& c) {
+        re[i] = c.getReal();
+        im[i] = c.getImag();
+    }
+
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+
+    // Raw component streams for custom kernels
+    double* real() noexcept { return re; }
+    double* imag() noexcept { return im; }
+    const double* real() const noexcept { return re; }
+    const double* imag() const noexcept { return im; }
+
+    static const char* simdName() { return complex_simd::Pack::name; }
+
+    ComplexBuffer& operator+=(const ComplexBuffer& other);
+
+private:
+    static constexpr size_t kLine = kAlignment / sizeof(double);
+
+    double* re = nullptr;  // Owns the allocation
+    double* im = nullptr;  // Points into the same block
+    size_t count = 0;
+    size_t capacity = 0;
+
+    static double* allocate(size_t n) {
+        return static_cast<double*>(
+            ::operator new(n * sizeof(double), std::align_val_t(kAlignment)));
+    }
+
+    static void release(double* p) noexcept {
+        if (p) ::operator delete(p, std::align_val_t(kAlignment));
+    }
+};
+
+inline void swap(ComplexBuffer& a, ComplexBuffer& b) noexcept {
+    a.swap(b);
+}
+
+namespace complex_simd {
+
+inline void checkSizes(const ComplexBuffer& a, const ComplexBuffer& b, ComplexBuffer& out) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("ComplexBuffer: operand sizes differ");
+    }
+    out.resize(a.size());
+}
+
+}  // namespace complex_simd
+
+// out[i] = a[i] + b[i]. `out` may alias a or b.
+inline void add(const ComplexBuffer& a, const ComplexBuffer& b, ComplexBuffer& out) {
+    complex_simd::checkSizes(a, b, out);
+    complex_simd::forEach(a.size(), a.real(), a.imag(), b.real(), b.imag(), out.real(), out.imag(),
+        [](auto ar, auto ai, auto br, auto bi, auto& r, auto& i) {
+            r = ar + br;
+            i = ai + bi;
+        });
+}
+
+// out[i] = a[i] - b[i]
+inline void subtract(const ComplexBuffer& a, const ComplexBuffer& b, ComplexBuffer& out) {
+    complex_simd::checkSizes(a, b, out);
+    complex_simd::forEach(a.size(), a.real(), a.imag(), b.real(), b.imag(), out.real(), out.imag(),
+        [](auto ar, auto ai, auto br, auto bi, auto& r, auto& i) {
+            r = ar - br;
+            i = ai - bi;
+        });
+}
+
+// out[i] = a[i] * b[i]
+inline void multiply(const ComplexBuffer& a, const ComplexBuffer& b, ComplexBuffer& out) {
+    complex_simd::checkSizes(a, b, out);
+    complex_simd::forEach(a.size(), a.real(), a.imag(), b.real(), b.imag(), out.real(), out.imag(),
+        [](auto ar, auto ai, auto br, auto bi, auto& r, auto& i) {
+            r = ar * br - ai * bi;
+            i = ar * bi + ai * br;
+        });
+}
+
+// out[i] = a[i] * conj(b[i]); the core of correlation and matched filtering
+inline void multiplyConjugate(const ComplexBuffer& a, const ComplexBuffer& b, ComplexBuffer& out) {
+    complex_simd::checkSizes(a, b, out);
+    complex_simd::forEach(a.size(), a.real(), a.imag(), b.real(), b.imag(), out.real(), out.imag(),
+        [](auto ar, auto ai, auto br, auto bi, auto& r, auto& i) {
+            r = ar * br + ai * bi;
+            i = ai * br - ar * bi;
+        });
+}
+
+inline ComplexBuffer& ComplexBuffer::operator+=(const ComplexBuffer& other) {
+    add(*this, other, *this);
+    return *this;
+}
+
+inline ComplexBuffer operator+(const ComplexBuffer& a, const ComplexBuffer& b) {
+    ComplexBuffer out;
+    add(a, b, out);
+    return out;
+}
+
+inline ComplexBuffer operator-(const ComplexBuffer& a, const ComplexBuffer& b) {
+    ComplexBuffer out;
+    subtract(a, b, out);
+    return out;
+}
+
+inline ComplexBuffer operator*(const ComplexBuffer& a, const ComplexBuffer& b) {
+    ComplexBuffer out;
+    multiply(a, b, out);
+    return out;
+}
@@ -0,0 +1,190 @@
+// Ingesting complex numbers from text: operator>> vs parseComplex (from_chars).
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o complex_parse_benchmark complex_parse_benchmark.cpp
+//     ./complex_parse_benchmark [values]      (default: 2000000)
+//
+// A file of "re im" lines (the layout operator>> reads) is generated with
+// OutputSink as complex_parse_bench.txt, memory-mapped with MappedFile from
+// 04_constructors_destructors, and parsed by:
+//   std::ifstream >> Complex        - the file through an fstream
+//   std::istringstream >> Complex   - the text already in memory
+//   parseComplex -> vector<Complex> - the mapped view, no copy
+//   parseComplex -> ComplexBuffer   - same, into SoA storage
+// This is done twice: with full-precision values (up to 17 significant digits,
+// which mostly need from_chars) and with 6-digit values (typical exports,
+// which take the fast path).
+// Every parser must produce bit-identical values. A few malformed inputs then
+// check that errors come back with the right line and column, and random
+// numbers check the fast path against strtod.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../04_constructors_destructors/mapped_file.h"
+#include "../common/benchmark.h"
+#include "../common/output_sink.h"
+#include "complex_parser.h"
+
+namespace {
+
+const char* kPath = "complex_parse_bench.txt";
+
+bool writeInput(size_t n, int precision) {
+    std::FILE* f = std::fopen(kPath, "wb");
+    if (!f) return false;
+    OutputSink out(f);
+    out.precision(precision);
+    for (size_t i = 0; i < n; ++i) {
+        double t = static_cast<double>(i);
+        out << std::sin(t * 0.001) * 1000.0 << ' ' << ((i % 5 == 0) ? t : -t / 7.0) << '\n';
+    }
+    bool ok = out.flush();
+    return std::fclose(f) == 0 && ok;
+}
+
+bool sameValues(const std::vector<Complex>& a, const std::vector<Complex>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+bool sameValues(const std::vector<Complex>& a, const ComplexBuffer& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b.get(i)) return false;
+    }
+    return true;
+}
+
+void row(const char* name, double ms, size_t bytes, size_t values, double baselineMs, bool same) {
+    std::printf("  %-32s %9.1f ms %8.0f MB/s %7.1f M values/s %7.1fx%s\n", name, ms, bytes / ms / 1e3,
+                values / ms / 1e3, baselineMs / ms, same ? "" : "   MISMATCH");
+}
+
+// Expected outcome of parsing one malformed input
+bool expectError(const char* text, size_t line, size_t column, ComplexParseError::Kind kind) {
+    std::vector<Complex> values;
+    auto parsed = parseComplex(text, values);
+    bool ok = !parsed && parsed.error().line == line && parsed.error().column == column &&
+              parsed.error().kind == kind;
+    std::string shown = text;
+    for (char& c : shown) {
+        if (c == '\n') c = '|';
+    }
+    if (parsed) {
+        std::printf("  %-24s parsed %zu values   MISMATCH\n", shown.c_str(), *parsed);
+    } else {
+        std::printf("  %-24s line %zu, column %zu: %s (%zu values before it)%s\n", shown.c_str(),
+                    parsed.error().line, parsed.error().column, parsed.error().message(), values.size(),
+                    ok ? "" : "   MISMATCH");
+    }
+    return ok;
+}
+
+// The four readers on one generated file; false on any mismatch
+bool runDataset(const char* label, size_t n, int precision) {
+    if (!writeInput(n, precision)) {
+        std::printf("cannot write %s\n", kPath);
+        return false;
+    }
+    MappedFile file(kPath);
+    if (!file.isOpen()) {
+        std::printf("cannot map %s\n", kPath);
+        return false;
+    }
+    std::string_view text = file.view();
+    std::string inMemory(text);
+    std::printf("%s: %.1f MB of text\n", label, text.size() / 1e6);
+
+    std::vector<Complex> fromFstream, fromStringstream, fromParser;
+    ComplexBuffer fromParserSoA;
+    bool ok = true;
+
+    double fstreamMs = bench::bestOfMs([&] {
+        fromFstream.clear();
+        std::ifstream in(kPath);
+        Complex c;
+        while (in >> c) fromFstream.push_back(c);
+    }, 3);
+    double sstreamMs = bench::bestOfMs([&] {
+        fromStringstream.clear();
+        std::istringstream in(inMemory);
+        Complex c;
+        while (in >> c) fromStringstream.push_back(c);
+    }, 3);
+    double parserMs = bench::bestOfMs([&] {
+        fromParser.clear();
+        ok = parseComplex(text, fromParser).has_value() && ok;
+    }, 3);
+    double soaMs = bench::bestOfMs([&] {
+        fromParserSoA = ComplexBuffer();
+        ok = parseComplex(text, fromParserSoA).has_value() && ok;
+    }, 3);
+
+    bool sameSstream = sameValues(fromFstream, fromStringstream);
+    bool sameParser = sameValues(fromFstream, fromParser) && fromParser.size() == n;
+    bool sameSoA = sameValues(fromFstream, fromParserSoA);
+    row("std::ifstream >> Complex", fstreamMs, text.size(), n, fstreamMs, true);
+    row("std::istringstream >> Complex", sstreamMs, text.size(), n, fstreamMs, sameSstream);
+    row("parseComplex -> vector<Complex>", parserMs, text.size(), n, fstreamMs, sameParser);
+    row("parseComplex -> ComplexBuffer", soaMs, text.size(), n, fstreamMs, sameSoA);
+    std::printf("\n");
+
+    file = MappedFile();
+    std::remove(kPath);
+    return ok && sameSstream && sameParser && sameSoA;
+}
+
+// Random decimal strings near the fast path's limits, against strtod
+bool checkFastPath(size_t count) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> digitCount(1, 20), exponent(-30, 30), pointAt(0, 20);
+    size_t wrong = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::string s = (rng() & 1) ? "-" : "";
+        int digits = digitCount(rng), point = pointAt(rng);
+        for (int d = 0; d < digits; ++d) {
+            if (d == point) s += '.';
+            s += static_cast<char>('0' + rng() % 10);
+        }
+        if (rng() & 1) s += "e" + std::to_string(exponent(rng));
+        std::vector<Complex> parsed;
+        auto result = parseComplex(s + " 0", parsed);
+        if (!result || parsed[0].getReal() != std::strtod(s.c_str(), nullptr)) ++wrong;
+    }
+    std::printf("  %zu random numbers vs strtod: %zu differ%s\n", count, wrong, wrong ? "   MISMATCH" : "");
+    return wrong == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 2000000);
+    std::printf("=== Parsing %zu complex values, best of 3 ===\n\n", n);
+    bool ok = runDataset("Full precision (shortest round-trip, ~17 digits)", n, 0);
+    ok = runDataset("6 significant digits (%g)", n, 6) && ok;
+
+    std::printf("Other layouts and errors ('|' is a newline):\n");
+    std::vector<Complex> mixed;
+    auto parsed = parseComplex("1.5,-2\n3-4i 5 6;7+0.5i\n", mixed);
+    bool mixedOk = parsed && *parsed == 4 && mixed[0] == Complex(1.5, -2) && mixed[1] == Complex(3, -4) &&
+                   mixed[2] == Complex(5, 6) && mixed[3] == Complex(7, 0.5);
+    ok = ok && mixedOk;
+    std::printf("  %-24s %zu values%s\n", "1.5,-2|3-4i 5 6;7+0.5i|", mixed.size(), mixedOk ? "" : "   MISMATCH");
+    using Kind = ComplexParseError::Kind;
+    ok = expectError("1,2\n3,x\n", 2, 3, Kind::ExpectedNumber) && ok;
+    ok = expectError("1 2\n3 4\n5\n", 3, 2, Kind::ExpectedImaginaryPart) && ok;
+    ok = expectError("1+2i\n3+4j\n", 2, 4, Kind::ExpectedI) && ok;
+    ok = expectError("1 1e999\n", 1, 3, Kind::OutOfRange) && ok;
+    ok = expectError("1.5x 2\n", 1, 4, Kind::ExpectedNumber) && ok;
+    ok = checkFastPath(200000) && ok;
+    return ok ? 0 : 1;
+}
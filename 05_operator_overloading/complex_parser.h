@@ -0,0 +1,263 @@
+#pragma once
+
+// Bulk parsing of complex numbers from a text buffer with std::from_chars.
+//
+//     MappedFile file("samples.csv");                  // 04_constructors_destructors
+//     std::vector<Complex> values;                     // or a ComplexBuffer
+//     auto parsed = parseComplex(file.view(), values);
+//     if (!parsed) {
+//         const ComplexParseError& e = parsed.error();
+//         std::printf("line %zu, column %zu: %s\n", e.line, e.column, e.message());
+//     }
+//
+// operator>>(std::istream&, Complex&) extracts one double at a time through a
+// sentry, the stream's locale and its streambuf. parseComplex walks the whole
+// buffer once: each number goes straight through std::from_chars (no locale,
+// no copy) and is appended to the destination.
+//
+// Accepted forms, mixed freely, separated by spaces, tabs, newlines, commas
+// or semicolons:
+//     1.5 -2          whitespace pair (what operator>> reads)
+//     1.5,-2          CSV
+//     1.5-2i          what operator<< and OutputSink write
+//
+// Numbers with at most 19 digits whose mantissa fits in 53 bits and whose
+// decimal exponent is within +-22 (typical of "%.6f"-style exports) take
+// Clinger's fast path: one exactly rounded multiply or divide. Everything else
+// goes to std::from_chars. Both give the correctly rounded double.
+//
+// A failure stops parsing and reports where: the byte offset, the 1-based line
+// and column, and what was expected. Values before it have already been
+// appended. Line and column are only computed on failure.
+//
+// Before parsing, the newlines are counted with SSE2/NEON to reserve the
+// destination (one value per line is the common layout). Define
+// COMPLEX_PARSER_FORCE_SCALAR to count them with plain code instead.
+
+#include <algorithm>
+#include <bitset>
+#include <cfloat>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "../common/expected.h"
+#include "complex.h"
+#include "complex_buffer.h"
+
+#if !defined(COMPLEX_PARSER_FORCE_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COMPLEX_PARSER_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define COMPLEX_PARSER_NEON 1
+#endif
+#endif
+
+#if !(defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L)
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#define COMPLEX_PARSER_STRTOD 1  // No floating-point from_chars in this library
+#endif
+
+struct ComplexParseError {
+    enum class Kind { ExpectedNumber, ExpectedImaginaryPart, ExpectedI, OutOfRange };
+
+    Kind kind;
+    size_t offset;  // Byte offset of the offending character
+    size_t line;    // 1-based
+    size_t column;  // 1-based, in bytes
+
+    const char* message() const {
+        switch (kind) {
+            case Kind::ExpectedNumber: return "expected a number";
+            case Kind::ExpectedImaginaryPart: return "expected the imaginary part";
+            case Kind::ExpectedI: return "expected 'i' after the imaginary part";
+            case Kind::OutOfRange: return "number out of range for double";
+        }
+        return "parse error";
+    }
+};
+
+namespace complex_parser_detail {
+
+// Count '\n' in text, 16 bytes at a time where SIMD is available
+inline size_t countNewlines(const char* p, size_t n) {
+    size_t count = 0, i = 0;
+#if defined(COMPLEX_PARSER_SSE2)
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl)));
+        count += std::bitset<16>(mask).count();
+    }
+#elif defined(COMPLEX_PARSER_NEON)
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p + i)), nl);
+        count += vaddvq_u8(vshrq_n_u8(eq, 7));  // 0xFF -> 1, at most 16 per chunk
+    }
+#endif
+    for (; i < n; ++i) count += p[i] == '\n';
+    return count;
+}
+
+inline bool isDelimiter(char c) {
+    return c == ' ' || c == ',' || c == '\n' || c == '\t' || c == '\r' || c == ';';
+}
+
+inline const char* skipDelimiters(const char* p, const char* end) {
+    while (p != end && isDelimiter(*p)) ++p;
+    return p;
+}
+
+inline bool isDigit(char c) { return static_cast<unsigned>(c - '0') < 10; }
+
+// Clinger's fast path; nullptr means "not simple, ask from_chars"
+inline const char* parseSimpleDouble(const char* p, const char* end, double& value) {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0  // x87 excess precision would round twice
+    static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    bool negative = p != end && *p == '-';
+    if (negative) ++p;
+    std::uint64_t mantissa = 0;
+    const char* start = p;
+    while (p != end && isDigit(*p)) mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+    std::ptrdiff_t digits = p - start;
+    int exponent = 0;
+    if (p != end && *p == '.') {
+        const char* fraction = ++p;
+        while (p != end && isDigit(*p)) mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+        exponent = -static_cast<int>(p - fraction);
+        digits += p - fraction;
+    }
+    if (digits == 0 || digits > 19) return nullptr;  // 19 digits cannot overflow 64 bits
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        bool negativeExponent = e != end && *e == '-';
+        if (e != end && (*e == '-' || *e == '+')) ++e;
+        if (e != end && isDigit(*e)) {  // Otherwise the 'e' is not part of the number
+            int x = 0;
+            while (e != end && isDigit(*e) && x < 1000) x = x * 10 + (*e++ - '0');
+            if (e != end && isDigit(*e)) return nullptr;
+            exponent += negativeExponent ? -x : x;
+            p = e;
+        }
+    }
+    if (mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) return nullptr;
+    double v = static_cast<double>(mantissa);
+    v = exponent < 0 ? v / kPow10[-exponent] : v * kPow10[exponent];
+    value = negative ? -v : v;
+    return p;
+#else
+    (void)p;
+    (void)end;
+    (void)value;
+    return nullptr;
+#endif
+}
+
+// One double at p; returns the end of the number, or nullptr with `kind` set
+inline const char* parseDouble(const char* p, const char* end, double& value, ComplexParseError::Kind& kind) {
+    if (p != end && *p == '+') {  // from_chars takes '-' but not '+'
+        ++p;
+        if (p != end && (*p == '+' || *p == '-')) {
+            kind = ComplexParseError::Kind::ExpectedNumber;
+            return nullptr;
+        }
+    }
+    if (const char* simple = parseSimpleDouble(p, end, value)) return simple;
+#if defined(COMPLEX_PARSER_STRTOD)
+    char token[64];
+    size_t n = 0;
+    while (p + n != end && n + 1 < sizeof(token) && !isDelimiter(p[n])) ++n;
+    std::memcpy(token, p, n);
+    token[n] = '\0';
+    char* stop = nullptr;  // "1.5-2i" stops at the '-', as from_chars does
+    errno = 0;
+    value = std::strtod(token, &stop);
+    if (stop == token) {
+        kind = ComplexParseError::Kind::ExpectedNumber;
+        return nullptr;
+    }
+    if (errno == ERANGE && (value == HUGE_VAL || value == -HUGE_VAL)) {
+        kind = ComplexParseError::Kind::OutOfRange;
+        return nullptr;
+    }
+    return p + (stop - token);
+#else
+    std::from_chars_result r = std::from_chars(p, end, value);
+    if (r.ec == std::errc::invalid_argument) {
+        kind = ComplexParseError::Kind::ExpectedNumber;
+        return nullptr;
+    }
+    if (r.ec == std::errc::result_out_of_range) {
+        kind = ComplexParseError::Kind::OutOfRange;
+        return nullptr;
+    }
+    return r.ptr;
+#endif
+}
+
+inline ComplexParseError makeError(std::string_view text, const char* at, ComplexParseError::Kind kind) {
+    size_t offset = static_cast<size_t>(at - text.data());
+    size_t lineStart = offset == 0 ? std::string_view::npos : text.rfind('\n', offset - 1);
+    lineStart = lineStart == std::string_view::npos ? 0 : lineStart + 1;
+    return {kind, offset, countNewlines(text.data(), offset) + 1, offset - lineStart + 1};
+}
+
+// The parser proper; append(re, im) receives each value
+template <typename Append>
+Expected<size_t, ComplexParseError> parse(std::string_view text, Append&& append) {
+    using Kind = ComplexParseError::Kind;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    size_t count = 0;
+    Kind kind = Kind::ExpectedNumber;
+
+    for (p = skipDelimiters(p, end); p != end; p = skipDelimiters(p, end)) {
+        double re, im;
+        const char* next = parseDouble(p, end, re, kind);
+        if (!next) return makeUnexpected(makeError(text, p, kind));
+        p = next;
+
+        if (p != end && (*p == '+' || *p == '-')) {  // "re+imi"
+            next = parseDouble(p, end, im, kind);
+            if (!next) return makeUnexpected(makeError(text, p, kind));
+            p = next;
+            if (p == end || *p != 'i') return makeUnexpected(makeError(text, p, Kind::ExpectedI));
+            ++p;
+        } else {  // "re im" or "re,im"
+            const char* gap = p;
+            p = skipDelimiters(p, end);
+            if (p == end) return makeUnexpected(makeError(text, gap, Kind::ExpectedImaginaryPart));
+            if (p == gap) return makeUnexpected(makeError(text, p, Kind::ExpectedNumber));
+            next = parseDouble(p, end, im, kind);
+            if (!next) return makeUnexpected(makeError(text, p, kind));
+            p = next;
+        }
+        if (p != end && !isDelimiter(*p)) return makeUnexpected(makeError(text, p, Kind::ExpectedNumber));
+        append(re, im);
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace complex_parser_detail
+
+// Append every value in text to out; returns how many were appended
+inline Expected<size_t, ComplexParseError> parseComplex(std::string_view text, std::vector<Complex>& out) {
+    out.reserve(out.size() + complex_parser_detail::countNewlines(text.data(), text.size()) + 1);
+    return complex_parser_detail::parse(text, [&out](double re, double im) { out.emplace_back(re, im); });
+}
+
+inline Expected<size_t, ComplexParseError> parseComplex(std::string_view text, ComplexBuffer& out) {
+    out.reserve(out.size() + complex_parser_detail::countNewlines(text.data(), text.size()) + 1);
+    return complex_parser_detail::parse(text, [&out](double re, double im) { out.push_back(Complex(re, im)); });
+}
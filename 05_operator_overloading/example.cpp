@@ -1,108 +1,11 @@
 #include <iostream>
 #include <cmath>
 
-// Example: Complex number class with operator overloading
-class Complex {
-private:
-    double real, imag;
-    
-public:
-    Complex(double r = 0, double i = 0) : real(r), imag(i) {}
-    
-    // Arithmetic operators
-    Complex operator+(const Complex& other) const {
-        return Complex(real + other.real, imag + other.imag);
-    }
-    
-    Complex operator-(const Complex& other) const {
-        return Complex(real - other.real, imag - other.imag);
-    }
-    
-    Complex operator*(const Complex& other) const {
-        return Complex(
-            real * other.real - imag * other.imag,
-            real * other.imag + imag * other.real
-        );
-    }
-    
-    // Compound assignment
-    Complex& operator+=(const Complex& other) {
-        real += other.real;
-        imag += other.imag;
-        return *this;
-    }
-    
-    // Comparison
-    bool operator==(const Complex& other) const {
-        return real == other.real && imag == other.imag;
-    }
-    
-    bool operator!=(const Complex& other) const {
-        return !(*this == other);
-    }
-    
-    // Unary operators
-    Complex operator-() const {
-        return Complex(-real, -imag);
-    }
-    
-    // Stream operators (must be non-member!)
-    friend std::ostream& operator<<(std::ostream& os, const Complex& c);
-    friend std::istream& operator>>(std::istream& is, Complex& c);
-};
-
-// Stream operators (non-member)
-std::ostream& operator<<(std::ostream& os, const Complex& c) {
-    os << c.real;
-    if (c.imag >= 0) os << "+";
-    os << c.imag << "i";
-    return os;
-}
-
-std::istream& operator>>(std::istream& is, Complex& c) {
-    is >> c.real >> c.imag;
-    return is;
-}
-
-// Example: Vector class
-class Vector2D {
-public:
-    double x, y;
-    
-    Vector2D(double x = 0, double y = 0) : x(x), y(y) {}
-    
-    Vector2D operator+(const Vector2D& v) const {
-        return Vector2D(x + v.x, y + v.y);
-    }
-    
-    Vector2D operator*(double scalar) const {
-        return Vector2D(x * scalar, y * scalar);
-    }
-    
-    double operator*(const Vector2D& v) const {  // Dot product
-        return x * v.x + y * v.y;
-    }
-    
-    Vector2D& operator++() {  // Prefix
-        ++x; ++y;
-        return *this;
-    }
-    
-    Vector2D operator++(int) {  // Postfix
-        Vector2D temp = *this;
-        ++(*this);
-        return temp;
-    }
-    
-    friend std::ostream& operator<<(std::ostream& os, const Vector2D& v) {
-        return os << "(" << v.x << ", " << v.y << ")";
-    }
-};
-
-// Non-member operator for scalar * vector
-Vector2D operator*(double scalar, const Vector2D& v) {
-    return v * scalar;
-}
+// Complex and Vector2D live in their own headers so later examples
+// (ComplexBuffer, the benchmarks) can reuse them.
+#include "complex.h"
+#include "complex_buffer.h"
+#include "vector2d.h"
 
 int main() {
     std::cout << "=== Complex Number Operators ===" << std::endl;
@@ -147,6 +50,21 @@ int main() {
     
     Vector2D v7 = ++v1;
     std::cout << "After ++v1: v1 = " << v1 << ", returned = " << v7 << std::endl;
+    std::cout << std::endl;
+    
+    std::cout << "=== Bulk Operators on ComplexBuffer ===" << std::endl;
+    ComplexBuffer signal, carrier;
+    for (int i = 0; i < 4; ++i) {
+        signal.push_back(Complex(i, 1));
+        carrier.push_back(Complex(0, 1));
+    }
+    ComplexBuffer product = signal * carrier;  // One SIMD pass, no per-element temporaries
+    signal += carrier;
+    std::cout << "Kernels: " << ComplexBuffer::simdName() << std::endl;
+    for (size_t i = 0; i < product.size(); ++i) {
+        std::cout << "  signal[" << i << "] = " << signal[i]
+                  << ", product[" << i << "] = " << product[i] << std::endl;
+    }
     
     return 0;
 }
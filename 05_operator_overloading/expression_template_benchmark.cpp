@@ -0,0 +1,131 @@
+// Cost of per-operator array temporaries vs expression-template fusion.
+//
+// Build and run it at both optimization levels:
+//     g++ -std=c++17 -O2 -Wall -Wextra -o et_O2 expression_template_benchmark.cpp && ./et_O2
+//     g++ -std=c++17 -O3 -Wall -Wextra -o et_O3 expression_template_benchmark.cpp && ./et_O3
+//     ./et_O2 [elements]      (default: 2000000)
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "complex.h"
+#include "expression_templates.h"
+#include "vector2d.h"
+
+// The "obvious" array operators: each one returns a freshly filled vector
+namespace eager {
+
+template <typename T>
+std::vector<T> operator+(const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> out(a.size());
+    for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] + b[i];
+    return out;
+}
+
+template <typename T>
+std::vector<T> operator-(const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> out(a.size());
+    for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] - b[i];
+    return out;
+}
+
+template <typename T>
+std::vector<T> operator*(const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> out(a.size());
+    for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] * b[i];
+    return out;
+}
+
+inline std::vector<Vector2D> operator*(const std::vector<Vector2D>& a, double s) {
+    std::vector<Vector2D> out(a.size());
+    for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] * s;
+    return out;
+}
+
+}  // namespace eager
+
+#if defined(__OPTIMIZE__)
+const char* kBuild = "optimized build";
+#else
+const char* kBuild = "UNOPTIMIZED build (-O0): numbers are meaningless";
+#endif
+
+void report(const char* label, double ns, size_t n, double baselineNs) {
+    std::printf("  %-34s %8.3f ns/elem   %5.2fx vs eager\n", label, ns / n, baselineNs / ns);
+}
+
+void benchVector2D(size_t n) {
+    std::printf("Vector2D: out = a + b * 2.0 + c\n");
+    std::vector<Vector2D> a(n), b(n), c(n);
+    et::Array<Vector2D> ea(n), eb(n), ec(n), eout(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = ea[i] = Vector2D(i * 0.5, 1.0);
+        b[i] = eb[i] = Vector2D(1.0, i * 0.25);
+        c[i] = ec[i] = Vector2D(-1.0, 2.0);
+    }
+
+    std::vector<Vector2D> out;
+    double eagerNs = bench::bestOfNs([&] {
+        using namespace eager;
+        out = a + b * 2.0 + c;  // Two temporaries + the result
+        bench::doNotOptimize(out.data());
+    });
+
+    double etNs = bench::bestOfNs([&] {
+        eout = ea + eb * 2.0 + ec;  // One fused loop, no temporaries
+        bench::doNotOptimize(eout[0]);
+    });
+
+    std::vector<Vector2D> manual(n);
+    double manualNs = bench::bestOfNs([&] {
+        for (size_t i = 0; i < n; ++i) {
+            manual[i] = Vector2D(a[i].x + b[i].x * 2.0 + c[i].x, a[i].y + b[i].y * 2.0 + c[i].y);
+        }
+        bench::doNotOptimize(manual.data());
+    });
+
+    report("eager (temporary per operator)", eagerNs, n, eagerNs);
+    report("expression templates", etNs, n, eagerNs);
+    report("hand-written fused loop", manualNs, n, eagerNs);
+    std::printf("  results agree: %s\n\n",
+                (eout[n - 1].x == out[n - 1].x && eout[n - 1].y == out[n - 1].y) ? "yes" : "NO");
+}
+
+void benchComplex(size_t n) {
+    std::printf("Complex: out = a * b + c - d\n");
+    std::vector<Complex> a(n), b(n), c(n), d(n);
+    et::Array<Complex> ea(n), eb(n), ec(n), ed(n), eout(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = ea[i] = Complex(std::sin(i * 0.01), std::cos(i * 0.01));
+        b[i] = eb[i] = Complex(0.5, -0.5);
+        c[i] = ec[i] = Complex(i * 1e-3, 1.0);
+        d[i] = ed[i] = Complex(1.0, i * 1e-3);
+    }
+
+    std::vector<Complex> out;
+    double eagerNs = bench::bestOfNs([&] {
+        using namespace eager;
+        out = a * b + c - d;
+        bench::doNotOptimize(out.data());
+    });
+
+    double etNs = bench::bestOfNs([&] {
+        eout = ea * eb + ec - ed;
+        bench::doNotOptimize(eout[0]);
+    });
+
+    report("eager (temporary per operator)", eagerNs, n, eagerNs);
+    report("expression templates", etNs, n, eagerNs);
+    std::printf("  results agree: %s\n\n", eout[n - 1] == out[n - 1] ? "yes" : "NO");
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 2000000);
+    if (n == 0) n = 1;
+    std::printf("=== Expression Template Benchmark (%zu elements, %s) ===\n\n", n, kBuild);
+    benchVector2D(n);
+    benchComplex(n);
+    return 0;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+// Opt-in expression templates for arrays of Vector2D / Complex.
+//
+// With plain value semantics, an array expression such as
+//     out = a + b * 2.0 + c;
+// written with array-returning operators allocates and fills one whole
+// temporary array per operator (three full passes over memory here).
+//
+// Here the operators build a lightweight expression tree instead, and
+// et::Array::operator= walks it once per element:
+//     for (i...) out[i] = a[i] + b[i] * 2.0 + c[i];
+// Element types keep using their ordinary operators (Vector2D::operator+ etc.),
+// so anything that compiles for one value compiles for the whole array.
+//
+// Expression nodes hold references to their Array leaves: build and assign an
+// expression in one statement, do not store it in an `auto` variable that
+// outlives the arrays it refers to.
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace et {
+
+// CRTP base: everything that can appear in an array expression
+template <typename E>
+struct Expr {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+template <typename T>
+class Array : public Expr<Array<T>> {
+public:
+    using value_type = T;
+
+    Array() = default;
+    explicit Array(size_t n, const T& value = T()) : items(n, value) {}
+    Array(std::initializer_list<T> init) : items(init) {}
+
+    // Evaluate any expression in a single fused loop
+    template <typename E>
+    Array(const Expr<E>& expr) {
+        assign(expr.self());
+    }
+
+    template <typename E>
+    Array& operator=(const Expr<E>& expr) {
+        assign(expr.self());
+        return *this;
+    }
+
+    const T& operator[](size_t i) const { return items[i]; }
+    T& operator[](size_t i) { return items[i]; }
+    size_t size() const { return items.size(); }
+
+    void push_back(const T& value) { items.push_back(value); }
+    void reserve(size_t n) { items.reserve(n); }
+
+    auto begin() { return items.begin(); }
+    auto end() { return items.end(); }
+    auto begin() const { return items.begin(); }
+    auto end() const { return items.end(); }
+
+private:
+    std::vector<T> items;
+
+    template <typename E>
+    void assign(const E& expr) {
+        size_t n = expr.size();
+        // Evaluating into a fresh buffer keeps `a = a + b` style aliasing safe
+        // when sizes change; same-size assignment evaluates in place.
+        if (n != items.size()) {
+            std::vector<T> fresh;
+            fresh.reserve(n);
+            for (size_t i = 0; i < n; ++i) fresh.push_back(expr[i]);
+            items.swap(fresh);
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            items[i] = expr[i];
+        }
+    }
+};
+
+// A scalar broadcast to every index: the 2.0 in `b * 2.0`
+template <typename S>
+struct Scalar : Expr<Scalar<S>> {
+    S value;
+    explicit Scalar(S v) : value(v) {}
+    const S& operator[](size_t) const { return value; }
+};
+
+// Scalars have no length of their own; every other node's size must match
+template <typename E>
+struct IsScalar : std::false_type {};
+template <typename S>
+struct IsScalar<Scalar<S>> : std::true_type {};
+
+// Leaves are held by reference, interior nodes (small structs) by value
+template <typename E>
+struct Stored {
+    using type = E;
+};
+template <typename T>
+struct Stored<Array<T>> {
+    using type = const Array<T>&;
+};
+
+template <typename L, typename R, typename Op>
+struct Binary : Expr<Binary<L, R, Op>> {
+    typename Stored<L>::type left;
+    typename Stored<R>::type right;
+
+    static_assert(!(IsScalar<L>::value && IsScalar<R>::value), "et: expression needs an array operand");
+
+    Binary(const L& l, const R& r) : left(l), right(r) {
+        if constexpr (!IsScalar<L>::value && !IsScalar<R>::value) {
+            if (l.size() != r.size()) {
+                throw std::invalid_argument("et: array sizes differ in expression");
+            }
+        }
+    }
+
+    auto operator[](size_t i) const { return Op::apply(left[i], right[i]); }
+    size_t size() const {
+        if constexpr (IsScalar<L>::value) {
+            return right.size();
+        } else {
+            return left.size();
+        }
+    }
+};
+
+template <typename E, typename Op>
+struct Unary : Expr<Unary<E, Op>> {
+    typename Stored<E>::type operand;
+
+    explicit Unary(const E& e) : operand(e) {}
+
+    auto operator[](size_t i) const { return Op::apply(operand[i]); }
+    size_t size() const { return operand.size(); }
+};
+
+struct Plus {
+    template <typename A, typename B>
+    static auto apply(const A& a, const B& b) { return a + b; }
+};
+struct Minus {
+    template <typename A, typename B>
+    static auto apply(const A& a, const B& b) { return a - b; }
+};
+struct Times {
+    template <typename A, typename B>
+    static auto apply(const A& a, const B& b) { return a * b; }
+};
+struct Negate {
+    template <typename A>
+    static auto apply(const A& a) { return -a; }
+};
+
+template <typename L, typename R>
+Binary<L, R, Plus> operator+(const Expr<L>& l, const Expr<R>& r) {
+    return Binary<L, R, Plus>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+Binary<L, R, Minus> operator-(const Expr<L>& l, const Expr<R>& r) {
+    return Binary<L, R, Minus>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+Binary<L, R, Times> operator*(const Expr<L>& l, const Expr<R>& r) {
+    return Binary<L, R, Times>(l.self(), r.self());
+}
+
+template <typename E>
+Unary<E, Negate> operator-(const Expr<E>& e) {
+    return Unary<E, Negate>(e.self());
+}
+
+// Scalar on either side: `b * 2.0`, `2.0 * b`
+template <typename L, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+Binary<L, Scalar<S>, Times> operator*(const Expr<L>& l, S s) {
+    return Binary<L, Scalar<S>, Times>(l.self(), Scalar<S>(s));
+}
+
+template <typename S, typename R, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+Binary<Scalar<S>, R, Times> operator*(S s, const Expr<R>& r) {
+    return Binary<Scalar<S>, R, Times>(Scalar<S>(s), r.self());
+}
+
+}  // namespace et
@@ -0,0 +1,181 @@
+// Bulk text export: std::cout (with and without sync_with_stdio) vs OutputSink.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o output_benchmark output_benchmark.cpp
+//     ./output_benchmark [lines] [path]      (default: 1000000 lines, output_bench.txt)
+//
+// Every variant writes the same `lines` lines of "(x, y) re+imi" (a Vector2D
+// and a Complex) to stdout, which is redirected to `path` (e.g. /dev/null to
+// take the disk out). Results go to stderr. Before timing, OutputSink with
+// precision(6) is checked to produce byte-for-byte what operator<< produces,
+// and the default shortest form to read back to the exact values.
+//
+// The variants run in this order because sync_with_stdio(false) cannot be
+// undone: std::endl, '\n', fprintf, then the unsynchronized stream, then the
+// two OutputSink formats.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/output_sink.h"
+#include "complex.h"
+#include "vector2d.h"
+
+namespace {
+
+constexpr size_t kBlock = 4096;  // Distinct values, cycled so memory stays small
+
+struct Sample {
+    Vector2D v;
+    Complex c;
+};
+
+std::vector<Sample> makeSamples() {
+    std::vector<Sample> s(kBlock);
+    for (size_t i = 0; i < kBlock; ++i) {
+        double t = static_cast<double>(i);
+        // Short and long mantissas, integers, negatives, large and tiny magnitudes
+        s[i].v = Vector2D(std::sin(t * 0.37) * 1000.0, (i % 5 == 0) ? t : -t / 3.0);
+        s[i].c = Complex(std::exp(t * 0.01 - 20.0), std::cos(t) * ((i % 7) ? 1.0 : 1e12));
+    }
+    return s;
+}
+
+template <typename Fn>
+double linesPerSecond(size_t lines, Fn&& body) {
+    auto t0 = bench::Clock::now();
+    body();
+    double s = std::chrono::duration<double>(bench::Clock::now() - t0).count();
+    return lines / s;
+}
+
+std::string readAll(std::FILE* f) {
+    std::string text;
+    std::rewind(f);
+    char chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) text.append(chunk, n);
+    return text;
+}
+
+// OutputSink(precision 6) == operator<<, and the shortest form round-trips
+bool verify(const std::vector<Sample>& samples) {
+    std::ostringstream expected;
+    for (const Sample& s : samples) expected << s.v << ' ' << s.c << '\n';
+
+    std::FILE* tmp = std::tmpfile();
+    if (!tmp) return false;
+    {
+        OutputSink out(tmp, 512);  // Small buffer: exercises the refill path
+        out.precision(6);
+        for (const Sample& s : samples) out << s.v << ' ' << s.c << '\n';
+    }
+    bool same = readAll(tmp) == expected.str();
+    std::fclose(tmp);
+
+    tmp = std::tmpfile();
+    if (!tmp) return false;
+    {
+        OutputSink out(tmp);
+        for (const Sample& s : samples) {
+            out << s.v.x << ' ' << s.v.y << ' ' << s.c.getReal() << ' ' << s.c.getImag() << '\n';
+        }
+    }
+    std::string text = readAll(tmp);
+    std::fclose(tmp);
+    const char* p = text.c_str();
+    bool roundTrip = true;
+    for (const Sample& s : samples) {
+        const double values[] = {s.v.x, s.v.y, s.c.getReal(), s.c.getImag()};
+        for (double value : values) {
+            char* end = nullptr;
+            roundTrip = roundTrip && std::strtod(p, &end) == value;
+            p = end;
+        }
+    }
+
+    std::fprintf(stderr, "precision(6) matches operator<<: %s\n", same ? "yes" : "MISMATCH");
+    std::fprintf(stderr, "shortest form reads back exactly: %s\n\n", roundTrip ? "yes" : "MISMATCH");
+    return same && roundTrip;
+}
+
+void report(const char* name, double rate, double baseline) {
+    std::fprintf(stderr, "  %-34s %12.0f lines/s %8.1fx\n", name, rate, rate / baseline);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t lines = bench::argOr(argc, argv, 1, 1000000);
+    const char* path = argc > 2 ? argv[2] : "output_bench.txt";
+
+    std::vector<Sample> samples = makeSamples();
+    bool ok = verify(samples);
+
+    if (!std::freopen(path, "w", stdout)) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+    std::fprintf(stderr, "=== Text Export, %zu lines of Vector2D + Complex to %s ===\n\n", lines, path);
+
+    double endlRate = linesPerSecond(lines, [&] {
+        for (size_t i = 0; i < lines; ++i) {
+            const Sample& s = samples[i % kBlock];
+            std::cout << s.v << ' ' << s.c << std::endl;
+        }
+    });
+    report("std::cout << ... << std::endl", endlRate, endlRate);
+
+    report("std::cout << ... << '\\n'", linesPerSecond(lines, [&] {
+        for (size_t i = 0; i < lines; ++i) {
+            const Sample& s = samples[i % kBlock];
+            std::cout << s.v << ' ' << s.c << '\n';
+        }
+        std::cout.flush();
+    }), endlRate);
+
+    report("fprintf(\"(%g, %g) %g%+gi\\n\")", linesPerSecond(lines, [&] {
+        for (size_t i = 0; i < lines; ++i) {
+            const Sample& s = samples[i % kBlock];
+            std::fprintf(stdout, "(%g, %g) %g%+gi\n", s.v.x, s.v.y, s.c.getReal(), s.c.getImag());
+        }
+        std::fflush(stdout);
+    }), endlRate);
+
+    std::ios::sync_with_stdio(false);
+    report("sync_with_stdio(false), '\\n'", linesPerSecond(lines, [&] {
+        for (size_t i = 0; i < lines; ++i) {
+            const Sample& s = samples[i % kBlock];
+            std::cout << s.v << ' ' << s.c << '\n';
+        }
+        std::cout.flush();
+    }), endlRate);
+
+    report("OutputSink, precision(6)", linesPerSecond(lines, [&] {
+        OutputSink out(stdout);
+        out.precision(6);
+        for (size_t i = 0; i < lines; ++i) {
+            const Sample& s = samples[i % kBlock];
+            out << s.v << ' ' << s.c << '\n';
+        }
+        ok = out.flush() && ok;
+    }), endlRate);
+
+    report("OutputSink, shortest round-trip", linesPerSecond(lines, [&] {
+        OutputSink out(stdout);
+        for (size_t i = 0; i < lines; ++i) {
+            const Sample& s = samples[i % kBlock];
+            out << s.v << ' ' << s.c << '\n';
+        }
+        ok = out.flush() && ok;
+    }), endlRate);
+
+    std::fclose(stdout);
+    if (argc <= 2) std::remove(path);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <iostream>
+
+#include "../common/output_sink.h"
+
+// Example: Vector class
+class Vector2D {
+public:
+    double x, y;
+    
+    Vector2D(double x = 0, double y = 0) : x(x), y(y) {}
+    
+    Vector2D operator+(const Vector2D& v) const {
+        return Vector2D(x + v.x, y + v.y);
+    }
+    
+    Vector2D operator*(double scalar) const {
+        return Vector2D(x * scalar, y * scalar);
+    }
+    
+    double operator*(const Vector2D& v) const {  // Dot product
+        return x * v.x + y * v.y;
+    }
+    
+    Vector2D& operator++() {  // Prefix
+        ++x; ++y;
+        return *this;
+    }
+    
+    Vector2D operator++(int) {  // Postfix
+        Vector2D temp = *this;
+        ++(*this);
+        return temp;
+    }
+    
+    friend std::ostream& operator<<(std::ostream& os, const Vector2D& v) {
+        return os << "(" << v.x << ", " << v.y << ")";
+    }
+};
+
+// Same text as operator<<, formatted straight into an OutputSink buffer
+inline void formatTo(OutputSink& out, const Vector2D& v) {
+    char* p = out.reserve(2 * OutputSink::kMaxDoubleChars + 4);
+    *p++ = '(';
+    p = out.format(p, v.x);
+    *p++ = ',';
+    *p++ = ' ';
+    p = out.format(p, v.y);
+    *p++ = ')';
+    out.commit(p);
+}
+
+// Non-member operator for scalar * vector
+inline Vector2D operator*(double scalar, const Vector2D& v) {
+    return v * scalar;
+}
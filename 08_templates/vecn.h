@@ -0,0 +1,729 @@
+#pragma once
+
+// VecN<T, N>: Vector2D from 05_operator_overloading for any element type and
+// dimension, plus VecArray<T, N>, a structure-of-arrays container of them.
+//
+//     Vec3f a(1, 2, 3), b(4, 5, 6);
+//     Vec3f c = a + b * 2.0f;            // Component-wise, unrolled at compile time
+//     float d = dot(a, b);               // Also a * b, as with Vector2D
+//     Vec3f n = normalized(cross(a, b));
+//
+//     VecArray<float, 3> points(n);      // xxxx... yyyy... zzzz...
+//     normalize(points);                 // Whole-array SIMD kernels
+//
+// N is a template parameter, so every loop over the components has a
+// constant trip count. The generic implementation expands them with
+// std::index_sequence (no loop at all) and is constexpr.
+//
+// float and int vectors with N = 2, 3, 4 and 8 are register types instead:
+// each operator is one SSE/AVX/NEON instruction (dot products add one
+// horizontal sum). N = 2 uses the low half of a register and stays 8 bytes;
+// N = 3 is padded to 4 lanes, kept at zero, and aligned like N = 4. Padding
+// costs memory (a Vec3f is 16 bytes, not 12) and single-vector SIMD helps
+// little in memory-bound loops, so arrays of many vectors belong in a
+// VecArray, where each component is its own tightly packed stream and the
+// kernels process 4-8 vectors per instruction. Prefer float over double where
+// precision allows: the same bandwidth moves twice as many vectors.
+//
+// The lane width is chosen at compile time: AVX/AVX2 for 8 lanes when enabled
+// (-mavx2 / -march=native), SSE2 on x86-64, NEON on AArch64. On x86 without
+// SSE4.1 the int multiply is emulated with two SSE2 multiplies. Define
+// VECN_FORCE_SCALAR to use the generic code everywhere. The SIMD-backed
+// types are not usable in constant expressions (intrinsics are not constexpr);
+// all other instantiations are.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../common/span.h"
+
+#if !defined(VECN_FORCE_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define VECN_SSE2 1
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define VECN_SSE41 1
+#endif
+#if defined(__AVX__)
+#define VECN_AVX 1
+#endif
+#if defined(__AVX2__)
+#define VECN_AVX2 1
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VECN_NEON 1
+#endif
+#endif
+
+namespace vecn_simd {
+
+// One register of lanes plus the operations VecN and VecArray need. All packs
+// share this interface, so kernels are written once as generic lambdas.
+template <typename T>
+struct Scalar {
+    static constexpr size_t width = 1;
+    T v;
+    static Scalar load(const T* p) { return {*p}; }
+    void store(T* p) const { *p = v; }
+    static Scalar broadcast(T x) { return {x}; }
+    friend Scalar operator+(Scalar a, Scalar b) { return {a.v + b.v}; }
+    friend Scalar operator-(Scalar a, Scalar b) { return {a.v - b.v}; }
+    friend Scalar operator*(Scalar a, Scalar b) { return {a.v * b.v}; }
+    friend Scalar operator/(Scalar a, Scalar b) { return {a.v / b.v}; }
+    Scalar sqrt() const { return {static_cast<T>(std::sqrt(v))}; }
+    T sum() const { return v; }
+};
+
+// Two registers acting as one, for 8 lanes without AVX
+template <typename P>
+struct Doubled {
+    static constexpr size_t width = 2 * P::width;
+    P lo, hi;
+    template <typename T>
+    static Doubled load(const T* p) { return {P::load(p), P::load(p + P::width)}; }
+    template <typename T>
+    void store(T* p) const {
+        lo.store(p);
+        hi.store(p + P::width);
+    }
+    template <typename T>
+    static Doubled broadcast(T x) { return {P::broadcast(x), P::broadcast(x)}; }
+    friend Doubled operator+(Doubled a, Doubled b) { return {a.lo + b.lo, a.hi + b.hi}; }
+    friend Doubled operator-(Doubled a, Doubled b) { return {a.lo - b.lo, a.hi - b.hi}; }
+    friend Doubled operator*(Doubled a, Doubled b) { return {a.lo * b.lo, a.hi * b.hi}; }
+    friend Doubled operator/(Doubled a, Doubled b) { return {a.lo / b.lo, a.hi / b.hi}; }
+    Doubled sqrt() const { return {lo.sqrt(), hi.sqrt()}; }
+    auto sum() const { return (lo + hi).sum(); }
+};
+
+#if defined(VECN_SSE2)
+struct F32x4 {
+    static constexpr size_t width = 4;
+    __m128 v;
+    static F32x4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    static F32x4 broadcast(float x) { return {_mm_set1_ps(x)}; }
+    friend F32x4 operator+(F32x4 a, F32x4 b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend F32x4 operator-(F32x4 a, F32x4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend F32x4 operator*(F32x4 a, F32x4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend F32x4 operator/(F32x4 a, F32x4 b) { return {_mm_div_ps(a.v, b.v)}; }
+    F32x4 sqrt() const { return {_mm_sqrt_ps(v)}; }
+    float sum() const {
+        __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+    }
+};
+
+struct I32x4 {
+    static constexpr size_t width = 4;
+    __m128i v;
+    static I32x4 load(const std::int32_t* p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}; }
+    void store(std::int32_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static I32x4 broadcast(std::int32_t x) { return {_mm_set1_epi32(x)}; }
+    friend I32x4 operator+(I32x4 a, I32x4 b) { return {_mm_add_epi32(a.v, b.v)}; }
+    friend I32x4 operator-(I32x4 a, I32x4 b) { return {_mm_sub_epi32(a.v, b.v)}; }
+    friend I32x4 operator*(I32x4 a, I32x4 b) {
+#if defined(VECN_SSE41)
+        return {_mm_mullo_epi32(a.v, b.v)};
+#else
+        // Lanes 0 and 2, then lanes 1 and 3, as 64-bit products; keep the low halves
+        __m128i even = _mm_mul_epu32(a.v, b.v);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+        return {_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                   _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)))};
+#endif
+    }
+    std::int32_t sum() const {
+        __m128i pairs = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtsi128_si32(_mm_add_epi32(pairs, _mm_shuffle_epi32(pairs, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+};
+
+// Two lanes in the low half of a register: 8-byte loads and stores keep a
+// Vec2f/Vec2i at 8 bytes. The upper lanes are never stored or summed.
+struct F32x2 {
+    static constexpr size_t width = 2;
+    F32x4 r;
+    static F32x2 load(const float* p) { return {{_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)))}}; }
+    void store(float* p) const { _mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(r.v)); }
+    static F32x2 broadcast(float x) { return {F32x4::broadcast(x)}; }
+    friend F32x2 operator+(F32x2 a, F32x2 b) { return {a.r + b.r}; }
+    friend F32x2 operator-(F32x2 a, F32x2 b) { return {a.r - b.r}; }
+    friend F32x2 operator*(F32x2 a, F32x2 b) { return {a.r * b.r}; }
+    friend F32x2 operator/(F32x2 a, F32x2 b) { return {a.r / b.r}; }
+    F32x2 sqrt() const { return {r.sqrt()}; }
+    float sum() const { return _mm_cvtss_f32(_mm_add_ss(r.v, _mm_shuffle_ps(r.v, r.v, 1))); }
+};
+
+struct I32x2 {
+    static constexpr size_t width = 2;
+    I32x4 r;
+    static I32x2 load(const std::int32_t* p) { return {{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))}}; }
+    void store(std::int32_t* p) const { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), r.v); }
+    static I32x2 broadcast(std::int32_t x) { return {I32x4::broadcast(x)}; }
+    friend I32x2 operator+(I32x2 a, I32x2 b) { return {a.r + b.r}; }
+    friend I32x2 operator-(I32x2 a, I32x2 b) { return {a.r - b.r}; }
+    friend I32x2 operator*(I32x2 a, I32x2 b) { return {a.r * b.r}; }
+    std::int32_t sum() const { return _mm_cvtsi128_si32(_mm_add_epi32(r.v, _mm_shuffle_epi32(r.v, 1))); }
+};
+#elif defined(VECN_NEON)
+struct F32x4 {
+    static constexpr size_t width = 4;
+    float32x4_t v;
+    static F32x4 load(const float* p) { return {vld1q_f32(p)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+    static F32x4 broadcast(float x) { return {vdupq_n_f32(x)}; }
+    friend F32x4 operator+(F32x4 a, F32x4 b) { return {vaddq_f32(a.v, b.v)}; }
+    friend F32x4 operator-(F32x4 a, F32x4 b) { return {vsubq_f32(a.v, b.v)}; }
+    friend F32x4 operator*(F32x4 a, F32x4 b) { return {vmulq_f32(a.v, b.v)}; }
+    friend F32x4 operator/(F32x4 a, F32x4 b) { return {vdivq_f32(a.v, b.v)}; }
+    F32x4 sqrt() const { return {vsqrtq_f32(v)}; }
+    float sum() const { return vaddvq_f32(v); }
+};
+
+struct I32x4 {
+    static constexpr size_t width = 4;
+    int32x4_t v;
+    static I32x4 load(const std::int32_t* p) { return {vld1q_s32(p)}; }
+    void store(std::int32_t* p) const { vst1q_s32(p, v); }
+    static I32x4 broadcast(std::int32_t x) { return {vdupq_n_s32(x)}; }
+    friend I32x4 operator+(I32x4 a, I32x4 b) { return {vaddq_s32(a.v, b.v)}; }
+    friend I32x4 operator-(I32x4 a, I32x4 b) { return {vsubq_s32(a.v, b.v)}; }
+    friend I32x4 operator*(I32x4 a, I32x4 b) { return {vmulq_s32(a.v, b.v)}; }
+    std::int32_t sum() const { return vaddvq_s32(v); }
+};
+
+struct F32x2 {
+    static constexpr size_t width = 2;
+    float32x2_t v;
+    static F32x2 load(const float* p) { return {vld1_f32(p)}; }
+    void store(float* p) const { vst1_f32(p, v); }
+    static F32x2 broadcast(float x) { return {vdup_n_f32(x)}; }
+    friend F32x2 operator+(F32x2 a, F32x2 b) { return {vadd_f32(a.v, b.v)}; }
+    friend F32x2 operator-(F32x2 a, F32x2 b) { return {vsub_f32(a.v, b.v)}; }
+    friend F32x2 operator*(F32x2 a, F32x2 b) { return {vmul_f32(a.v, b.v)}; }
+    friend F32x2 operator/(F32x2 a, F32x2 b) { return {vdiv_f32(a.v, b.v)}; }
+    F32x2 sqrt() const { return {vsqrt_f32(v)}; }
+    float sum() const { return vaddv_f32(v); }
+};
+
+struct I32x2 {
+    static constexpr size_t width = 2;
+    int32x2_t v;
+    static I32x2 load(const std::int32_t* p) { return {vld1_s32(p)}; }
+    void store(std::int32_t* p) const { vst1_s32(p, v); }
+    static I32x2 broadcast(std::int32_t x) { return {vdup_n_s32(x)}; }
+    friend I32x2 operator+(I32x2 a, I32x2 b) { return {vadd_s32(a.v, b.v)}; }
+    friend I32x2 operator-(I32x2 a, I32x2 b) { return {vsub_s32(a.v, b.v)}; }
+    friend I32x2 operator*(I32x2 a, I32x2 b) { return {vmul_s32(a.v, b.v)}; }
+    std::int32_t sum() const { return vaddv_s32(v); }
+};
+#endif
+
+#if defined(VECN_AVX)
+struct F32x8 {
+    static constexpr size_t width = 8;
+    __m256 v;
+    static F32x8 load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+    static F32x8 broadcast(float x) { return {_mm256_set1_ps(x)}; }
+    friend F32x8 operator+(F32x8 a, F32x8 b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend F32x8 operator-(F32x8 a, F32x8 b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend F32x8 operator*(F32x8 a, F32x8 b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend F32x8 operator/(F32x8 a, F32x8 b) { return {_mm256_div_ps(a.v, b.v)}; }
+    F32x8 sqrt() const { return {_mm256_sqrt_ps(v)}; }
+    float sum() const {
+        return (F32x4{_mm256_castps256_ps128(v)} + F32x4{_mm256_extractf128_ps(v, 1)}).sum();
+    }
+};
+#endif
+
+#if defined(VECN_AVX2)
+struct I32x8 {
+    static constexpr size_t width = 8;
+    __m256i v;
+    static I32x8 load(const std::int32_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+    void store(std::int32_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static I32x8 broadcast(std::int32_t x) { return {_mm256_set1_epi32(x)}; }
+    friend I32x8 operator+(I32x8 a, I32x8 b) { return {_mm256_add_epi32(a.v, b.v)}; }
+    friend I32x8 operator-(I32x8 a, I32x8 b) { return {_mm256_sub_epi32(a.v, b.v)}; }
+    friend I32x8 operator*(I32x8 a, I32x8 b) { return {_mm256_mullo_epi32(a.v, b.v)}; }
+    std::int32_t sum() const {
+        return (I32x4{_mm256_castsi256_si128(v)} + I32x4{_mm256_extracti128_si256(v, 1)}).sum();
+    }
+};
+#endif
+
+// Pack2<T> / Pack4<T> / Pack8<T>: the 2-, 4- and 8-lane register for T, or void
+template <typename T> struct Pack2Of { using type = void; };
+template <typename T> struct Pack4Of { using type = void; };
+template <typename T> struct Pack8Of { using type = void; };
+#if defined(VECN_SSE2) || defined(VECN_NEON)
+template <> struct Pack2Of<float> { using type = F32x2; };
+template <> struct Pack2Of<std::int32_t> { using type = I32x2; };
+template <> struct Pack4Of<float> { using type = F32x4; };
+template <> struct Pack4Of<std::int32_t> { using type = I32x4; };
+#if defined(VECN_AVX)
+template <> struct Pack8Of<float> { using type = F32x8; };
+#else
+template <> struct Pack8Of<float> { using type = Doubled<F32x4>; };
+#endif
+#if defined(VECN_AVX2)
+template <> struct Pack8Of<std::int32_t> { using type = I32x8; };
+#else
+template <> struct Pack8Of<std::int32_t> { using type = Doubled<I32x4>; };
+#endif
+#endif
+template <typename T> using Pack2 = typename Pack2Of<T>::type;
+template <typename T> using Pack4 = typename Pack4Of<T>::type;
+template <typename T> using Pack8 = typename Pack8Of<T>::type;
+
+// Register layout of VecN<T, N>: Pack is void for the generic implementation
+template <typename T, size_t N>
+struct Layout {
+    using Pack = void;
+    static constexpr size_t lanes = N;
+};
+template <typename T> struct Layout<T, 2> { using Pack = Pack2<T>; static constexpr size_t lanes = 2; };
+template <typename T> struct Layout<T, 3> { using Pack = Pack4<T>; static constexpr size_t lanes = std::is_void_v<Pack> ? 3 : 4; };
+template <typename T> struct Layout<T, 4> { using Pack = Pack4<T>; static constexpr size_t lanes = 4; };
+template <typename T> struct Layout<T, 8> { using Pack = Pack8<T>; static constexpr size_t lanes = 8; };
+
+// Widest pack for VecArray's stream kernels; 8 lanes are two registers
+// without AVX, which also unrolls the loop
+template <typename T>
+using Wide = std::conditional_t<std::is_void_v<Pack8<T>>, Scalar<T>, Pack8<T>>;
+
+}  // namespace vecn_simd
+
+template <typename T, size_t N>
+class VecN {
+    static_assert(N >= 1, "VecN needs at least one component");
+    using Layout = vecn_simd::Layout<T, N>;
+    using Pack = typename Layout::Pack;
+    static constexpr bool kSimd = !std::is_void_v<Pack>;
+    static constexpr size_t kLanes = Layout::lanes;
+
+public:
+    using value_type = T;
+    static constexpr size_t dimension = N;
+
+    constexpr VecN() : v{} {}
+
+    // One value per component: Vec3f(1, 2, 3)
+    template <typename... Ts,
+              typename = std::enable_if_t<sizeof...(Ts) == N && (std::is_convertible_v<Ts, T> && ...)>>
+    constexpr VecN(Ts... components) : v{static_cast<T>(components)...} {}
+
+    // Every component set to `value`
+    static constexpr VecN filled(T value) {
+        return filledImpl(value, std::make_index_sequence<N>{});
+    }
+
+    template <typename U>
+    constexpr explicit VecN(const VecN<U, N>& other) : VecN(convertImpl(other, std::make_index_sequence<N>{})) {}
+
+    constexpr T& operator[](size_t i) { return v[i]; }
+    constexpr const T& operator[](size_t i) const { return v[i]; }
+    constexpr T* data() { return v; }
+    constexpr const T* data() const { return v; }
+    static constexpr size_t size() { return N; }
+
+    constexpr T x() const { return v[0]; }
+    constexpr T y() const { static_assert(N >= 2, "VecN::y() needs N >= 2"); return v[1]; }
+    constexpr T z() const { static_assert(N >= 3, "VecN::z() needs N >= 3"); return v[2]; }
+    constexpr T w() const { static_assert(N >= 4, "VecN::w() needs N >= 4"); return v[3]; }
+
+    friend constexpr VecN operator+(const VecN& a, const VecN& b) {
+        if constexpr (kSimd) return fromPack(a.pack() + b.pack());
+        else return zip(a, b, [](T l, T r) { return l + r; }, std::make_index_sequence<N>{});
+    }
+
+    friend constexpr VecN operator-(const VecN& a, const VecN& b) {
+        if constexpr (kSimd) return fromPack(a.pack() - b.pack());
+        else return zip(a, b, [](T l, T r) { return l - r; }, std::make_index_sequence<N>{});
+    }
+
+    friend constexpr VecN operator-(const VecN& a) { return VecN() - a; }
+
+    friend constexpr VecN operator*(const VecN& a, T scalar) {
+        if constexpr (kSimd && std::is_floating_point_v<T>) {
+            VecN r = fromPack(a.pack() * Pack::broadcast(scalar));
+            r.clearPadding();  // 0 * inf would leave NaN in the padding
+            return r;
+        } else if constexpr (kSimd) {
+            return fromPack(a.pack() * Pack::broadcast(scalar));
+        } else {
+            return zip(a, a, [scalar](T l, T) { return l * scalar; }, std::make_index_sequence<N>{});
+        }
+    }
+
+    friend constexpr VecN operator*(T scalar, const VecN& a) { return a * scalar; }
+
+    friend constexpr VecN operator/(const VecN& a, T scalar) {
+        if constexpr (kSimd && std::is_floating_point_v<T>) {
+            VecN r = fromPack(a.pack() / Pack::broadcast(scalar));
+            r.clearPadding();  // 0 / 0 would leave NaN in the padding
+            return r;
+        } else {
+            return zip(a, a, [scalar](T l, T) { return l / scalar; }, std::make_index_sequence<N>{});
+        }
+    }
+
+    friend constexpr T operator*(const VecN& a, const VecN& b) { return dot(a, b); }  // As in Vector2D
+
+    constexpr VecN& operator+=(const VecN& o) { return *this = *this + o; }
+    constexpr VecN& operator-=(const VecN& o) { return *this = *this - o; }
+    constexpr VecN& operator*=(T scalar) { return *this = *this * scalar; }
+    constexpr VecN& operator/=(T scalar) { return *this = *this / scalar; }
+
+    friend constexpr bool operator==(const VecN& a, const VecN& b) {
+        return equalImpl(a, b, std::make_index_sequence<N>{});
+    }
+    friend constexpr bool operator!=(const VecN& a, const VecN& b) { return !(a == b); }
+
+    friend constexpr T dot(const VecN& a, const VecN& b) {
+        if constexpr (kSimd) return (a.pack() * b.pack()).sum();
+        else return dotImpl(a, b, std::make_index_sequence<N>{});
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const VecN& a) {
+        os << "(";
+        for (size_t i = 0; i < N; ++i) os << (i ? ", " : "") << a.v[i];
+        return os << ")";
+    }
+
+private:
+    // Padding lanes (SIMD layouts only) are always zero
+    alignas(kSimd ? kLanes * sizeof(T) : alignof(T)) T v[kLanes];
+
+    template <typename, size_t>
+    friend class VecN;
+
+    Pack pack() const { return Pack::load(v); }
+
+    template <typename P>
+    static VecN fromPack(P p) {
+        VecN r;
+        p.store(r.v);
+        return r;
+    }
+
+    void clearPadding() {
+        for (size_t i = N; i < kLanes; ++i) v[i] = T(0);
+    }
+
+    template <typename F, size_t... I>
+    static constexpr VecN zip(const VecN& a, const VecN& b, F f, std::index_sequence<I...>) {
+        return VecN(f(a.v[I], b.v[I])...);
+    }
+
+    template <size_t... I>
+    static constexpr VecN filledImpl(T value, std::index_sequence<I...>) {
+        return VecN(((void)I, value)...);
+    }
+
+    template <typename U, size_t... I>
+    static constexpr VecN convertImpl(const VecN<U, N>& o, std::index_sequence<I...>) {
+        return VecN(static_cast<T>(o.v[I])...);
+    }
+
+    template <size_t... I>
+    static constexpr bool equalImpl(const VecN& a, const VecN& b, std::index_sequence<I...>) {
+        return ((a.v[I] == b.v[I]) && ...);
+    }
+
+    template <size_t... I>
+    static constexpr T dotImpl(const VecN& a, const VecN& b, std::index_sequence<I...>) {
+        return ((a.v[I] * b.v[I]) + ...);
+    }
+};
+
+using Vec2f = VecN<float, 2>;
+using Vec3f = VecN<float, 3>;
+using Vec4f = VecN<float, 4>;
+using Vec8f = VecN<float, 8>;
+using Vec2i = VecN<std::int32_t, 2>;
+using Vec3i = VecN<std::int32_t, 3>;
+using Vec4i = VecN<std::int32_t, 4>;
+using Vec2d = VecN<double, 2>;  // Same values as Vector2D
+using Vec3d = VecN<double, 3>;
+
+template <typename T, size_t N>
+constexpr T lengthSquared(const VecN<T, N>& a) {
+    return dot(a, a);
+}
+
+// double for integer vectors, T otherwise
+template <typename T, size_t N>
+auto length(const VecN<T, N>& a) {
+    return std::sqrt(lengthSquared(a));
+}
+
+template <typename T, size_t N>
+VecN<T, N> normalized(const VecN<T, N>& a) {
+    static_assert(std::is_floating_point_v<T>, "normalized() needs a floating-point VecN");
+    return a * (T(1) / length(a));
+}
+
+template <typename T>
+constexpr VecN<T, 3> cross(const VecN<T, 3>& a, const VecN<T, 3>& b) {
+    return VecN<T, 3>(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]);
+}
+
+// Structure-of-arrays storage for many VecN<T, N>: component k of every
+// vector is contiguous in its own 64-byte aligned stream.
+template <typename T, size_t N>
+class VecArray {
+public:
+    using value_type = VecN<T, N>;
+    static constexpr size_t kAlignment = 64;
+
+    VecArray() = default;
+
+    // n zero vectors
+    explicit VecArray(size_t n) : VecArray() { resize(n); }
+
+    VecArray(const VecArray& other) : VecArray() {
+        reserve(other.count);
+        for (size_t k = 0; k < N; ++k) std::copy(other.component(k), other.component(k) + other.count, component(k));
+        count = other.count;
+    }
+
+    VecArray& operator=(const VecArray& other) {
+        if (this != &other) {
+            VecArray copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    VecArray(VecArray&& other) noexcept { swap(other); }
+
+    VecArray& operator=(VecArray&& other) noexcept {
+        if (this != &other) {
+            VecArray dead(std::move(*this));
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~VecArray() { release(base); }
+
+    void swap(VecArray& other) noexcept {
+        std::swap(base, other.base);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+    }
+
+    void reserve(size_t n) {
+        if (n <= capacity) return;
+        // Each stream is an odd number of cache lines, so every stream starts
+        // on a line boundary and, for N < 64 components, element i of
+        // different components never sits at the same offset within a 4 KiB
+        // page (avoids 4K aliasing stalls)
+        size_t lines = (n + kLine - 1) / kLine;
+        if (lines % 2 == 0) ++lines;
+        size_t newCapacity = lines * kLine;
+        T* newBase = allocate(N * newCapacity);
+        for (size_t k = 0; k < N; ++k) {
+            std::copy(component(k), component(k) + count, newBase + k * newCapacity);
+        }
+        release(base);
+        base = newBase;
+        capacity = newCapacity;
+    }
+
+    // New elements are zero vectors
+    void resize(size_t n) {
+        if (n > capacity) reserve(std::max(n, capacity * 2));
+        if (n > count) {
+            for (size_t k = 0; k < N; ++k) std::fill(component(k) + count, component(k) + n, T(0));
+        }
+        count = n;
+    }
+
+    void push_back(const VecN<T, N>& a) {
+        if (count == capacity) reserve(std::max<size_t>(16, capacity * 2));
+        ++count;
+        set(count - 1, a);
+    }
+
+    void clear() noexcept { count = 0; }
+
+    // Single-element access through the regular VecN API
+    VecN<T, N> get(size_t i) const {
+        VecN<T, N> a;
+        for (size_t k = 0; k < N; ++k) a[k] = component(k)[i];
+        return a;
+    }
+    VecN<T, N> operator[](size_t i) const { return get(i); }
+    void set(size_t i, const VecN<T, N>& a) {
+        for (size_t k = 0; k < N; ++k) component(k)[i] = a[k];
+    }
+
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+
+    // Raw component streams for custom kernels
+    T* component(size_t k) noexcept { return base + k * capacity; }
+    const T* component(size_t k) const noexcept { return base + k * capacity; }
+
+    VecArray& operator+=(const VecArray& other);
+    VecArray& operator-=(const VecArray& other);
+    VecArray& operator*=(T scalar);
+
+private:
+    static constexpr size_t kLine = kAlignment / sizeof(T);
+
+    T* base = nullptr;
+    size_t count = 0;
+    size_t capacity = 0;
+
+    static T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+    }
+
+    static void release(T* p) noexcept {
+        if (p) ::operator delete(p, std::align_val_t(kAlignment));
+    }
+};
+
+template <typename T, size_t N>
+inline void swap(VecArray<T, N>& a, VecArray<T, N>& b) noexcept {
+    a.swap(b);
+}
+
+namespace vecn_simd {
+
+// body(i, pack) for every full pack of elements, then body(i, Scalar<T>{})
+// for the tail; body loads and stores through decltype(pack)
+template <typename T, typename Body>
+inline void forEachPack(size_t n, Body body) {
+    using P = Wide<T>;
+    size_t i = 0;
+    for (; i + P::width <= n; i += P::width) body(i, P{});
+    for (; i < n; ++i) body(i, Scalar<T>{});
+}
+
+// out[k][i] = op(a[k][i], b[k][i]) over every component stream
+template <typename T, size_t N, typename Op>
+inline void zipStreams(const VecArray<T, N>& a, const VecArray<T, N>& b, VecArray<T, N>& out, Op op) {
+    if (a.size() != b.size()) throw std::invalid_argument("VecArray: operand sizes differ");
+    out.resize(a.size());
+    for (size_t k = 0; k < N; ++k) {
+        const T* pa = a.component(k);
+        const T* pb = b.component(k);
+        T* po = out.component(k);
+        forEachPack<T>(a.size(), [&](size_t i, auto p) {
+            using P = decltype(p);
+            op(P::load(pa + i), P::load(pb + i)).store(po + i);
+        });
+    }
+}
+
+template <typename T, size_t N>
+inline void checkOutput(const VecArray<T, N>& a, Span<T> out) {
+    if (out.size() != a.size()) throw std::invalid_argument("VecArray: output size differs");
+}
+
+}  // namespace vecn_simd
+
+// out[i] = a[i] + b[i]. `out` may alias a or b.
+template <typename T, size_t N>
+inline void add(const VecArray<T, N>& a, const VecArray<T, N>& b, VecArray<T, N>& out) {
+    vecn_simd::zipStreams(a, b, out, [](auto l, auto r) { return l + r; });
+}
+
+// out[i] = a[i] - b[i]
+template <typename T, size_t N>
+inline void subtract(const VecArray<T, N>& a, const VecArray<T, N>& b, VecArray<T, N>& out) {
+    vecn_simd::zipStreams(a, b, out, [](auto l, auto r) { return l - r; });
+}
+
+// out[i] = a[i] + b[i] * s
+template <typename T, size_t N>
+inline void multiplyAdd(const VecArray<T, N>& a, const VecArray<T, N>& b, T s, VecArray<T, N>& out) {
+    vecn_simd::zipStreams(a, b, out, [s](auto l, auto r) { return l + r * decltype(r)::broadcast(s); });
+}
+
+// a[i] *= s
+template <typename T, size_t N>
+inline void scale(VecArray<T, N>& a, T s) {
+    for (size_t k = 0; k < N; ++k) {
+        T* p = a.component(k);
+        vecn_simd::forEachPack<T>(a.size(), [&](size_t i, auto pack) {
+            using P = decltype(pack);
+            (P::load(p + i) * P::broadcast(s)).store(p + i);
+        });
+    }
+}
+
+// out[i] = dot(a[i], b[i])
+template <typename T, size_t N>
+inline void dot(const VecArray<T, N>& a, const VecArray<T, N>& b, Span<T> out) {
+    if (a.size() != b.size()) throw std::invalid_argument("VecArray: operand sizes differ");
+    vecn_simd::checkOutput(a, out);
+    vecn_simd::forEachPack<T>(a.size(), [&](size_t i, auto pack) {
+        using P = decltype(pack);
+        P sum = P::load(a.component(0) + i) * P::load(b.component(0) + i);
+        for (size_t k = 1; k < N; ++k) sum = sum + P::load(a.component(k) + i) * P::load(b.component(k) + i);
+        sum.store(out.data() + i);
+    });
+}
+
+// out[i] = length(a[i])
+template <typename T, size_t N>
+inline void lengths(const VecArray<T, N>& a, Span<T> out) {
+    static_assert(std::is_floating_point_v<T>, "lengths() needs a floating-point VecArray");
+    vecn_simd::checkOutput(a, out);
+    vecn_simd::forEachPack<T>(a.size(), [&](size_t i, auto pack) {
+        using P = decltype(pack);
+        P sum = P::load(a.component(0) + i) * P::load(a.component(0) + i);
+        for (size_t k = 1; k < N; ++k) sum = sum + P::load(a.component(k) + i) * P::load(a.component(k) + i);
+        sum.sqrt().store(out.data() + i);
+    });
+}
+
+// a[i] = normalized(a[i])
+template <typename T, size_t N>
+inline void normalize(VecArray<T, N>& a) {
+    static_assert(std::is_floating_point_v<T>, "normalize() needs a floating-point VecArray");
+    vecn_simd::forEachPack<T>(a.size(), [&](size_t i, auto pack) {
+        using P = decltype(pack);
+        P c[N];
+        P sum = P::broadcast(T(0));
+        for (size_t k = 0; k < N; ++k) {
+            c[k] = P::load(a.component(k) + i);
+            sum = sum + c[k] * c[k];
+        }
+        P inverse = P::broadcast(T(1)) / sum.sqrt();
+        for (size_t k = 0; k < N; ++k) (c[k] * inverse).store(a.component(k) + i);
+    });
+}
+
+template <typename T, size_t N>
+inline VecArray<T, N>& VecArray<T, N>::operator+=(const VecArray& other) {
+    add(*this, other, *this);
+    return *this;
+}
+
+template <typename T, size_t N>
+inline VecArray<T, N>& VecArray<T, N>::operator-=(const VecArray& other) {
+    subtract(*this, other, *this);
+    return *this;
+}
+
+template <typename T, size_t N>
+inline VecArray<T, N>& VecArray<T, N>::operator*=(T scalar) {
+    scale(*this, scalar);
+    return *this;
+}
@@ -0,0 +1,170 @@
+// Vector2D (double) and plain float structs vs VecN<float, N> vs VecArray<float, N>.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o vecn_benchmark vecn_benchmark.cpp
+//     g++ -std=c++17 -O2 -march=native ...           (AVX/AVX2 8-lane kernels)
+//     g++ -std=c++17 -O2 -DVECN_FORCE_SCALAR ...     (generic VecN everywhere)
+//     ./vecn_benchmark [vectors]      (default: 1000000)
+//
+// For N = 2, 3, 4 and 8, each layout runs the same three loops over n vectors:
+//   axpy       out[i] = a[i] + b[i] * k
+//   dot        d[i] = dot(a[i], b[i])
+//   normalize  a[i] = normalized(a[i])
+// "plain" is the textbook struct of N floats with hand-written operators,
+// VecN is the padded SIMD register type stored in a std::vector (AoS), and
+// VecArray the SoA container with its bulk kernels. For N = 2, Vector2D from
+// 05_operator_overloading shows what double precision costs.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../05_operator_overloading/vector2d.h"
+#include "../common/benchmark.h"
+#include "vecn.h"
+
+// Textbook fixed-size vector: one float member per component
+template <size_t N>
+struct Plain {
+    float c[N];
+
+    Plain operator+(const Plain& o) const {
+        Plain r;
+        for (size_t k = 0; k < N; ++k) r.c[k] = c[k] + o.c[k];
+        return r;
+    }
+    Plain operator*(float s) const {
+        Plain r;
+        for (size_t k = 0; k < N; ++k) r.c[k] = c[k] * s;
+        return r;
+    }
+    float dot(const Plain& o) const {
+        float sum = 0;
+        for (size_t k = 0; k < N; ++k) sum += c[k] * o.c[k];
+        return sum;
+    }
+    Plain normalized() const { return *this * (1.0f / std::sqrt(dot(*this))); }
+};
+
+constexpr int kRepeats = 5;
+constexpr float kScale = 0.5f;
+
+float component(size_t i, size_t k) { return static_cast<float>((i * 7 + k * 13) % 101) * 0.01f + 0.1f; }
+
+struct Row {
+    double axpy, dot, normalize, check;
+};
+
+void printRow(const char* name, size_t bytes, const Row& r, const Row& base, size_t n) {
+    std::printf("  %-22s %4zu B %9.2f %9.2f %9.2f     %5.2fx %5.2fx %5.2fx\n", name, bytes, r.axpy / n,
+                r.dot / n, r.normalize / n, base.axpy / r.axpy, base.dot / r.dot, base.normalize / r.normalize);
+}
+
+bool close(double a, double b) { return std::abs(a - b) <= 1e-4 * std::abs(b) + 1e-3; }
+
+// Array-of-structs layouts: Plain<N>, VecN<float, N> and Vector2D
+template <typename V, typename Dot, typename Normalize>
+Row runAos(size_t n, V (*make)(size_t), Dot dotFn, Normalize normalizeFn) {
+    std::vector<V> a(n), b(n), out(n);
+    std::vector<float> d(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = make(i);
+        b[i] = make(i + 1);
+    }
+    Row r;
+    r.axpy = bench::bestOfNs([&] {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] + b[i] * kScale;
+        bench::doNotOptimize(out.data());
+    }, kRepeats);
+    r.dot = bench::bestOfNs([&] {
+        for (size_t i = 0; i < n; ++i) d[i] = static_cast<float>(dotFn(a[i], b[i]));
+        bench::doNotOptimize(d.data());
+    }, kRepeats);
+    r.check = 0;
+    for (float x : d) r.check += x;
+    r.normalize = bench::bestOfNs([&] {
+        for (size_t i = 0; i < n; ++i) out[i] = normalizeFn(out[i]);
+        bench::doNotOptimize(out.data());
+    }, kRepeats);
+    return r;
+}
+
+template <size_t N>
+Row runSoa(size_t n) {
+    VecArray<float, N> a(n), b(n), out(n);
+    std::vector<float> d(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = 0; k < N; ++k) {
+            a.component(k)[i] = component(i, k);
+            b.component(k)[i] = component(i + 1, k);
+        }
+    }
+    Row r;
+    r.axpy = bench::bestOfNs([&] {
+        multiplyAdd(a, b, kScale, out);
+        bench::clobberMemory();
+    }, kRepeats);
+    r.dot = bench::bestOfNs([&] {
+        dot(a, b, Span<float>(d));
+        bench::clobberMemory();
+    }, kRepeats);
+    r.check = 0;
+    for (float x : d) r.check += x;
+    r.normalize = bench::bestOfNs([&] {
+        normalize(out);
+        bench::clobberMemory();
+    }, kRepeats);
+    return r;
+}
+
+template <size_t N>
+Plain<N> makePlain(size_t i) {
+    Plain<N> p;
+    for (size_t k = 0; k < N; ++k) p.c[k] = component(i, k);
+    return p;
+}
+
+template <size_t N>
+VecN<float, N> makeVec(size_t i) {
+    VecN<float, N> v;
+    for (size_t k = 0; k < N; ++k) v[k] = component(i, k);
+    return v;
+}
+
+Vector2D makeVector2D(size_t i) { return Vector2D(component(i, 0), component(i, 1)); }
+
+template <size_t N>
+bool runDimension(size_t n) {
+    std::printf("N = %zu%37s %9s %9s     speedup vs plain\n", N, "axpy ns", "dot ns", "norm ns");
+    Row plain = runAos<Plain<N>>(n, makePlain<N>, [](const Plain<N>& x, const Plain<N>& y) { return x.dot(y); },
+                                 [](const Plain<N>& x) { return x.normalized(); });
+    Row vec = runAos<VecN<float, N>>(n, makeVec<N>, [](const VecN<float, N>& x, const VecN<float, N>& y) {
+        return dot(x, y);
+    }, [](const VecN<float, N>& x) { return normalized(x); });
+    Row soa = runSoa<N>(n);
+
+    bool ok = close(vec.check, plain.check) && close(soa.check, plain.check);
+    if constexpr (N == 2) {
+        Row v2d = runAos<Vector2D>(n, makeVector2D, [](const Vector2D& x, const Vector2D& y) { return x * y; },
+                                   [](const Vector2D& x) { return x * (1.0 / std::sqrt(x * x)); });
+        ok = ok && close(v2d.check, plain.check);
+        printRow("Vector2D (double)", sizeof(Vector2D), v2d, plain, n);
+    }
+    printRow("plain float struct", sizeof(Plain<N>), plain, plain, n);
+    printRow("VecN<float> (AoS)", sizeof(VecN<float, N>), vec, plain, n);
+    printRow("VecArray<float> (SoA)", N * sizeof(float), soa, plain, n);
+    if (!ok) std::printf("  MISMATCH: dot sums %.3f / %.3f / %.3f\n", plain.check, vec.check, soa.check);
+    std::printf("\n");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 1000000);
+    std::printf("=== VecN<T, N> and VecArray (%zu vectors, %s) ===\n\n", n,
+                vecn_simd::Wide<float>::width > 1 ? "SIMD" : "VECN_FORCE_SCALAR");
+
+    bool ok = runDimension<2>(n);
+    ok = runDimension<3>(n) && ok;
+    ok = runDimension<4>(n) && ok;
+    ok = runDimension<8>(n) && ok;
+    return ok ? 0 : 1;
+}
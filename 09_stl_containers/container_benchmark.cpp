@@ -0,0 +1,298 @@
+// Container benchmark suite: insert, lookup, erase and iterate, 1e3 to 1e8 elements.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o container_benchmark container_benchmark.cpp
+//     ./container_benchmark [max_n] [--readme README.md]
+//         max_n defaults to 1000000; sizes are 1e3, 1e4, ... up to max_n.
+//         --readme rewrites the measured table in README.md with this run.
+//
+// Elements are pair<uint64_t, uint64_t> with unique random keys. Every number
+// is nanoseconds per operation:
+//   insert   - n inserts into an empty container (push_back for sequences)
+//   lookup   - find an existing key, random order
+//   erase    - remove an existing key, random order (half of the keys)
+//   iterate  - visit every element and sum the values
+// Operations that are O(n) each (lookup/erase in an unsorted sequence,
+// insert/erase in FlatMap) run on a sample of keys instead of all n, so large
+// sizes finish; they are marked with * in the table.
+//
+// 1e8 elements needs several GB per container (std::map and std::list about
+// 5 GB); pass a smaller max_n on small machines.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "flat_hash_map.h"
+#include "flat_map.h"
+
+using Key = std::uint64_t;
+using Item = std::pair<Key, Key>;
+
+struct Result {
+    double insert = 0, lookup = 0, erase = 0, iterate = 0;
+    bool sampledInsert = false, sampledLookup = false, sampledErase = false;
+    bool ok = true;
+};
+
+struct Workload {
+    std::vector<Key> keys;         // Insertion order
+    std::vector<Key> lookupOrder;  // All keys, shuffled
+    std::vector<Key> eraseOrder;   // Half of the keys, shuffled differently
+};
+
+// Enough samples to be stable, few enough that O(n) operations on 1e8
+// elements still finish: about 1e8 element visits in total
+size_t sampleCount(size_t n) { return std::min(n, std::clamp<size_t>(100000000 / n, 10, 1000)); }
+
+template <typename Fn>
+double timeNs(Fn&& fn) {
+    auto start = bench::Clock::now();
+    fn();
+    bench::clobberMemory();
+    return std::chrono::duration<double, std::nano>(bench::Clock::now() - start).count();
+}
+
+// std::map, std::unordered_map and FlatHashMap: every operation on all keys
+template <typename Map>
+Result runMap(const Workload& w) {
+    size_t n = w.keys.size();
+    Result r;
+    Map m;
+    r.insert = timeNs([&] { for (Key k : w.keys) m.try_emplace(k, k); }) / n;
+
+    Key sum = 0;
+    r.lookup = timeNs([&] { for (Key k : w.lookupOrder) sum += m.find(k)->second; }) / n;
+    r.ok = sum == std::accumulate(w.keys.begin(), w.keys.end(), Key{0});
+
+    Key total = 0;
+    r.iterate = timeNs([&] { for (const auto& item : m) total += item.second; }) / n;
+    r.ok = r.ok && total == sum;
+
+    r.erase = timeNs([&] { for (Key k : w.eraseOrder) m.erase(k); }) / w.eraseOrder.size();
+    r.ok = r.ok && m.size() == n - w.eraseOrder.size();
+    return r;
+}
+
+// FlatMap: built in bulk, then a sample of O(n) single inserts and erases
+Result runFlatMap(const Workload& w) {
+    size_t n = w.keys.size();
+    size_t samples = sampleCount(n);
+    Result r;
+    r.sampledInsert = r.sampledErase = true;
+
+    std::vector<Item> items;
+    items.reserve(n);
+    for (size_t i = samples; i < n; ++i) items.emplace_back(w.keys[i], w.keys[i]);
+    FlatMap<Key, Key> m(std::move(items));
+    r.insert = timeNs([&] { for (size_t i = 0; i < samples; ++i) m.try_emplace(w.keys[i], w.keys[i]); }) / samples;
+
+    Key sum = 0;
+    r.lookup = timeNs([&] { for (Key k : w.lookupOrder) sum += m.find(k)->second; }) / n;
+    r.ok = sum == std::accumulate(w.keys.begin(), w.keys.end(), Key{0});
+
+    Key total = 0;
+    r.iterate = timeNs([&] { for (const auto& item : m) total += item.second; }) / n;
+    r.ok = r.ok && total == sum;
+
+    // eraseOrder holds only half of the keys
+    size_t eraseSamples = std::min(samples, w.eraseOrder.size());
+    r.erase = timeNs([&] { for (size_t i = 0; i < eraseSamples; ++i) m.erase(w.eraseOrder[i]); }) / eraseSamples;
+    r.ok = r.ok && m.size() == n - eraseSamples;
+    return r;
+}
+
+// vector, deque and list of pairs: push_back, then linear search
+template <typename Seq>
+Result runSequence(const Workload& w) {
+    size_t n = w.keys.size();
+    size_t samples = sampleCount(n);
+    Result r;
+    r.sampledLookup = r.sampledErase = true;
+
+    Seq s;
+    r.insert = timeNs([&] { for (Key k : w.keys) s.push_back({k, k}); }) / n;
+
+    auto findKey = [&](Key k) {
+        return std::find_if(s.begin(), s.end(), [k](const Item& item) { return item.first == k; });
+    };
+
+    Key sum = 0;
+    r.lookup = timeNs([&] { for (size_t i = 0; i < samples; ++i) sum += findKey(w.lookupOrder[i])->second; }) /
+               samples;
+    r.ok = sum == std::accumulate(w.lookupOrder.begin(), w.lookupOrder.begin() + samples, Key{0});
+
+    Key total = 0;
+    r.iterate = timeNs([&] { for (const auto& item : s) total += item.second; }) / n;
+    r.ok = r.ok && total == std::accumulate(w.keys.begin(), w.keys.end(), Key{0});
+
+    size_t eraseSamples = std::min(samples, w.eraseOrder.size());
+    r.erase = timeNs([&] { for (size_t i = 0; i < eraseSamples; ++i) s.erase(findKey(w.eraseOrder[i])); }) /
+              eraseSamples;
+    r.ok = r.ok && s.size() == n - eraseSamples;
+    return r;
+}
+
+struct Column {
+    const char* name;
+    Result (*run)(const Workload&);
+};
+
+const Column kContainers[] = {
+    {"std::vector", runSequence<std::vector<Item>>},
+    {"std::deque", runSequence<std::deque<Item>>},
+    {"std::list", runSequence<std::list<Item>>},
+    {"std::map", runMap<std::map<Key, Key>>},
+    {"std::unordered_map", runMap<std::unordered_map<Key, Key>>},
+    {"FlatMap", runFlatMap},
+    {"FlatHashMap", runMap<FlatHashMap<Key, Key>>},
+};
+constexpr size_t kContainerCount = sizeof(kContainers) / sizeof(kContainers[0]);
+
+Workload makeWorkload(size_t n, std::mt19937_64& rng) {
+    Workload w;
+    w.keys.resize(n);
+    for (size_t i = 0; i < n; ++i) w.keys[i] = flat_hash_detail::mix(i + 1);  // Bijective: unique
+    w.lookupOrder = w.keys;
+    std::shuffle(w.lookupOrder.begin(), w.lookupOrder.end(), rng);
+    w.eraseOrder = w.keys;
+    std::shuffle(w.eraseOrder.begin(), w.eraseOrder.end(), rng);
+    w.eraseOrder.resize(n / 2);
+    return w;
+}
+
+std::string sizeLabel(size_t n) {
+    int exponent = 0;
+    size_t v = n;
+    while (v >= 10 && v % 10 == 0) {
+        v /= 10;
+        ++exponent;
+    }
+    return v == 1 ? "1e" + std::to_string(exponent) : std::to_string(n);
+}
+
+std::string cell(double ns, bool sampled) {
+    char text[32];
+    if (ns >= 1e6) std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
+    else if (ns >= 1e3) std::snprintf(text, sizeof(text), "%.1f us", ns / 1e3);
+    else std::snprintf(text, sizeof(text), "%.1f", ns);
+    return std::string(text) + (sampled ? "*" : "");
+}
+
+// One Markdown table per operation, containers down, sizes across
+std::string markdown(const std::vector<size_t>& sizes, const std::vector<std::vector<Result>>& results) {
+    struct Op {
+        const char* name;
+        double Result::*value;
+        bool Result::*sampled;
+    };
+    const Op ops[] = {{"insert", &Result::insert, &Result::sampledInsert},
+                      {"lookup", &Result::lookup, &Result::sampledLookup},
+                      {"erase", &Result::erase, &Result::sampledErase},
+                      {"iterate", &Result::iterate, nullptr}};  // Iteration is never sampled
+
+    std::ostringstream out;
+    for (const Op& op : ops) {
+        out << "\n| " << op.name << " (ns/op) |";
+        for (size_t n : sizes) out << " " << sizeLabel(n) << " |";
+        out << "\n|---|";
+        for (size_t i = 0; i < sizes.size(); ++i) out << "---:|";
+        out << "\n";
+        for (size_t c = 0; c < kContainerCount; ++c) {
+            out << "| " << kContainers[c].name << " |";
+            for (size_t s = 0; s < sizes.size(); ++s) {
+                const Result& r = results[s][c];
+                out << " " << cell(r.*op.value, op.sampled && r.*op.sampled) << " |";
+            }
+            out << "\n";
+        }
+    }
+    return out.str();
+}
+
+const char* kBegin = "<!-- container_benchmark: begin -->";
+const char* kEnd = "<!-- container_benchmark: end -->";
+
+bool updateReadme(const std::string& path, const std::string& body) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+    size_t begin = text.find(kBegin);
+    size_t end = text.find(kEnd);
+    if (begin == std::string::npos || end == std::string::npos || end < begin) return false;
+    text.replace(begin + std::strlen(kBegin), end - begin - std::strlen(kBegin), body);
+    std::ofstream(path) << text;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t maxN = 1000000;
+    const char* readme = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--readme") == 0 && i + 1 < argc) readme = argv[++i];
+        else maxN = std::max<size_t>(1000, std::strtoull(argv[i], nullptr, 10));
+    }
+
+    std::vector<size_t> sizes;
+    for (size_t n = 1000; n <= maxN; n *= 10) sizes.push_back(n);
+
+    std::printf("=== STL Containers vs FlatMap / FlatHashMap (ns/op, * = sampled) ===\n");
+    std::mt19937_64 rng(42);
+    std::vector<std::vector<Result>> results;
+    bool ok = true;
+    for (size_t n : sizes) {
+        Workload w = makeWorkload(n, rng);
+        std::printf("\nn = %s\n%-20s %12s %12s %12s %12s\n", sizeLabel(n).c_str(), "container", "insert",
+                    "lookup", "erase", "iterate");
+        std::vector<Result> row;
+        for (const Column& c : kContainers) {
+            Result r = c.run(w);
+            std::printf("%-20s %12s %12s %12s %12s%s\n", c.name, cell(r.insert, r.sampledInsert).c_str(),
+                        cell(r.lookup, r.sampledLookup).c_str(), cell(r.erase, r.sampledErase).c_str(),
+                        cell(r.iterate, false).c_str(), r.ok ? "" : "   WRONG RESULT");
+            std::fflush(stdout);
+            ok = ok && r.ok;
+            row.push_back(r);
+        }
+        results.push_back(std::move(row));
+    }
+
+    char header[256];
+    std::snprintf(header, sizeof(header),
+                  "\nMeasured by `container_benchmark` (%u hardware threads, %s). "
+                  "`*` = sampled, see the benchmark's header.\n",
+                  std::max(1u, std::thread::hardware_concurrency()),
+#if defined(__clang__)
+                  "clang " __clang_version__
+#elif defined(__GNUC__)
+                  "g++ " __VERSION__
+#elif defined(_MSC_VER)
+                  "MSVC"
+#else
+                  "unknown compiler"
+#endif
+    );
+    std::string table = header + markdown(sizes, results) + "\n";
+
+    if (readme) {
+        if (updateReadme(readme, table)) std::printf("\nUpdated %s\n", readme);
+        else std::printf("\nCould not update %s (missing %s / %s markers?)\n", readme, kBegin, kEnd);
+    } else {
+        std::printf("\nMarkdown table:\n%s", table.c_str());
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,369 @@
+#pragma once
+
+// Open-addressing hash map with SIMD group matching (SwissTable layout).
+//
+//     FlatHashMap<uint64_t, int> m;
+//     m[42] = 1;
+//     m.insert({7, 2});
+//     if (auto it = m.find(7); it != m.end()) it->second++;
+//     m.erase(42);
+//
+// std::unordered_map allocates one node per element and resolves a lookup by
+// following a bucket pointer and then a linked list. FlatHashMap stores the
+// elements themselves in one flat array, plus one control byte per slot:
+//
+//     control byte:  0xxxxxxx  occupied, low 7 bits = 7 more bits of the hash
+//                    10000000  empty
+//                    11111110  deleted (tombstone)
+//
+// Slots are probed in aligned groups of 16. One SSE2 compare checks all 16
+// control bytes of a group against the key's 7-bit tag at once, so a lookup
+// usually costs one control-byte load, one key compare and no pointer chase.
+// Groups are probed linearly; a group that contains an empty slot ends the
+// search. Without SSE2 the group match falls back to a portable loop.
+//
+// Differences from std::unordered_map:
+//   - Inserting or rehashing invalidates iterators and references
+//   - Rehashing copies keys: value_type is pair<const K, V>, as in std::, so
+//     a key cannot be moved out. reserve() up front avoids rehashing.
+//   - Maximum load factor is 7/8
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2 1
+#endif
+
+namespace flat_hash_detail {
+
+constexpr std::int8_t kEmpty = -128;   // 0b10000000
+constexpr std::int8_t kDeleted = -2;   // 0b11111110
+constexpr size_t kGroupWidth = 16;
+
+// Bit i set for each of the 16 control bytes that matches
+struct Group {
+    const std::int8_t* ctrl;
+
+#if defined(FLAT_HASH_MAP_SSE2)
+    std::uint32_t match(std::int8_t tag) const {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        __m128i hits = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+    }
+    // Empty and deleted are the only bytes with the top bit set
+    std::uint32_t matchEmptyOrDeleted() const {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+    }
+#else
+    std::uint32_t match(std::int8_t tag) const {
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) mask |= std::uint32_t(ctrl[i] == tag) << i;
+        return mask;
+    }
+    std::uint32_t matchEmptyOrDeleted() const {
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) mask |= std::uint32_t(ctrl[i] < 0) << i;
+        return mask;
+    }
+#endif
+    std::uint32_t matchEmpty() const { return match(kEmpty); }
+};
+
+inline int lowestBit(std::uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// std::hash of an integer is the identity in libstdc++ and MSVC; mix it so
+// both the group index (low bits) and the tag (high bits) are well spread
+inline std::uint64_t mix(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace flat_hash_detail
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+    using Group = flat_hash_detail::Group;
+    static constexpr size_t kGroupWidth = flat_hash_detail::kGroupWidth;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = size_t;
+
+    template <bool Const>
+    class Iterator {
+        using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+
+    public:
+        using value_type = FlatHashMap::value_type;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator() = default;
+        Iterator(Map* m, size_t i) : map(m), index(i) { skipFree(); }
+        // iterator -> const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : map(other.map), index(other.index) {}
+
+        reference operator*() const { return *map->slotAt(index); }
+        pointer operator->() const { return map->slotAt(index); }
+
+        Iterator& operator++() {
+            ++index;
+            skipFree();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator before = *this;
+            ++*this;
+            return before;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.index == b.index; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a.index != b.index; }
+
+    private:
+        friend class FlatHashMap;
+        template <bool>
+        friend class Iterator;
+
+        Map* map = nullptr;
+        size_t index = 0;
+
+        void skipFree() {
+            while (index < map->slotCount && map->ctrl[index] < 0) ++index;
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(const FlatHashMap& other) : hasher(other.hasher), equal(other.equal) {
+        reserve(other.size());
+        for (const auto& item : other) insert(item);
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+
+    FlatHashMap& operator=(FlatHashMap other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        destroyAll();
+        ::operator delete(slots);
+    }
+
+    void swap(FlatHashMap& other) noexcept {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(slotCount, other.slotCount);
+        std::swap(used, other.used);
+        std::swap(tombstones, other.tombstones);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slotCount); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slotCount); }
+
+    size_t size() const { return used; }
+    bool empty() const { return used == 0; }
+    size_t capacity() const { return slotCount; }
+
+    // Make room for n elements without rehashing
+    void reserve(size_t n) {
+        size_t needed = kGroupWidth;
+        while (needed * 7 / 8 < n) needed *= 2;
+        if (needed > slotCount) rehash(needed);
+    }
+
+    void clear() {
+        destroyAll();
+        if (ctrl) std::memset(ctrl.get(), flat_hash_detail::kEmpty, slotCount);
+        used = 0;
+        tombstones = 0;
+    }
+
+    iterator find(const K& key) {
+        size_t i = findIndex(key);
+        return i == kNotFound ? end() : iterator(this, i);
+    }
+
+    const_iterator find(const K& key) const {
+        size_t i = findIndex(key);
+        return i == kNotFound ? end() : const_iterator(this, i);
+    }
+
+    bool contains(const K& key) const { return findIndex(key) != kNotFound; }
+    size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    // Insert {key, V(args...)} unless key is present; like std::map::try_emplace
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        std::uint64_t h = hashOf(key);
+        size_t i = findIndex(key, h);
+        if (i != kNotFound) return {iterator(this, i), false};
+
+        if ((used + tombstones + 1) * 8 > slotCount * 7) {
+            // Mostly tombstones: clean up in place; otherwise grow
+            size_t grown = slotCount ? slotCount * 2 : kGroupWidth;
+            rehash(used * 2 + 2 > slotCount ? grown : slotCount);
+        }
+        i = findFreeSlot(h);
+        if (ctrl[i] == flat_hash_detail::kDeleted) --tombstones;
+        ::new (static_cast<void*>(slots + i))
+            value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+        ctrl[i] = tagOf(h);
+        ++used;
+        return {iterator(this, i), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& item) { return try_emplace(item.first, item.second); }
+
+    template <typename M>
+    std::pair<iterator, bool> emplace(const K& key, M&& value) {
+        return try_emplace(key, std::forward<M>(value));
+    }
+
+    V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+    size_t erase(const K& key) {
+        size_t i = findIndex(key);
+        if (i == kNotFound) return 0;
+        eraseAt(i);
+        return 1;
+    }
+
+    iterator erase(iterator pos) {
+        eraseAt(pos.index);
+        ++pos;
+        return pos;
+    }
+
+private:
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+    std::unique_ptr<std::int8_t[]> ctrl;
+    value_type* slots = nullptr;
+    size_t slotCount = 0;  // Power of two, multiple of kGroupWidth (or 0)
+    size_t used = 0;
+    size_t tombstones = 0;
+    Hash hasher;
+    KeyEqual equal;
+
+    value_type* slotAt(size_t i) const { return std::launder(slots + i); }
+
+    std::uint64_t hashOf(const K& key) const {
+        return flat_hash_detail::mix(static_cast<std::uint64_t>(hasher(key)));
+    }
+    static std::int8_t tagOf(std::uint64_t h) { return static_cast<std::int8_t>(h >> 57); }
+    size_t firstGroup(std::uint64_t h) const { return (h & (slotCount / kGroupWidth - 1)) * kGroupWidth; }
+
+    size_t findIndex(const K& key) const { return slotCount ? findIndex(key, hashOf(key)) : kNotFound; }
+
+    size_t findIndex(const K& key, std::uint64_t h) const {
+        if (!slotCount) return kNotFound;
+        std::int8_t tag = tagOf(h);
+        size_t base = firstGroup(h);
+        for (size_t probes = 0; probes < slotCount; probes += kGroupWidth) {
+            Group g{ctrl.get() + base};
+            for (std::uint32_t m = g.match(tag); m; m &= m - 1) {
+                size_t i = base + flat_hash_detail::lowestBit(m);
+                if (equal(slotAt(i)->first, key)) return i;
+            }
+            if (g.matchEmpty()) return kNotFound;
+            base = (base + kGroupWidth) & (slotCount - 1);
+        }
+        return kNotFound;
+    }
+
+    // First empty or deleted slot on h's probe sequence (one always exists)
+    size_t findFreeSlot(std::uint64_t h) const {
+        size_t base = firstGroup(h);
+        for (;;) {
+            std::uint32_t m = Group{ctrl.get() + base}.matchEmptyOrDeleted();
+            if (m) return base + flat_hash_detail::lowestBit(m);
+            base = (base + kGroupWidth) & (slotCount - 1);
+        }
+    }
+
+    void eraseAt(size_t i) {
+        slotAt(i)->~value_type();
+        --used;
+        // A group that already has an empty slot ends every probe that reaches
+        // it, so this slot can become empty too; otherwise leave a tombstone
+        size_t base = i & ~(kGroupWidth - 1);
+        if (Group{ctrl.get() + base}.matchEmpty()) {
+            ctrl[i] = flat_hash_detail::kEmpty;
+        } else {
+            ctrl[i] = flat_hash_detail::kDeleted;
+            ++tombstones;
+        }
+    }
+
+    void destroyAll() {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_t i = 0; i < slotCount; ++i) {
+                if (ctrl[i] >= 0) slotAt(i)->~value_type();
+            }
+        }
+    }
+
+    void rehash(size_t newCount) {
+        std::unique_ptr<std::int8_t[]> oldCtrl = std::move(ctrl);
+        value_type* oldSlots = slots;
+        size_t oldCount = slotCount;
+
+        ctrl.reset(new std::int8_t[newCount]);
+        std::memset(ctrl.get(), flat_hash_detail::kEmpty, newCount);
+        slots = static_cast<value_type*>(::operator new(newCount * sizeof(value_type)));
+        slotCount = newCount;
+        tombstones = 0;
+
+        for (size_t i = 0; i < oldCount; ++i) {
+            if (oldCtrl[i] < 0) continue;
+            value_type* item = std::launder(oldSlots + i);
+            std::uint64_t h = hashOf(item->first);
+            size_t j = findFreeSlot(h);
+            ::new (static_cast<void*>(slots + j)) value_type(std::move(*item));
+            ctrl[j] = tagOf(h);
+            item->~value_type();
+        }
+        ::operator delete(oldSlots);
+    }
+};
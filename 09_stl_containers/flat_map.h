@@ -0,0 +1,114 @@
+#pragma once
+
+// Sorted-vector map: std::map's interface, std::vector's memory layout.
+//
+//     FlatMap<int, std::string> m;
+//     m[3] = "three";                        // O(n) insert (shifts the tail)
+//     m.find(3);                             // O(log n) binary search
+//
+//     FlatMap<int, std::string> built(std::move(pairs));   // Bulk: sort once
+//
+// std::map is a red-black tree: every element is its own heap node, and a
+// lookup follows log2(n) pointers to nodes scattered across memory. FlatMap
+// keeps the pairs sorted in one contiguous vector, so the same binary search
+// touches neighbouring cache lines and iteration is a linear scan.
+//
+// The trade-off is insertion and erasure in the middle, which move every
+// later element. It suits maps that are built once (or in bulk) and then
+// mostly read, e.g. configuration, lookup tables and dictionaries.
+//
+// Unlike std::map, value_type is pair<K, V> (not pair<const K, V>) so the
+// vector can shift elements; changing a key through an iterator breaks the
+// ordering.
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    FlatMap() = default;
+
+    // Bulk construction: sort once instead of n O(n) inserts. For duplicate
+    // keys the first occurrence wins, as with repeated insert().
+    explicit FlatMap(std::vector<value_type> items, Compare cmp = Compare())
+        : data(std::move(items)), less(cmp) {
+        std::stable_sort(data.begin(), data.end(), pairLess());
+        auto same = [this](const value_type& a, const value_type& b) {
+            return !less(a.first, b.first) && !less(b.first, a.first);
+        };
+        data.erase(std::unique(data.begin(), data.end(), same), data.end());
+    }
+
+    iterator begin() { return data.begin(); }
+    iterator end() { return data.end(); }
+    const_iterator begin() const { return data.begin(); }
+    const_iterator end() const { return data.end(); }
+
+    size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    void reserve(size_t n) { data.reserve(n); }
+    void clear() { data.clear(); }
+
+    iterator lower_bound(const K& key) {
+        return std::lower_bound(data.begin(), data.end(), key, keyLess());
+    }
+    const_iterator lower_bound(const K& key) const {
+        return std::lower_bound(data.begin(), data.end(), key, keyLess());
+    }
+
+    iterator find(const K& key) {
+        auto it = lower_bound(key);
+        return (it != data.end() && !less(key, it->first)) ? it : data.end();
+    }
+    const_iterator find(const K& key) const {
+        auto it = lower_bound(key);
+        return (it != data.end() && !less(key, it->first)) ? it : data.end();
+    }
+
+    bool contains(const K& key) const { return find(key) != end(); }
+    size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        auto it = lower_bound(key);
+        if (it != data.end() && !less(key, it->first)) return {it, false};
+        it = data.emplace(it, std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+        return {it, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& item) { return try_emplace(item.first, item.second); }
+
+    V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+    size_t erase(const K& key) {
+        auto it = find(key);
+        if (it == data.end()) return 0;
+        data.erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) { return data.erase(pos); }
+
+private:
+    std::vector<value_type> data;
+    Compare less;
+
+    auto keyLess() const {
+        return [this](const value_type& item, const K& key) { return less(item.first, key); };
+    }
+    auto pairLess() const {
+        return [this](const value_type& a, const value_type& b) { return less(a.first, b.first); };
+    }
+};
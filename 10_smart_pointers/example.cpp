@@ -2,6 +2,11 @@
 #include <memory>
 #include <vector>
 
+#include "../common/lifecycle_trace.h"
+#include "intrusive_ptr.h"
+#include "object_pool.h"
+#include "poly_collection.h"
+
 // Example 1: unique_ptr basic usage
 void uniquePtrBasics() {
     std::cout << "=== unique_ptr Basics ===" << std::endl;
@@ -53,11 +58,11 @@ public:
     std::weak_ptr<Node> prev;        // Weak reference (breaks cycle)
     
     Node(int d) : data(d) {
-        std::cout << "Node " << data << " created\n";
+        LIFECYCLE_EVENT("Node", Construct, this, data);
     }
     
     ~Node() {
-        std::cout << "Node " << data << " destroyed\n";
+        LIFECYCLE_EVENT("Node", Destruct, this, data);
     }
 };
 
@@ -82,16 +87,44 @@ void weakPtrExample() {
     std::cout << std::endl;
 }  // Both nodes properly destroyed (no leak!)
 
+// Example 3b: Intrusive reference count (see intrusive_ptr.h)
+class GraphNode : public RefCounted<GraphNode, LocalRefCount> {  // Single-threaded graph
+public:
+    int data;
+    IntrusivePtr<GraphNode> next;  // Strong reference
+    GraphNode* prev = nullptr;     // Non-owning back link: no cycle to break
+
+    GraphNode(int d) : data(d) {}
+};
+
+void intrusivePtrExample() {
+    std::cout << "=== Intrusive Pointer Example ===" << std::endl;
+
+    auto node1 = makeIntrusive<GraphNode>(1);  // One allocation, count inside the node
+    auto node2 = makeIntrusive<GraphNode>(2);
+
+    node1->next = node2;
+    node2->prev = node1.get();
+
+    std::cout << "node1 count: " << node1->useCount() << std::endl;  // 1
+    std::cout << "node2 count: " << node2->useCount() << std::endl;  // 2
+    std::cout << "Previous node data: " << node2->prev->data << std::endl;
+    std::cout << "Pointer size: " << sizeof(node1) << " bytes (shared_ptr: "
+              << sizeof(std::shared_ptr<Node>) << ")" << std::endl;
+
+    std::cout << std::endl;
+}
+
 // Example 4: Factory function returning unique_ptr
 class Widget {
     int id;
 public:
     Widget(int i) : id(i) {
-        std::cout << "Widget " << id << " created\n";
+        LIFECYCLE_EVENT("Widget", Construct, this, id);
     }
     
     ~Widget() {
-        std::cout << "Widget " << id << " destroyed\n";
+        LIFECYCLE_EVENT("Widget", Destruct, this, id);
     }
     
     void use() {
@@ -130,6 +163,29 @@ void containerExample() {
     std::cout << std::endl;
 }  // All widgets automatically destroyed
 
+// Example 5b: Widgets from a pool instead of one heap block each (see object_pool.h)
+PoolPtr<Widget> createWidget(ObjectPool<Widget>& pool, int id) {
+    return pool.make(id);  // Same shape as createWidget(int), but slab-allocated
+}
+
+void poolExample() {
+    std::cout << "=== Widgets from an ObjectPool ===" << std::endl;
+
+    ObjectPool<Widget> pool;
+    std::vector<PoolPtr<Widget>> widgets;
+    widgets.push_back(createWidget(pool, 1));
+    widgets.push_back(createWidget(pool, 2));
+    widgets.push_back(createWidget(pool, 3));
+
+    widgets.pop_back();  // Widget 3 destroyed, its slot returns to the pool
+    std::cout << "Live widgets: " << pool.liveCount() << std::endl;
+
+    std::cout << "End of frame: pool.reset()\n";
+    pool.reset();  // Widgets 1 and 2 destroyed at once; the handles are now inert
+    widgets.clear();
+    std::cout << std::endl;
+}
+
 // Example 6: Polymorphism with smart pointers
 class Animal {
 public:
@@ -137,7 +193,7 @@ public:
     virtual ~Animal() { std::cout << "Animal destroyed\n"; }
 };
 
-class Dog : public Animal {
+class Dog final : public Animal {  // final: lets the compiler devirtualize
 public:
     void makeSound() override {
         std::cout << "Woof!\n";
@@ -145,7 +201,7 @@ public:
     ~Dog() { std::cout << "Dog destroyed\n"; }
 };
 
-class Cat : public Animal {
+class Cat final : public Animal {
 public:
     void makeSound() override {
         std::cout << "Meow!\n";
@@ -157,7 +213,7 @@ void polymorphismExample() {
     std::cout << "=== Polymorphism with Smart Pointers ===" << std::endl;
     
     std::vector<std::unique_ptr<Animal>> animals;
-    animals.push_back(std::make unique<Dog>());
+    animals.push_back(std::make_unique<Dog>());
     animals.push_back(std::make_unique<Cat>());
     
     for (const auto& animal : animals) {
@@ -168,14 +224,50 @@ void polymorphismExample() {
     std::cout << std::endl;
 }
 
+// Example 6b: Same animals stored by value, one contiguous array per type
+void polyCollectionExample() {
+    std::cout << "=== PolyCollection: No Pointers, No Virtual Calls ===" << std::endl;
+
+    PolyCollection<Dog, Cat> animals;
+    animals.reserve<Dog>(2);  // No reallocation, so no extra destructor output
+    animals.reserve<Cat>(1);
+    animals.emplace<Dog>();
+    animals.emplace<Cat>();
+    animals.emplace<Dog>();
+
+    // Grouped by type: Woof, Woof, Meow. Each call is a direct call.
+    animals.forEach([](auto& animal) { animal.makeSound(); });
+
+    std::cout << "Exiting scope...\n";
+}
+
+// Runs one example, then prints the Node/Widget lifetimes it traced
+template <typename Example>
+void traced(Example example) {
+    std::uint64_t mark = lifecycle::now();
+    example();
+    if (!lifecycle::events(mark).empty()) {
+        lifecycle::printEvents(std::cout, mark);
+        std::cout << std::endl;
+    }
+}
+
 int main() {
     uniquePtrBasics();
     sharedPtrBasics();
-    weakPtrExample();
-    factoryExample();
-    containerExample();
+    traced(weakPtrExample);
+    intrusivePtrExample();
+    traced(factoryExample);
+    traced(containerExample);
+    traced(poolExample);
     polymorphismExample();
+    polyCollectionExample();
     
+#if LIFECYCLE_TRACE
+    if (lifecycle::writeChromeTrace("lifecycle_trace.json")) {
+        std::cout << "Lifetimes written to lifecycle_trace.json (open in chrome://tracing)" << std::endl;
+    }
+#endif
     std::cout << "All examples completed!" << std::endl;
     return 0;
 }
@@ -0,0 +1,146 @@
+#pragma once
+
+// Object pool handing out unique_ptrs whose deleter returns the slot.
+//
+//     ObjectPool<Widget> pool;
+//     PoolPtr<Widget> w = pool.make(42);   // Like std::make_unique<Widget>(42)
+//     w.reset();                           // ~Widget(), slot goes back to the pool
+//
+//     pool.reset();                        // End of frame/request: destroy
+//                                          // everything still alive at once
+//
+// Objects live in large slabs instead of one heap block each, so widgets made
+// one after another sit next to each other in memory and iterating over them
+// streams through cache lines instead of chasing pointers across the heap.
+// Freed slots are reused LIFO (the most recently freed slot is still warm).
+//
+// Rules:
+//   - The pool must outlive every PoolPtr it handed out
+//   - After reset(), older PoolPtrs are inert: destroying them does nothing
+//     (each deleter remembers the pool's epoch), but dereferencing them is
+//     use-after-free, just like a dangling raw pointer
+//   - Not thread-safe; use one pool per thread
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class ObjectPool {
+public:
+    class Deleter {
+    public:
+        Deleter() noexcept = default;
+        Deleter(ObjectPool* p, std::uint64_t e) noexcept : pool(p), epoch(e) {}
+
+        void operator()(T* object) const noexcept {
+            if (pool && epoch == pool->epoch) pool->destroy(object);
+        }
+
+    private:
+        ObjectPool* pool = nullptr;
+        std::uint64_t epoch = 0;
+    };
+
+    using Ptr = std::unique_ptr<T, Deleter>;
+
+    explicit ObjectPool(size_t slotsPerSlab = 1024) : slabSize(slotsPerSlab ? slotsPerSlab : 1) {}
+
+    ~ObjectPool() { reset(); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    Ptr make(Args&&... args) {
+        Slot* slot = acquire();
+        try {
+            ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            slot->next = freeList;  // Constructor threw: give the slot back
+            freeList = slot;
+            throw;
+        }
+        slot->live = true;
+        ++live;
+        return Ptr(slot->object(), Deleter(this, epoch));
+    }
+
+    // Destroy every live object and make all slots available again. Memory is
+    // kept; new objects are laid out from the start of the first slab again.
+    void reset() noexcept {
+        if (live) {
+            for (auto& slab : slabs) {
+                for (size_t i = 0; i < slabSize; ++i) {
+                    if (slab[i].live) {
+                        slab[i].object()->~T();
+                        slab[i].live = false;
+                    }
+                }
+            }
+        }
+        live = 0;
+        freeList = nullptr;
+        currentSlab = 0;
+        nextInSlab = 0;
+        ++epoch;
+    }
+
+    // Also releases the slabs themselves
+    void release() noexcept {
+        reset();
+        slabs.clear();
+    }
+
+    size_t liveCount() const { return live; }
+    size_t capacity() const { return slabs.size() * slabSize; }
+
+private:
+    struct Slot {
+        union {
+            Slot* next;  // While free
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        bool live = false;
+
+        T* object() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    size_t slabSize;
+    size_t currentSlab = 0;  // Bump position: slabs[currentSlab][nextInSlab]
+    size_t nextInSlab = 0;
+    Slot* freeList = nullptr;
+    size_t live = 0;
+    std::uint64_t epoch = 1;
+
+    Slot* acquire() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (nextInSlab == slabSize) {
+            ++currentSlab;
+            nextInSlab = 0;
+        }
+        if (currentSlab == slabs.size()) slabs.push_back(std::make_unique<Slot[]>(slabSize));
+        return &slabs[currentSlab][nextInSlab++];
+    }
+
+    void destroy(T* object) noexcept {
+        object->~T();
+        // storage is the first member, so the object's address is the slot's
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->live = false;
+        slot->next = freeList;
+        freeList = slot;
+        --live;
+    }
+};
+
+template <typename T>
+using PoolPtr = typename ObjectPool<T>::Ptr;
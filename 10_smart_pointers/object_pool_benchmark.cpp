@@ -0,0 +1,112 @@
+// make_unique per Widget vs ObjectPool: allocation throughput and iteration locality.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o object_pool_benchmark object_pool_benchmark.cpp
+//     ./object_pool_benchmark [widgets]      (default: 1000000)
+//
+// To model a long-running process, every widget allocation is interleaved with
+// an unrelated allocation of random size that stays alive, as other code would
+// do. That scatters make_unique'd widgets across the heap; pooled widgets stay
+// packed in their slabs. Iteration time per widget is a proxy for the cache-
+// miss rate (compare with `perf stat -e cache-misses` where available).
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "object_pool.h"
+
+// example.cpp's Widget without the logging
+class Widget {
+    int id;
+    double weight = 1.0;
+
+public:
+    explicit Widget(int i) : id(i) {}
+    int getId() const { return id; }
+    double getWeight() const { return weight; }
+};
+
+std::unique_ptr<Widget> createWidget(int id) { return std::make_unique<Widget>(id); }
+
+PoolPtr<Widget> createWidget(ObjectPool<Widget>& pool, int id) { return pool.make(id); }
+
+template <typename Container>
+double sumWidgets(const Container& widgets) {
+    double sum = 0.0;
+    for (const auto& w : widgets) sum += w->getId() * w->getWeight();
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    size_t n = std::max<size_t>(1, bench::argOr(argc, argv, 1, 1000000));
+    std::printf("=== Widget Allocation: make_unique vs ObjectPool (%zu widgets) ===\n\n", n);
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> junkSize(16, 256);
+    std::vector<std::unique_ptr<char[]>> junk;  // The "rest of the program"
+    junk.reserve(n);
+
+    // 1. Allocation + destruction throughput, no interference
+    double heapAllocNs = bench::bestOfNs([&] {
+        std::vector<std::unique_ptr<Widget>> widgets;
+        widgets.reserve(n);
+        for (size_t i = 0; i < n; ++i) widgets.push_back(createWidget(static_cast<int>(i)));
+        bench::doNotOptimize(widgets.data());
+    }, 3);
+
+    ObjectPool<Widget> pool(4096);
+    double poolAllocNs = bench::bestOfNs([&] {
+        std::vector<PoolPtr<Widget>> widgets;
+        widgets.reserve(n);
+        for (size_t i = 0; i < n; ++i) widgets.push_back(createWidget(pool, static_cast<int>(i)));
+        bench::doNotOptimize(widgets.data());
+    }, 3);  // Each PoolPtr returns its slot on the way out
+
+    double resetNs = bench::bestOfNs([&] {
+        std::vector<PoolPtr<Widget>> widgets;
+        widgets.reserve(n);
+        for (size_t i = 0; i < n; ++i) widgets.push_back(createWidget(pool, static_cast<int>(i)));
+        pool.reset();  // Bulk free; the handles below become inert
+        bench::doNotOptimize(widgets.data());
+    }, 3);
+
+    std::printf("create + destroy:\n");
+    std::printf("  %-34s %8.2f ns/widget\n", "make_unique / delete", heapAllocNs / n);
+    std::printf("  %-34s %8.2f ns/widget   (%.1fx)\n", "pool.make / slot return", poolAllocNs / n,
+                heapAllocNs / poolAllocNs);
+    std::printf("  %-34s %8.2f ns/widget   (%.1fx)\n\n", "pool.make / pool.reset()", resetNs / n,
+                heapAllocNs / resetNs);
+
+    // 2. Iteration after building on a busy heap
+    std::vector<std::unique_ptr<Widget>> heapWidgets;
+    std::vector<PoolPtr<Widget>> poolWidgets;
+    heapWidgets.reserve(n);
+    poolWidgets.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        heapWidgets.push_back(createWidget(static_cast<int>(i)));
+        poolWidgets.push_back(createWidget(pool, static_cast<int>(i)));
+        junk.push_back(std::make_unique<char[]>(junkSize(rng)));
+    }
+
+    double heapIterNs = bench::bestOfNs([&] { bench::doNotOptimize(sumWidgets(heapWidgets)); });
+    double poolIterNs = bench::bestOfNs([&] { bench::doNotOptimize(sumWidgets(poolWidgets)); });
+
+    auto spread = [](const auto& widgets) {
+        auto [lo, hi] = std::minmax_element(widgets.begin(), widgets.end(),
+            [](const auto& a, const auto& b) { return a.get() < b.get(); });
+        return (reinterpret_cast<const char*>(hi->get()) - reinterpret_cast<const char*>(lo->get())) /
+               (1024.0 * 1024.0);
+    };
+
+    std::printf("iterate (sum over all widgets) on a busy heap:\n");
+    std::printf("  %-34s %8.2f ns/widget   spread %8.1f MiB\n", "make_unique", heapIterNs / n,
+                spread(heapWidgets));
+    std::printf("  %-34s %8.2f ns/widget   spread %8.1f MiB   (%.1fx)\n", "ObjectPool",
+                poolIterNs / n, spread(poolWidgets), heapIterNs / poolIterNs);
+    std::printf("\nsizeof(Widget) = %zu, pool capacity %zu slots\n", sizeof(Widget),
+                pool.capacity());
+    return 0;
+}
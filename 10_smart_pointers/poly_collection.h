@@ -0,0 +1,93 @@
+#pragma once
+
+// Polymorphic collection without per-element heap objects or virtual calls.
+//
+//     PolyCollection<Dog, Cat> animals;
+//     animals.insert(Dog());
+//     animals.emplace<Cat>();
+//     animals.forEach([](auto& a) { a.makeSound(); });   // All Dogs, then all Cats
+//
+// vector<unique_ptr<Animal>> pays for every element twice: a pointer chase to
+// a separately allocated object, then a vtable load and an indirect call whose
+// target changes from element to element. Here each type has its own
+// contiguous vector and forEach() walks them one after another, so:
+//   - Elements are stored by value, next to each other
+//   - The visitor is instantiated once per type, so calls are direct and can
+//     be inlined; the branch predictor sees one target per batch
+//   - Classes that also derive from a virtual base should be marked `final`,
+//     which lets the compiler resolve even a virtual call at compile time
+//
+// The price: the set of types is fixed at compile time, and iteration order is
+// grouped by type rather than insertion order (use std::variant in a single
+// vector when order matters; see poly_collection_benchmark.cpp).
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename... Ts>
+class PolyCollection {
+    template <typename T>
+    static constexpr bool holds = (std::is_same_v<T, Ts> || ...);
+
+public:
+    template <typename T>
+    void insert(T&& value) {
+        using U = std::decay_t<T>;
+        static_assert(holds<U>, "type is not part of this PolyCollection");
+        segment<U>().push_back(std::forward<T>(value));
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        static_assert(holds<T>, "type is not part of this PolyCollection");
+        return segment<T>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    // Visit every element, one type at a time
+    template <typename F>
+    void forEach(F&& f) {
+        (forEachIn<Ts>(f), ...);
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        (forEachIn<Ts>(f), ...);
+    }
+
+    // Direct access to one type's elements, e.g. for a hand-written batch loop
+    template <typename T>
+    std::vector<T>& segment() {
+        return std::get<std::vector<T>>(segments);
+    }
+
+    template <typename T>
+    const std::vector<T>& segment() const {
+        return std::get<std::vector<T>>(segments);
+    }
+
+    size_t size() const { return (segment<Ts>().size() + ...); }
+    bool empty() const { return size() == 0; }
+
+    template <typename T>
+    void reserve(size_t n) {
+        segment<T>().reserve(n);
+    }
+
+    void clear() { (segment<Ts>().clear(), ...); }
+
+private:
+    std::tuple<std::vector<Ts>...> segments;
+
+    template <typename T, typename F>
+    void forEachIn(F& f) {
+        for (auto& item : segment<T>()) f(item);
+    }
+
+    template <typename T, typename F>
+    void forEachIn(F& f) const {
+        for (const auto& item : segment<T>()) f(item);
+    }
+};
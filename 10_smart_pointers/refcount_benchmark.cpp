@@ -0,0 +1,141 @@
+// Refcount and cache-miss overhead of a million-node linked list, by pointer type.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o refcount_benchmark refcount_benchmark.cpp
+//     ./refcount_benchmark [nodes]      (default: 1000000)
+//
+// For each pointer type, three phases are timed separately:
+//   build     - allocate and link the nodes
+//   traverse  - walk the list copying the owning pointer at every step, the way
+//               `for (auto p = head; p; p = p->next)` does (one refcount
+//               increment and decrement per node)
+//   rebuild   - tear the list down and build it again
+// Teardown is iterative: destroying a long list recursively through ~next
+// would overflow the stack with any of these pointer types.
+//
+// The table is printed twice. libstdc++ quietly uses non-atomic shared_ptr
+// counts while a process has never started a second thread, so the first
+// table can flatter shared_ptr. After a thread has existed, every copy pays
+// for the atomic read-modify-write.
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#include "../common/benchmark.h"
+#include "intrusive_ptr.h"
+
+struct SharedNode {
+    int data;
+    std::shared_ptr<SharedNode> next;
+    SharedNode* prev = nullptr;  // Same back link for every variant
+    explicit SharedNode(int d) : data(d) {}
+};
+
+template <typename Count>
+struct IntrusiveNode : RefCounted<IntrusiveNode<Count>, Count> {
+    int data;
+    IntrusivePtr<IntrusiveNode> next;
+    IntrusiveNode* prev = nullptr;
+    explicit IntrusiveNode(int d) : data(d) {}
+};
+
+struct MakeShared {
+    using Ptr = std::shared_ptr<SharedNode>;
+    static Ptr make(int d) { return std::make_shared<SharedNode>(d); }
+};
+
+// Separate control block: every copy touches a second cache line
+struct SharedFromNew {
+    using Ptr = std::shared_ptr<SharedNode>;
+    static Ptr make(int d) { return Ptr(new SharedNode(d)); }
+};
+
+template <typename Count>
+struct Intrusive {
+    using Ptr = IntrusivePtr<IntrusiveNode<Count>>;
+    static Ptr make(int d) { return makeIntrusive<IntrusiveNode<Count>>(d); }
+};
+
+template <typename Kind>
+typename Kind::Ptr build(size_t n) {
+    typename Kind::Ptr head = Kind::make(0);
+    auto* tail = head.get();
+    for (size_t i = 1; i < n; ++i) {
+        tail->next = Kind::make(static_cast<int>(i));
+        tail->next->prev = tail;
+        tail = tail->next.get();
+    }
+    return head;
+}
+
+// Unlink front to back so each node dies with an empty `next`
+template <typename Ptr>
+void destroy(Ptr& head) {
+    while (head) {
+        Ptr next = std::move(head->next);
+        head = std::move(next);
+    }
+}
+
+template <typename Ptr>
+long long traverseCopying(const Ptr& head) {
+    long long sum = 0;
+    for (Ptr p = head; p; p = p->next) sum += p->data;
+    return sum;
+}
+
+template <typename Kind>
+void run(const char* label, size_t n) {
+    typename Kind::Ptr head;
+    double buildNs = bench::bestOfNs([&] {
+        destroy(head);
+        head = build<Kind>(n);
+    }, 3);  // Includes tearing down the previous run's list
+
+    long long sum = 0;
+    double traverseNs = bench::bestOfNs([&] {
+        sum = traverseCopying(head);
+        bench::doNotOptimize(sum);
+    });
+
+    double rawNs = bench::bestOfNs([&] {
+        long long s = 0;
+        for (auto* p = head.get(); p; p = p->next.get()) s += p->data;
+        bench::doNotOptimize(s);
+    });
+
+    double rebuildNs = bench::bestOfNs([&] {
+        destroy(head);
+        head = build<Kind>(n);
+    }, 3);
+    destroy(head);
+
+    std::printf("%-30s %10.2f %14.2f %12.2f %10.2f   %s\n", label, buildNs / n,
+                traverseNs / n, rawNs / n, rebuildNs / n,
+                sum == static_cast<long long>(n * (n - 1) / 2) ? "ok" : "BAD SUM");
+}
+
+void runAll(size_t n) {
+    std::printf("%-30s %10s %14s %12s %10s\n", "pointer", "build", "copy-traverse",
+                "raw-traverse", "rebuild");
+    run<SharedFromNew>("shared_ptr(new Node)", n);
+    run<MakeShared>("make_shared", n);
+    run<Intrusive<AtomicRefCount>>("IntrusivePtr, atomic count", n);
+    run<Intrusive<LocalRefCount>>("IntrusivePtr, plain count", n);
+}
+
+int main(int argc, char** argv) {
+    size_t n = std::max<size_t>(1, bench::argOr(argc, argv, 1, 1000000));
+    std::printf("=== Linked List Refcount Benchmark (%zu nodes, ns per node) ===\n", n);
+    std::printf("sizeof: shared_ptr %zu, IntrusivePtr %zu bytes\n\n",
+                sizeof(std::shared_ptr<SharedNode>), sizeof(IntrusivePtr<IntrusiveNode<LocalRefCount>>));
+
+    std::printf("-- process has only ever had one thread --\n");
+    runAll(n);
+
+    std::thread([] {}).join();
+    std::printf("\n-- after starting a thread --\n");
+    runAll(n);
+    return 0;
+}
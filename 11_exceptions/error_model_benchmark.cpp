@@ -0,0 +1,209 @@
+// Error-path cost: throw/catch vs error codes vs Expected<T, E>, by failure rate.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o error_model_benchmark error_model_benchmark.cpp
+//     ./error_model_benchmark [calls]      (default: 200000 per cell)
+//
+// The operation is BankAccount::withdraw from 03_classes_basics: it fails with
+// "insufficient funds" for a chosen fraction of the calls (0% to 50%, in a
+// random pattern). The failure travels up through `depth` non-inlined frames,
+// each holding an object with a destructor, before the caller handles it:
+//   throw      - withdraw throws, one try/catch at the top
+//   error code - every frame returns an enum and fills an out-parameter
+//   Expected   - every frame returns Expected<double, WithdrawError>
+// Depth 1 is a direct call; depth 8 models a failure deep inside a request.
+
+#include <cstdio>
+#include <exception>
+#include <random>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/expected.h"
+
+enum class WithdrawError { None, InvalidAmount, InsufficientFunds };
+
+// Small, allocation-free exception, the fastest kind to throw
+class InsufficientFunds : public std::exception {
+public:
+    const char* what() const noexcept override { return "insufficient funds"; }
+};
+
+// Forces each frame to clean up on the error path, as real code does
+struct Guard {
+    double* sink;
+    ~Guard() { bench::doNotOptimize(*sink); }
+};
+
+struct Account {
+    double balance = 0;
+};
+
+// --- The three error models, same checks in each ---
+
+BENCH_NOINLINE double withdrawOrThrow(Account& a, double amount) {
+    if (amount > a.balance) throw InsufficientFunds();
+    a.balance -= amount;
+    return a.balance;
+}
+
+BENCH_NOINLINE WithdrawError withdrawCode(Account& a, double amount, double& newBalance) {
+    if (amount > a.balance) return WithdrawError::InsufficientFunds;
+    a.balance -= amount;
+    newBalance = a.balance;
+    return WithdrawError::None;
+}
+
+BENCH_NOINLINE Expected<double, WithdrawError> withdrawExpected(Account& a, double amount) {
+    if (amount > a.balance) return makeUnexpected(WithdrawError::InsufficientFunds);
+    a.balance -= amount;
+    return a.balance;
+}
+
+// --- Propagation through Depth - 1 intermediate frames ---
+
+template <int Depth>
+BENCH_NOINLINE double callThrow(Account& a, double amount) {
+    if constexpr (Depth == 1) {
+        return withdrawOrThrow(a, amount);
+    } else {
+        double local = amount;
+        Guard guard{&local};
+        return callThrow<Depth - 1>(a, amount) + 0.0 * local;
+    }
+}
+
+template <int Depth>
+BENCH_NOINLINE WithdrawError callCode(Account& a, double amount, double& newBalance) {
+    if constexpr (Depth == 1) {
+        return withdrawCode(a, amount, newBalance);
+    } else {
+        double local = amount;
+        Guard guard{&local};
+        WithdrawError e = callCode<Depth - 1>(a, amount, newBalance);
+        if (e != WithdrawError::None) return e;
+        newBalance += 0.0 * local;
+        return WithdrawError::None;
+    }
+}
+
+template <int Depth>
+BENCH_NOINLINE Expected<double, WithdrawError> callExpected(Account& a, double amount) {
+    if constexpr (Depth == 1) {
+        return withdrawExpected(a, amount);
+    } else {
+        double local = amount;
+        Guard guard{&local};
+        auto result = callExpected<Depth - 1>(a, amount);
+        if (!result) return result;
+        return *result + 0.0 * local;
+    }
+}
+
+// --- Driver ---
+
+struct Counts {
+    size_t ok = 0, failed = 0;
+    double balance = 0;
+};
+
+constexpr double kBalance = 100.0;
+
+// Amounts above the balance fail; successful withdrawals are deposited back
+std::vector<double> makeAmounts(size_t n, double failureRate, std::mt19937& rng) {
+    std::uniform_real_distribution<double> coin(0.0, 1.0), amount(1.0, 50.0);
+    std::vector<double> amounts(n);
+    for (double& a : amounts) a = coin(rng) < failureRate ? kBalance + amount(rng) : amount(rng);
+    return amounts;
+}
+
+template <int Depth>
+Counts runThrow(const std::vector<double>& amounts) {
+    Counts c;
+    Account account{kBalance};
+    for (double amount : amounts) {
+        try {
+            c.balance += callThrow<Depth>(account, amount);
+            account.balance += amount;
+            ++c.ok;
+        } catch (const InsufficientFunds&) {
+            ++c.failed;
+        }
+    }
+    return c;
+}
+
+template <int Depth>
+Counts runCode(const std::vector<double>& amounts) {
+    Counts c;
+    Account account{kBalance};
+    for (double amount : amounts) {
+        double newBalance = 0;
+        if (callCode<Depth>(account, amount, newBalance) == WithdrawError::None) {
+            c.balance += newBalance;
+            account.balance += amount;
+            ++c.ok;
+        } else {
+            ++c.failed;
+        }
+    }
+    return c;
+}
+
+template <int Depth>
+Counts runExpected(const std::vector<double>& amounts) {
+    Counts c;
+    Account account{kBalance};
+    for (double amount : amounts) {
+        if (auto result = callExpected<Depth>(account, amount)) {
+            c.balance += *result;
+            account.balance += amount;
+            ++c.ok;
+        } else {
+            ++c.failed;
+        }
+    }
+    return c;
+}
+
+template <typename Run>
+double timePerCall(const std::vector<double>& amounts, Run run, Counts& counts) {
+    double ns = bench::bestOfNs([&] {
+        counts = run(amounts);
+        bench::doNotOptimize(counts);
+    }, 3);
+    return ns / amounts.size();
+}
+
+template <int Depth>
+bool runDepth(size_t n) {
+    const double rates[] = {0.0, 0.001, 0.01, 0.1, 0.25, 0.5};
+    std::mt19937 rng(7);
+    bool ok = true;
+
+    std::printf("depth %d      %12s %12s %12s %10s\n", Depth, "throw", "error code", "Expected", "throw/Exp");
+    for (double rate : rates) {
+        std::vector<double> amounts = makeAmounts(n, rate, rng);
+        Counts t, c, e;
+        double throwNs = timePerCall(amounts, runThrow<Depth>, t);
+        double codeNs = timePerCall(amounts, runCode<Depth>, c);
+        double expectedNs = timePerCall(amounts, runExpected<Depth>, e);
+        bool same = t.failed == c.failed && c.failed == e.failed && t.balance == c.balance &&
+                    c.balance == e.balance;
+        ok = ok && same;
+        std::printf("  %5.1f%% fail %9.2f ns %9.2f ns %9.2f ns %9.1fx%s\n", rate * 100, throwNs, codeNs,
+                    expectedNs, throwNs / expectedNs, same ? "" : "   MISMATCH");
+    }
+    std::printf("\n");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 200000);
+    std::printf("=== Error Model Cost (ns per call, %zu calls per cell) ===\n\n", n);
+    bool ok = runDepth<1>(n);
+    ok = runDepth<8>(n) && ok;
+    std::printf("sizeof(Expected<double, WithdrawError>) = %zu, trivially copyable: %s\n",
+                sizeof(Expected<double, WithdrawError>),
+                std::is_trivially_copyable_v<Expected<double, WithdrawError>> ? "yes" : "no");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+// Per-element callback cost: std::function vs template vs FunctionRef vs batches.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -o callback_benchmark callback_benchmark.cpp
+//     ./callback_benchmark [ints]      (default: 100000000)
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "callbacks.h"
+
+// example.cpp's version
+void processData(const std::vector<int>& data, std::function<void(int)> callback) {
+    for (int value : data) {
+        callback(value);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 100000000);
+    std::vector<int> data(n);
+    for (size_t i = 0; i < n; ++i) data[i] = static_cast<int>(i % 1000);
+
+    std::int64_t expected = 0;
+    for (int v : data) expected += v;
+
+    std::printf("=== Callback Benchmark (%zu ints, sum of all values) ===\n", n);
+    std::printf("%-36s %10s %10s %8s\n", "path", "ms", "ns/elem", "ok");
+    double baselineNs = 0.0;
+    auto report = [&](const char* label, double ns, std::int64_t sum) {
+        if (baselineNs == 0.0) baselineNs = ns;
+        std::printf("%-36s %10.1f %10.3f %8s   %5.1fx\n", label, ns / 1e6, ns / n,
+                    sum == expected ? "yes" : "NO", baselineNs / ns);
+    };
+
+    std::int64_t sum = 0;
+    double ns = bench::bestOfNs([&] {
+        sum = 0;
+        processData(data, [&sum](int value) { sum += value; });
+        bench::doNotOptimize(sum);
+    }, 3);
+    report("std::function per element", ns, sum);
+
+    // A capture bigger than std::function's small buffer forces a heap allocation
+    // per call of processData; per element it costs the same as above.
+    ns = bench::bestOfNs([&] {
+        sum = 0;
+        std::int64_t pad[4] = {0, 0, 0, 0};
+        processData(data, [&sum, pad](int value) { sum += value + pad[value & 3]; });
+        bench::doNotOptimize(sum);
+    }, 3);
+    report("std::function, large capture", ns, sum);
+
+    ns = bench::bestOfNs([&] {
+        sum = 0;
+        forEachValueRef(data, [&sum](int value) { sum += value; });
+        bench::doNotOptimize(sum);
+    }, 3);
+    report("FunctionRef per element", ns, sum);
+
+    ns = bench::bestOfNs([&] {
+        sum = 0;
+        forEachValue(data, [&sum](int value) { sum += value; });
+        bench::doNotOptimize(sum);
+    }, 3);
+    report("template per element", ns, sum);
+
+    // Batches through a type-erased callback: one indirect call per 4096 ints
+    ns = bench::bestOfNs([&] {
+        sum = 0;
+        std::function<void(Span<const int>)> onBatch = [&sum](Span<const int> chunk) {
+            std::int64_t local = 0;
+            for (int value : chunk) local += value;
+            sum += local;
+        };
+        forEachBatch(data, onBatch);
+        bench::doNotOptimize(sum);
+    }, 3);
+    report("std::function per 4096-int batch", ns, sum);
+
+    ns = bench::bestOfNs([&] {
+        sum = 0;
+        forEachBatch(data, [&sum](Span<const int> chunk) {
+            std::int64_t local = 0;
+            for (int value : chunk) local += value;
+            sum += local;
+        });
+        bench::doNotOptimize(sum);
+    }, 3);
+    report("template per 4096-int batch", ns, sum);
+    return 0;
+}
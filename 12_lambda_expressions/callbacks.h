@@ -0,0 +1,47 @@
+#pragma once
+
+// Ways to hand a callback to a data-processing loop, cheapest last.
+//
+//   processData(data, std::function)  - example.cpp's version. Type-erased:
+//                                       one indirect call per element that
+//                                       the optimizer cannot inline, and
+//                                       large captures are heap-allocated.
+//   forEachValueRef(data, FunctionRef) - also type-erased, but non-owning:
+//                                       never allocates, still one indirect
+//                                       call per element. Keeps the loop out
+//                                       of the header (no template bloat).
+//   forEachValue(data, F&&)           - template: the callable's type is
+//                                       known, so the call is inlined and the
+//                                       loop can vectorize.
+//   forEachBatch(data, F&&, size)     - hands the callback whole chunks as
+//                                       Span<const int>: the per-call cost
+//                                       (erased or not) is paid once per
+//                                       chunk instead of once per element.
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "../common/function_ref.h"
+#include "../common/span.h"
+
+template <typename F>
+void forEachValue(Span<const int> data, F&& callback) {
+    for (int value : data) {
+        callback(value);
+    }
+}
+
+inline void forEachValueRef(Span<const int> data, FunctionRef<void(int)> callback) {
+    for (int value : data) {
+        callback(value);
+    }
+}
+
+template <typename F>
+void forEachBatch(Span<const int> data, F&& callback, size_t batchSize = 4096) {
+    batchSize = std::max<size_t>(batchSize, 1);
+    for (size_t offset = 0; offset < data.size(); offset += batchSize) {
+        callback(data.subspan(offset, std::min(batchSize, data.size() - offset)));
+    }
+}
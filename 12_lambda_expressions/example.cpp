@@ -2,6 +2,11 @@
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <memory>
+
+#include "callbacks.h"
+#include "parallel_algorithms.h"
+#include "task_scheduler.h"
 
 // Example 1: Basic lambda syntax
 void basicLambdas() {
@@ -128,6 +133,42 @@ void stlAlgorithms() {
     std::cout << std::endl;
 }
 
+// Example 4b: The same lambdas, run in parallel (see parallel_algorithms.h)
+void parallelStlAlgorithms() {
+    std::cout << "=== Parallel Lambdas with STL (" << par::kBackend << ") ===" << std::endl;
+
+    std::vector<int> numbers(1000000);
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        numbers[i] = static_cast<int>((i * 7919) % 1000);
+    }
+
+    par::sort(numbers.begin(), numbers.end(),
+        [](int a, int b) { return a > b; });
+    std::cout << "Largest after sort: " << numbers.front() << std::endl;
+
+    auto it = par::find_if(numbers.begin(), numbers.end(),
+        [](int n) { return n % 2 == 0; });
+    if (it != numbers.end()) {
+        std::cout << "First even: " << *it << std::endl;
+    }
+
+    auto count = par::count_if(numbers.begin(), numbers.end(),
+        [](int n) { return n > 5; });
+    std::cout << "Numbers > 5: " << count << std::endl;
+
+    std::vector<int> doubled(numbers.size());
+    par::transform(numbers.begin(), numbers.end(), doubled.begin(),
+        [](int n) { return n * 2; });
+    std::cout << "Doubled front: " << doubled.front() << std::endl;
+
+    // No printing here: parallel lambdas must not share std::cout
+    par::for_each(numbers.begin(), numbers.end(),
+        [](int& n) { n = n * n; });
+    std::cout << "Squared front: " << numbers.front() << std::endl;
+
+    std::cout << std::endl;
+}
+
 // Example 5: Generic lambdas (C++14)
 void genericLambdas() {
     std::cout << "=== Generic Lambdas ===" << std::endl;
@@ -175,7 +216,25 @@ void callbackExample() {
     processData(data, [](int value) {
         std::cout << value << " ";
     });
-    std::cout << std::endl << std::endl;
+    std::cout << std::endl;
+
+    // Same loop without std::function (see callbacks.h)
+    int templateSum = 0;
+    forEachValue(data, [&templateSum](int value) { templateSum += value; });  // Inlined
+
+    int refSum = 0;
+    forEachValueRef(data, [&refSum](int value) { refSum += value; });  // Never allocates
+
+    int batchSum = 0;
+    int batches = 0;
+    forEachBatch(data, [&](Span<const int> chunk) {  // One call per 2 values
+        ++batches;
+        for (int value : chunk) batchSum += value;
+    }, 2);
+
+    std::cout << "Template sum: " << templateSum << ", function_ref sum: " << refSum
+              << ", batched sum: " << batchSum << " (" << batches << " batches)"
+              << std::endl << std::endl;
 }
 
 // Example 7: Immediately Invoked Lambda Expression
@@ -229,15 +288,48 @@ void initCapture() {
     std::cout << std::endl;
 }
 
+// Example 9: Running lambdas concurrently (see task_scheduler.h)
+void taskScheduler() {
+    std::cout << "=== Work-Stealing Task Scheduler ===" << std::endl;
+
+    tasks::TaskScheduler scheduler(4);
+
+    // Move-only init capture works: a task is not a std::function
+    auto data = std::make_unique<std::vector<int>>(1000, 3);
+    tasks::Future<int> total = scheduler.submit([data = std::move(data)]() {
+        int sum = 0;
+        for (int v : *data) sum += v;
+        return sum;
+    });
+
+    // Continuation: runs as soon as `total` is ready
+    tasks::Future<double> average = total.then([](int sum) {
+        return sum / 1000.0;
+    });
+    std::cout << "Average from continuation: " << average.get() << std::endl;
+
+    std::vector<int> squares(100000);
+    scheduler.parallel_for(0, squares.size(), 1024, [&squares](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            squares[i] = static_cast<int>(i % 1000) * static_cast<int>(i % 1000);
+        }
+    });
+    std::cout << "squares[999] = " << squares[999] << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main() {
     basicLambdas();
     captureExamples();
     mutableLambdas();
     stlAlgorithms();
+    parallelStlAlgorithms();
     genericLambdas();
     callbackExample();
     iile();
     initCapture();
+    taskScheduler();
     
     std::cout << "All lambda examples completed!" << std::endl;
     return 0;
@@ -0,0 +1,331 @@
+#pragma once
+
+// Parallel versions of the algorithms used in example.cpp's stlAlgorithms().
+//
+//     par::sort(v.begin(), v.end(), [](int a, int b) { return a > b; });
+//     auto n = par::count_if(v.begin(), v.end(), [](int x) { return x > 5; });
+//
+// Where the standard library ships a real parallel backend, each call
+// forwards to the std:: algorithm with std::execution::par_unseq. Elsewhere
+// (MinGW, libc++ without PSTL, libstdc++ without TBB - where par_unseq
+// silently runs serially) it uses the small fork-join ThreadPool below.
+//
+// Build flags:
+//   PAR_FORCE_THREAD_POOL  - always use the built-in pool
+//   PAR_USE_TBB            - libstdc++ only: its par_unseq backend is TBB, so
+//                            it is opt-in (-DPAR_USE_TBB ... -ltbb) to keep
+//                            the plain one-line builds linking
+//
+// As with par_unseq itself, the lambdas must be safe to run concurrently and
+// must not lock or do I/O (no printing from for_each's lambda).
+// Inputs shorter than kSerialCutoff always run serially: below that, waking
+// threads costs more than the work itself.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/function_ref.h"
+
+// Merely including libstdc++'s <execution> pulls in TBB symbols when TBB's
+// headers are installed, so the header is only included where it is used.
+#if !defined(PAR_FORCE_THREAD_POOL) && defined(__has_include)
+#if __has_include(<execution>) && (!defined(__GLIBCXX__) || defined(PAR_USE_TBB))
+#include <execution>
+#if defined(__cpp_lib_execution) && (!defined(__GLIBCXX__) || defined(_PSTL_PAR_BACKEND_TBB))
+#define PAR_USE_STD_EXECUTION 1
+#endif
+#endif
+#endif
+
+namespace par {
+
+inline constexpr size_t kSerialCutoff = 1 << 14;
+
+// Fork-join pool: run(tasks, fn) calls fn(0) ... fn(tasks - 1) spread over the
+// worker threads plus the calling thread, and returns when all have finished.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        for (unsigned i = 1; i < threads; ++i) {  // The caller is thread number 0
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    void run(size_t tasks, FunctionRef<void(size_t)> task) {
+        if (tasks == 0) return;
+        if (tasks == 1 || workers.empty() || insidePool) {  // Nested calls run inline
+            for (size_t i = 0; i < tasks; ++i) task(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> serialize(runMutex);  // One job at a time
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return busyWorkers == 0; });
+            job = &task;
+            taskCount = tasks;
+            nextTask.store(0, std::memory_order_relaxed);
+            remaining.store(tasks, std::memory_order_relaxed);
+            error = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+
+        insidePool = true;
+        runTasks(task);
+        insidePool = false;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] {
+            return remaining.load(std::memory_order_acquire) == 0 && busyWorkers == 0;
+        });
+        job = nullptr;
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+
+    // Shared process-wide pool used by the par:: algorithms
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex runMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    FunctionRef<void(size_t)>* job = nullptr;
+    size_t taskCount = 0;
+    std::atomic<size_t> nextTask{0};
+    std::atomic<size_t> remaining{0};
+    unsigned busyWorkers = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    static inline thread_local bool insidePool = false;  // Running a task of some pool
+
+    void runTasks(FunctionRef<void(size_t)> task) {
+        for (;;) {
+            size_t i = nextTask.fetch_add(1, std::memory_order_relaxed);
+            if (i >= taskCount) return;
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    void workerLoop() {
+        insidePool = true;
+        unsigned long long seen = 0;
+        for (;;) {
+            FunctionRef<void(size_t)>* current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                if (!job) continue;  // Woke after that job already finished
+                current = job;
+                ++busyWorkers;
+            }
+            runTasks(*current);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --busyWorkers;
+            }
+            done.notify_all();
+        }
+    }
+};
+
+namespace detail {
+
+// Split [0, n) into about 4 chunks per thread; returns the chunk count
+inline size_t chunkCount(size_t n, const ThreadPool& pool) {
+    size_t chunks = static_cast<size_t>(pool.size()) * 4;
+    return std::max<size_t>(1, std::min(chunks, n / (kSerialCutoff / 4)));
+}
+
+inline size_t chunkBegin(size_t n, size_t chunks, size_t i) { return n * i / chunks; }
+
+}  // namespace detail
+
+// Explicit-pool versions: these never use std::execution, so benchmarks can
+// control the thread count. The par:: functions below pick the best backend.
+namespace pool {
+
+template <typename RandomIt, typename F>
+void for_each(ThreadPool& threads, RandomIt first, RandomIt last, F f) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < kSerialCutoff) return void(std::for_each(first, last, f));
+    size_t chunks = detail::chunkCount(n, threads);
+    threads.run(chunks, [&](size_t c) {
+        std::for_each(first + detail::chunkBegin(n, chunks, c),
+                      first + detail::chunkBegin(n, chunks, c + 1), f);
+    });
+}
+
+template <typename RandomIt, typename OutIt, typename F>
+OutIt transform(ThreadPool& threads, RandomIt first, RandomIt last, OutIt out, F f) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < kSerialCutoff) return std::transform(first, last, out, f);
+    size_t chunks = detail::chunkCount(n, threads);
+    threads.run(chunks, [&](size_t c) {
+        size_t lo = detail::chunkBegin(n, chunks, c);
+        size_t hi = detail::chunkBegin(n, chunks, c + 1);
+        std::transform(first + lo, first + hi, out + lo, f);
+    });
+    return out + n;
+}
+
+template <typename RandomIt, typename Pred>
+typename std::iterator_traits<RandomIt>::difference_type
+count_if(ThreadPool& threads, RandomIt first, RandomIt last, Pred pred) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < kSerialCutoff) return std::count_if(first, last, pred);
+    size_t chunks = detail::chunkCount(n, threads);
+    std::vector<typename std::iterator_traits<RandomIt>::difference_type> counts(chunks);
+    threads.run(chunks, [&](size_t c) {
+        counts[c] = std::count_if(first + detail::chunkBegin(n, chunks, c),
+                                  first + detail::chunkBegin(n, chunks, c + 1), pred);
+    });
+    typename std::iterator_traits<RandomIt>::difference_type total = 0;
+    for (auto count : counts) total += count;
+    return total;
+}
+
+// Chunks are claimed in order, so once a match is known, later chunks are skipped
+template <typename RandomIt, typename Pred>
+RandomIt find_if(ThreadPool& threads, RandomIt first, RandomIt last, Pred pred) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < kSerialCutoff) return std::find_if(first, last, pred);
+    size_t chunks = detail::chunkCount(n, threads) * 4;  // Finer: earlier exit
+    std::atomic<size_t> best{n};
+    threads.run(chunks, [&](size_t c) {
+        size_t lo = detail::chunkBegin(n, chunks, c);
+        size_t hi = detail::chunkBegin(n, chunks, c + 1);
+        if (lo >= best.load(std::memory_order_relaxed)) return;
+        RandomIt hit = std::find_if(first + lo, first + hi, pred);
+        size_t index = static_cast<size_t>(hit - first);
+        if (index == hi) return;
+        size_t current = best.load(std::memory_order_relaxed);
+        while (index < current && !best.compare_exchange_weak(current, index)) {
+        }
+    });
+    return first + best.load();
+}
+
+// Sort one chunk per task, then merge neighbouring runs pairwise in parallel
+template <typename RandomIt, typename Compare>
+void sort(ThreadPool& threads, RandomIt first, RandomIt last, Compare comp) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < kSerialCutoff || threads.size() == 1) return std::sort(first, last, comp);
+
+    size_t runs = 1;
+    while (runs < threads.size() && n / (runs * 2) >= kSerialCutoff) runs *= 2;
+    threads.run(runs, [&](size_t r) {
+        std::sort(first + detail::chunkBegin(n, runs, r),
+                  first + detail::chunkBegin(n, runs, r + 1), comp);
+    });
+
+    for (size_t width = 1; width < runs; width *= 2) {
+        threads.run(runs / (width * 2), [&](size_t pair) {
+            size_t lo = pair * width * 2;
+            std::inplace_merge(first + detail::chunkBegin(n, runs, lo),
+                               first + detail::chunkBegin(n, runs, lo + width),
+                               first + detail::chunkBegin(n, runs, lo + width * 2), comp);
+        });
+    }
+}
+
+}  // namespace pool
+
+#if defined(PAR_USE_STD_EXECUTION)
+inline constexpr const char* kBackend = "std::execution::par_unseq";
+
+template <typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+    std::sort(std::execution::par_unseq, first, last, comp);
+}
+
+template <typename RandomIt, typename Pred>
+RandomIt find_if(RandomIt first, RandomIt last, Pred pred) {
+    return std::find_if(std::execution::par_unseq, first, last, pred);
+}
+
+template <typename RandomIt, typename Pred>
+auto count_if(RandomIt first, RandomIt last, Pred pred) {
+    return std::count_if(std::execution::par_unseq, first, last, pred);
+}
+
+template <typename RandomIt, typename OutIt, typename F>
+OutIt transform(RandomIt first, RandomIt last, OutIt out, F f) {
+    return std::transform(std::execution::par_unseq, first, last, out, f);
+}
+
+template <typename RandomIt, typename F>
+void for_each(RandomIt first, RandomIt last, F f) {
+    std::for_each(std::execution::par_unseq, first, last, f);
+}
+#else
+inline constexpr const char* kBackend = "built-in thread pool";
+
+template <typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+    pool::sort(ThreadPool::instance(), first, last, comp);
+}
+
+template <typename RandomIt, typename Pred>
+RandomIt find_if(RandomIt first, RandomIt last, Pred pred) {
+    return pool::find_if(ThreadPool::instance(), first, last, pred);
+}
+
+template <typename RandomIt, typename Pred>
+auto count_if(RandomIt first, RandomIt last, Pred pred) {
+    return pool::count_if(ThreadPool::instance(), first, last, pred);
+}
+
+template <typename RandomIt, typename OutIt, typename F>
+OutIt transform(RandomIt first, RandomIt last, OutIt out, F f) {
+    return pool::transform(ThreadPool::instance(), first, last, out, f);
+}
+
+template <typename RandomIt, typename F>
+void for_each(RandomIt first, RandomIt last, F f) {
+    pool::for_each(ThreadPool::instance(), first, last, f);
+}
+#endif
+
+}  // namespace par
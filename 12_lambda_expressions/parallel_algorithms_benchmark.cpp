@@ -0,0 +1,127 @@
+// Where does going parallel pay off? Speedup of the stlAlgorithms() pipeline
+// against input size and thread count.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o parallel_algorithms_benchmark parallel_algorithms_benchmark.cpp
+//     ./parallel_algorithms_benchmark [max_elements] [max_threads]
+//         defaults: 10000000 elements, threads up to hardware_concurrency
+//
+// Thread-count columns use the built-in pool with exactly that many threads.
+// The "par::" column is the default backend (add -DPAR_USE_TBB ... -ltbb to
+// measure libstdc++'s par_unseq instead). Values are speedups over serial std::.
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "parallel_algorithms.h"
+
+struct PipelineResult {
+    long long firstEven;
+    long long countAbove5;
+    long long checksum;
+
+    bool operator==(const PipelineResult& o) const {
+        return firstEven == o.firstEven && countAbove5 == o.countAbove5 && checksum == o.checksum;
+    }
+};
+
+// The example's pipeline: sort, find_if, count_if, transform, for_each
+struct Serial {
+    template <typename It, typename C> void sort(It f, It l, C c) { std::sort(f, l, c); }
+    template <typename It, typename P> It find_if(It f, It l, P p) { return std::find_if(f, l, p); }
+    template <typename It, typename P> auto count_if(It f, It l, P p) { return std::count_if(f, l, p); }
+    template <typename It, typename O, typename F> void transform(It f, It l, O o, F fn) { std::transform(f, l, o, fn); }
+    template <typename It, typename F> void for_each(It f, It l, F fn) { std::for_each(f, l, fn); }
+};
+
+struct DefaultParallel {
+    template <typename It, typename C> void sort(It f, It l, C c) { par::sort(f, l, c); }
+    template <typename It, typename P> It find_if(It f, It l, P p) { return par::find_if(f, l, p); }
+    template <typename It, typename P> auto count_if(It f, It l, P p) { return par::count_if(f, l, p); }
+    template <typename It, typename O, typename F> void transform(It f, It l, O o, F fn) { par::transform(f, l, o, fn); }
+    template <typename It, typename F> void for_each(It f, It l, F fn) { par::for_each(f, l, fn); }
+};
+
+struct PoolParallel {
+    par::ThreadPool& pool;
+    template <typename It, typename C> void sort(It f, It l, C c) { par::pool::sort(pool, f, l, c); }
+    template <typename It, typename P> It find_if(It f, It l, P p) { return par::pool::find_if(pool, f, l, p); }
+    template <typename It, typename P> auto count_if(It f, It l, P p) { return par::pool::count_if(pool, f, l, p); }
+    template <typename It, typename O, typename F> void transform(It f, It l, O o, F fn) { par::pool::transform(pool, f, l, o, fn); }
+    template <typename It, typename F> void for_each(It f, It l, F fn) { par::pool::for_each(pool, f, l, fn); }
+};
+
+template <typename Backend>
+PipelineResult runPipeline(Backend&& backend, std::vector<int>& numbers, std::vector<int>& doubled) {
+    backend.sort(numbers.begin(), numbers.end(), [](int a, int b) { return a > b; });
+    auto it = backend.find_if(numbers.begin(), numbers.end(), [](int n) { return n % 2 == 0; });
+    long long count = backend.count_if(numbers.begin(), numbers.end(), [](int n) { return n > 5; });
+    backend.transform(numbers.begin(), numbers.end(), doubled.begin(), [](int n) { return n * 2; });
+    backend.for_each(numbers.begin(), numbers.end(), [](int& n) { n = n * n; });
+    long long firstEven = it == numbers.end() ? -1 : static_cast<long long>(it - numbers.begin());
+    return {firstEven, count, static_cast<long long>(numbers.back()) + doubled[doubled.size() / 2]};
+}
+
+// Best-of timing; the unsorted input is copied back (untimed) before every run
+template <typename Backend>
+double timePipeline(Backend&& backend, const std::vector<int>& input, PipelineResult& result) {
+    std::vector<int> numbers(input.size());
+    std::vector<int> doubled(input.size());
+    double best = 0.0;
+    for (int rep = 0; rep < 3; ++rep) {
+        numbers = input;
+        auto start = bench::Clock::now();  // Not bestOfNs: the copy must stay untimed
+        result = runPipeline(backend, numbers, doubled);
+        bench::clobberMemory();
+        double ns = std::chrono::duration<double, std::nano>(bench::Clock::now() - start).count();
+        if (rep == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t maxElements = bench::argOr(argc, argv, 1, 10000000);
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned maxThreads = static_cast<unsigned>(std::max<size_t>(1, bench::argOr(argc, argv, 2, hw)));
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    std::vector<std::unique_ptr<par::ThreadPool>> pools;
+    for (unsigned t : threadCounts) pools.push_back(std::make_unique<par::ThreadPool>(t));
+
+    std::printf("=== Parallel stlAlgorithms Scaling (%u hardware threads, default backend: %s) ===\n",
+                hw, par::kBackend);
+    std::printf("speedup over serial std:: algorithms (>1.0 = parallel wins)\n\n");
+    std::printf("%12s %12s", "elements", "serial ms");
+    for (unsigned t : threadCounts) std::printf("   %2u thr", t);
+    std::printf("   par::   ok\n");
+
+    for (size_t n = 1000; n <= maxElements; n *= 10) {
+        std::vector<int> input(n);
+        // Below 46341, so the for_each step's n * n fits in int
+        for (size_t i = 0; i < n; ++i) input[i] = static_cast<int>((i * 2654435761u) % 40000);
+
+        PipelineResult expected{};
+        timePipeline(Serial{}, input, expected);  // Warm-up: page faults, caches
+        double serialNs = timePipeline(Serial{}, input, expected);
+        std::printf("%12zu %12.3f", n, serialNs / 1e6);
+
+        bool ok = true;
+        for (auto& pool : pools) {
+            PipelineResult result{};
+            double ns = timePipeline(PoolParallel{*pool}, input, result);
+            ok = ok && result == expected;
+            std::printf(" %8.2f", serialNs / ns);
+        }
+        PipelineResult result{};
+        double ns = timePipeline(DefaultParallel{}, input, result);
+        ok = ok && result == expected;
+        std::printf(" %7.2f %4s\n", serialNs / ns, ok ? "yes" : "NO");
+    }
+    return 0;
+}
@@ -0,0 +1,587 @@
+#pragma once
+
+// Work-stealing task scheduler.
+//
+//     TaskScheduler scheduler;                              // One worker per core
+//     auto data = std::make_unique<Data>(...);
+//     Future<int> f = scheduler.submit([d = std::move(data)] { return d->size(); });
+//     Future<int> g = f.then([](int n) { return n * 2; });  // Runs when f is done
+//     scheduler.parallel_for(0, n, 1024, [&](size_t lo, size_t hi) { ... });
+//     int result = g.get();
+//
+// Design:
+//   - Every worker owns a Chase-Lev deque. Tasks spawned by a worker are
+//     pushed onto and popped from its bottom (LIFO, cache-warm); idle workers
+//     steal from the top of other workers' deques. No global queue or lock.
+//   - Tasks submitted from outside the pool go into one shared injection
+//     inbox: pushing is lock-free, and whichever worker finds it non-empty
+//     takes a batch under a mutex and moves it onto its own deque, where the
+//     others can steal it. Any worker woken for an external task can run it.
+//   - A task is one allocation holding the lambda itself (move-only captures
+//     are fine). There is no std::function and no separate queue node.
+//   - get() and parallel_for() called on a worker keep running other tasks
+//     while they wait, so nested parallelism cannot deadlock the pool.
+//
+// Tasks started with spawn() must not throw (like std::thread, the program
+// terminates). submit() and parallel_for() forward exceptions to the caller.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tasks {
+
+class Task {
+public:
+    virtual ~Task() = default;
+    virtual void run() = 0;
+
+    std::atomic<Task*> next{nullptr};  // Inbox link
+};
+
+template <typename F>
+class FunctionTask final : public Task {
+public:
+    template <typename G>
+    explicit FunctionTask(G&& g) : fn(std::forward<G>(g)) {}
+    void run() override { fn(); }
+
+private:
+    F fn;
+};
+
+template <typename F>
+Task* makeTask(F&& f) {
+    return new FunctionTask<std::decay_t<F>>(std::forward<F>(f));
+}
+
+// Chase-Lev deque (Le, Pop, Cohen, Zappa Nardelli 2013: "Correct and
+// Efficient Work-Stealing for Weak Memory Models"). push/pop: owner thread
+// only. steal: any thread. Grows by doubling; old rings stay alive until the
+// deque is destroyed because a thief may still be reading one.
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity = 1024) {
+        rings.push_back(std::make_unique<Ring>(capacity));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void push(Task* task) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        Ring* r = ring.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(r->capacity) - 1) r = grow(r, t, b);
+        r->put(b, task);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    Task* pop() {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {  // Empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Task* task = r->get(b);
+        if (t == b) {  // Last element: race the thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    Task* steal() {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+
+        Task* task = ring.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return nullptr;  // Lost the race to the owner or another thief
+        }
+        return task;
+    }
+
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Ring {
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+
+        explicit Ring(size_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<Task*>[cap]) {}
+
+        Task* get(std::int64_t i) const {
+            return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t i, Task* task) {
+            slots[static_cast<size_t>(i) & mask].store(task, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    alignas(64) std::atomic<Ring*> ring{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings;  // Owner only
+
+    Ring* grow(Ring* old, std::int64_t t, std::int64_t b) {
+        rings.push_back(std::make_unique<Ring>(old->capacity * 2));
+        Ring* bigger = rings.back().get();
+        for (std::int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+};
+
+// Vyukov's intrusive multi-producer / single-consumer queue. push: any
+// thread, wait-free. pop: one thread at a time (the caller serializes).
+class TaskInbox {
+public:
+    TaskInbox() : head(&stub), tail(&stub) {}
+
+    void push(Task* task) {
+        task->next.store(nullptr, std::memory_order_relaxed);
+        Task* prev = head.exchange(task, std::memory_order_acq_rel);
+        prev->next.store(task, std::memory_order_release);
+    }
+
+    // May return nullptr while a push is half-done; that producer wakes us after
+    Task* pop() {
+        Task* t = tail;
+        Task* next = t->next.load(std::memory_order_acquire);
+        if (t == &stub) {
+            if (!next) return nullptr;
+            tail = next;
+            t = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail = next;
+            return t;
+        }
+        if (t != head.load(std::memory_order_acquire)) return nullptr;
+        push(&stub);
+        next = t->next.load(std::memory_order_acquire);
+        if (next) {
+            tail = next;
+            return t;
+        }
+        return nullptr;
+    }
+
+private:
+    struct Stub final : Task {
+        void run() override {}
+    };
+
+    Stub stub;
+    alignas(64) std::atomic<Task*> head;
+    alignas(64) Task* tail;
+};
+
+class TaskScheduler;
+
+namespace detail {
+
+struct Empty {};
+
+template <typename T>
+struct SharedState {
+    using Stored = std::conditional_t<std::is_void_v<T>, Empty, T>;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<bool> ready{false};
+    std::optional<Stored> value;
+    std::exception_ptr error;
+    std::vector<Task*> continuations;  // Guarded by mutex
+};
+
+}  // namespace detail
+
+template <typename T>
+class Future {
+public:
+    Future() = default;
+
+    bool valid() const { return state != nullptr; }
+    bool ready() const { return state && state->ready.load(std::memory_order_acquire); }
+
+    void wait() const;
+
+    // Waits, then returns the result (or rethrows the task's exception). Once.
+    T get() {
+        wait();
+        auto s = std::move(state);
+        if (s->error) std::rethrow_exception(s->error);
+        if constexpr (!std::is_void_v<T>) return std::move(*s->value);
+    }
+
+    // Schedule f(result) to run when this future is ready. Like the
+    // Concurrency TS, this consumes the future: use the returned one instead.
+    template <typename F>
+    auto then(F&& f);
+
+private:
+    friend class TaskScheduler;
+    template <typename U>
+    friend class Future;  // then() builds a Future of the continuation's type
+
+    std::shared_ptr<detail::SharedState<T>> state;
+    TaskScheduler* scheduler = nullptr;
+
+    Future(std::shared_ptr<detail::SharedState<T>> s, TaskScheduler* owner)
+        : state(std::move(s)), scheduler(owner) {}
+};
+
+class TaskScheduler {
+public:
+    explicit TaskScheduler(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        threads = std::max(1u, threads);
+        for (unsigned i = 0; i < threads; ++i) workers.push_back(std::make_unique<Worker>());
+        for (unsigned i = 0; i < threads; ++i) {
+            workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+        }
+    }
+
+    // Finishes every task already scheduled (including continuations), then stops
+    ~TaskScheduler() {
+        waitIdle();
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        sleepCv.notify_all();
+        for (auto& w : workers) w->thread.join();
+    }
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    // Fire-and-forget
+    template <typename F>
+    void spawn(F&& f) {
+        schedule(makeTask(std::forward<F>(f)));
+    }
+
+    template <typename F>
+    auto submit(F&& f) -> Future<std::invoke_result_t<std::decay_t<F>&>> {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        auto state = std::make_shared<detail::SharedState<R>>();
+        schedule(makeTask([state, fn = std::forward<F>(f)]() mutable {
+            fulfill(*state, fn);
+        }));
+        return Future<R>(std::move(state), this);
+    }
+
+    // body(lo, hi) over [begin, end) split into chunks of at most `grain`.
+    // Ranges are split recursively, so stealing hands out big halves first.
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& body) {
+        if (begin >= end) return;
+        grain = std::max<size_t>(grain, 1);
+        ForkJoin group;
+        splitRange(group, begin, end, grain, body);
+        waitFor([&] { return group.pending.load(std::memory_order_acquire) == 0; });
+        if (group.error) std::rethrow_exception(group.error);
+    }
+
+    // Block until no scheduled task is left
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        idleCv.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+
+    // Run queued tasks on this thread until `done()` holds. Workers help; other
+    // threads steal too, and back off with yield when there is nothing to do.
+    template <typename Pred>
+    void waitFor(Pred done) {
+        while (!done()) {
+            if (Task* task = findWork(currentWorker())) {
+                execute(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool onWorkerThread() const { return currentWorker() != nullptr; }
+
+private:
+    template <typename T>
+    friend class Future;
+
+    struct Worker {
+        WorkStealingDeque deque;
+        std::thread thread;
+        std::uint64_t rng = 0;
+    };
+
+    struct ForkJoin {
+        std::atomic<size_t> pending{0};
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+
+    static constexpr size_t kInjectBatch = 32;  // Tasks taken from the inbox at once
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> pending{0};  // Scheduled but not yet finished
+
+    TaskInbox inbox;                  // Tasks scheduled from outside the pool
+    std::mutex inboxMutex;            // Serializes inbox.pop()
+    std::atomic<size_t> injected{0};  // Pushed but not yet popped
+    std::atomic<size_t> nextVictim{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+    std::condition_variable idleCv;
+    std::atomic<std::uint64_t> epoch{0};  // Bumped on every schedule()
+    std::atomic<unsigned> sleepers{0};
+    bool stopping = false;
+
+    static inline thread_local TaskScheduler* currentScheduler = nullptr;
+    static inline thread_local Worker* currentWorkerSlot = nullptr;
+
+    Worker* currentWorker() const {
+        return currentScheduler == this ? currentWorkerSlot : nullptr;
+    }
+
+    void schedule(Task* task) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        if (Worker* self = currentWorker()) {
+            self->deque.push(task);
+        } else {
+            inbox.push(task);
+            injected.fetch_add(1, std::memory_order_release);
+        }
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            sleepCv.notify_one();
+        }
+    }
+
+    void execute(Task* task) {
+        task->run();
+        delete task;
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            idleCv.notify_all();
+        }
+    }
+
+    Task* findWork(Worker* self) {
+        if (self) {
+            if (Task* task = self->deque.pop()) return task;
+        }
+        if (Task* task = takeInjected(self)) return task;
+        return stealFromOthers(self);
+    }
+
+    // One task from the shared inbox; a worker also moves up to a batch more
+    // onto its deque so that idle workers can steal them
+    Task* takeInjected(Worker* self) {
+        if (injected.load(std::memory_order_acquire) == 0) return nullptr;
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        Task* first = inbox.pop();  // nullptr while a push is half-done; its epoch bump follows
+        if (!first) return nullptr;
+        size_t taken = 1;
+        if (self) {
+            for (; taken < kInjectBatch; ++taken) {
+                Task* task = inbox.pop();
+                if (!task) break;
+                self->deque.push(task);
+            }
+        }
+        injected.fetch_sub(taken, std::memory_order_relaxed);
+        return first;
+    }
+
+    Task* stealFromOthers(Worker* self) {
+        size_t n = workers.size();
+        size_t start = self ? static_cast<size_t>(nextRandom(*self) % n)
+                            : nextVictim.fetch_add(1, std::memory_order_relaxed) % n;
+        for (size_t k = 0; k < n; ++k) {
+            Worker& victim = *workers[(start + k) % n];
+            if (&victim == self) continue;
+            if (Task* task = victim.deque.steal()) return task;
+        }
+        return nullptr;
+    }
+
+    static std::uint64_t nextRandom(Worker& w) {  // xorshift64
+        w.rng ^= w.rng << 13;
+        w.rng ^= w.rng >> 7;
+        w.rng ^= w.rng << 17;
+        return w.rng;
+    }
+
+    void workerLoop(unsigned index) {
+        Worker& self = *workers[index];
+        self.rng = 0x9E3779B97F4A7C15ull * (index + 1);
+        currentScheduler = this;
+        currentWorkerSlot = &self;
+
+        for (;;) {
+            std::uint64_t seen = epoch.load(std::memory_order_seq_cst);
+            if (Task* task = findWork(&self)) {
+                execute(task);
+                continue;
+            }
+
+            // Spin briefly before sleeping: fine-grained work arrives in bursts
+            bool found = false;
+            for (int spin = 0; spin < 64 && !found; ++spin) {
+                std::this_thread::yield();
+                if (Task* task = findWork(&self)) {
+                    execute(task);
+                    found = true;
+                }
+            }
+            if (found) continue;
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            // Anything scheduled since `seen` bumped the epoch: don't sleep on it
+            sleepCv.wait(lock, [&] {
+                return stopping || epoch.load(std::memory_order_seq_cst) != seen;
+            });
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (stopping && pending.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    template <typename F>
+    void splitRange(ForkJoin& group, size_t lo, size_t hi, size_t grain, F& body) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        Task* task = makeTask([this, &group, lo, hi, grain, &body] {
+            runRange(group, lo, hi, grain, body);
+        });
+        schedule(task);
+    }
+
+    template <typename F>
+    void runRange(ForkJoin& group, size_t lo, size_t hi, size_t grain, F& body) {
+        while (hi - lo > grain) {  // Keep the left half, offer the right half
+            size_t mid = lo + (hi - lo) / 2;
+            splitRange(group, mid, hi, grain, body);
+            hi = mid;
+        }
+        try {
+            body(lo, hi);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(group.mutex);
+            if (!group.error) group.error = std::current_exception();
+        }
+        group.pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    template <typename T, typename F>
+    static void fulfill(detail::SharedState<T>& state, F& fn) {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                fn();
+                state.value.emplace();
+            } else {
+                state.value.emplace(fn());
+            }
+        } catch (...) {
+            state.error = std::current_exception();
+        }
+        publish(state);
+    }
+
+    template <typename T>
+    static void publish(detail::SharedState<T>& state) {
+        std::vector<Task*> continuations;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.ready.store(true, std::memory_order_release);
+            continuations.swap(state.continuations);
+        }
+        state.cv.notify_all();
+        for (Task* task : continuations) task->run(), delete task;  // Each just schedules
+    }
+};
+
+template <typename T>
+void Future<T>::wait() const {
+    if (ready()) return;
+    if (scheduler && scheduler->onWorkerThread()) {
+        scheduler->waitFor([this] { return ready(); });  // Help instead of blocking a worker
+        return;
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [this] { return state->ready.load(std::memory_order_acquire); });
+}
+
+template <typename T>
+template <typename F>
+auto Future<T>::then(F&& f) {
+    auto source = std::move(state);
+    TaskScheduler* owner = scheduler;
+
+    // The continuation's result type: f(T) or, for Future<void>, f()
+    using Fn = std::decay_t<F>;
+    using R = typename std::conditional_t<std::is_void_v<T>, std::invoke_result<Fn&>,
+                                          std::invoke_result<Fn&, T>>::type;
+    auto next = std::make_shared<detail::SharedState<R>>();
+
+    auto body = [source, next, fn = std::forward<F>(f)]() mutable {
+        if (source->error) {
+            next->error = source->error;
+            TaskScheduler::publish(*next);
+            return;
+        }
+        auto call = [&]() -> R {
+            if constexpr (std::is_void_v<T>) {
+                return fn();
+            } else {
+                return fn(std::move(*source->value));
+            }
+        };
+        TaskScheduler::fulfill(*next, call);
+    };
+
+    // A tiny trampoline: when `source` completes, schedule `body` as a task
+    auto schedule = [owner, body = std::move(body)]() mutable { owner->spawn(std::move(body)); };
+
+    std::unique_lock<std::mutex> lock(source->mutex);
+    if (source->ready.load(std::memory_order_acquire)) {
+        lock.unlock();
+        schedule();
+    } else {
+        source->continuations.push_back(makeTask(std::move(schedule)));
+    }
+    return Future<R>(std::move(next), owner);
+}
+
+}  // namespace tasks
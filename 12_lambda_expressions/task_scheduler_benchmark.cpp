@@ -0,0 +1,140 @@
+// Fine-grained tasks: global locked queue of std::function vs work stealing.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o task_scheduler_benchmark task_scheduler_benchmark.cpp
+//     ./task_scheduler_benchmark [items] [threads]
+//         defaults: 4000000 items, hardware_concurrency threads
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "task_scheduler.h"
+
+// Baseline: the classic pool, one mutex-protected queue shared by everyone
+class GlobalQueuePool {
+public:
+    explicit GlobalQueuePool(unsigned threads) {
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> job;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                        if (jobs.empty()) return;
+                        job = std::move(jobs.front());
+                        jobs.pop();
+                    }
+                    job();
+                    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        idle.notify_all();
+                    }
+                }
+            });
+        }
+    }
+
+    ~GlobalQueuePool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    void submit(std::function<void()> job) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push(std::move(job));
+        }
+        wake.notify_one();
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<size_t> pending{0};
+    bool stopping = false;
+};
+
+// A little floating-point work per item so tasks are "fine-grained", not empty
+inline double work(size_t i) { return std::sqrt(static_cast<double>(i) + 0.5); }
+
+long long fibSerial(int n) { return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2); }
+
+long long fibTasks(tasks::TaskScheduler& s, int n) {
+    if (n < 18) return fibSerial(n);
+    auto left = s.submit([&s, n] { return fibTasks(s, n - 1); });
+    long long right = fibTasks(s, n - 2);
+    return left.get() + right;
+}
+
+int main(int argc, char** argv) {
+    size_t items = std::max<size_t>(1, bench::argOr(argc, argv, 1, 4000000));
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned threads = static_cast<unsigned>(std::max<size_t>(1, bench::argOr(argc, argv, 2, hw)));
+
+    std::printf("=== Task Scheduler (%zu items, %u threads, %u hardware threads) ===\n\n",
+                items, threads, hw);
+
+    std::vector<double> out(items);
+    auto body = [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) out[i] = work(i);
+    };
+
+    double serialNs = bench::bestOfNs([&] {
+        body(0, items);
+        bench::doNotOptimize(out.data());
+    }, 3);
+    std::printf("serial loop: %.2f ms\n\n", serialNs / 1e6);
+
+    std::printf("%-12s %18s %18s %10s\n", "grain", "global queue ms", "work stealing ms", "ratio");
+    {
+        GlobalQueuePool global(threads);
+        tasks::TaskScheduler stealing(threads);
+        for (size_t grain : {16, 256, 4096, 65536}) {
+            double globalNs = bench::bestOfNs([&] {
+                for (size_t lo = 0; lo < items; lo += grain) {
+                    size_t hi = std::min(items, lo + grain);
+                    global.submit([&body, lo, hi] { body(lo, hi); });
+                }
+                global.waitIdle();
+            }, 3);
+            double stealingNs = bench::bestOfNs([&] {
+                stealing.parallel_for(0, items, grain, body);
+            }, 3);
+            std::printf("%-12zu %18.2f %18.2f %9.1fx\n", grain, globalNs / 1e6,
+                        stealingNs / 1e6, globalNs / stealingNs);
+        }
+    }
+
+    // Recursive fork-join: tasks spawn tasks, which a global queue handles worst
+    tasks::TaskScheduler stealing(threads);
+    long long result = 0;
+    double fibNs = bench::bestOfNs([&] {
+        result = stealing.submit([&] { return fibTasks(stealing, 32); }).get();
+    }, 3);
+    double fibSerialNs = bench::bestOfNs([&] { bench::doNotOptimize(fibSerial(32)); }, 3);
+    std::printf("\nrecursive fib(32), submit/get below n=18 cutoff: %.2f ms (serial %.2f ms), "
+                "result %lld\n", fibNs / 1e6, fibSerialNs / 1e6, result);
+    return 0;
+}
@@ -0,0 +1,251 @@
+// Allocation counts for copies vs moves, SSO and smart-pointer factories,
+// measured with common/alloc_tracker.h.
+//
+//     g++ -std=c++17 -O2 -Wall -Wextra -pthread -o allocation_benchmark allocation_benchmark.cpp
+//     ./allocation_benchmark [elements]      (default: 100000)
+//
+// Every row states how many operator new calls the operation needs when move
+// semantics and SSO work as intended, and the program exits with status 1 if
+// any count differs, so it doubles as a regression check. The last section
+// measures what the tracking itself costs per allocation.
+
+#define ALLOC_TRACKER_INSTALL
+#include "../common/alloc_tracker.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../04_constructors_destructors/dynamic_array.h"
+#include "../04_constructors_destructors/sso_string.h"
+#include "../common/benchmark.h"
+
+namespace {
+
+bool allOk = true;
+
+template <typename Fn>
+void expectAllocations(const char* label, std::uint64_t expected, Fn&& fn) {
+    alloc_tracker::AllocationScope scope;
+    fn();
+    std::uint64_t got = scope.allocations();
+    bool ok = got == expected;
+    allOk = allOk && ok;
+    std::printf("  %-50s %6llu allocs %10llu bytes   expected %-4llu %s\n", label,
+                static_cast<unsigned long long>(got), static_cast<unsigned long long>(scope.bytes()),
+                static_cast<unsigned long long>(expected), ok ? "ok" : "REGRESSION");
+}
+
+// Same buffer, but a move that may throw: std::vector copies on growth
+struct ThrowingMoveArray {
+    DynamicArray array;
+
+    explicit ThrowingMoveArray(size_t n) : array(n) {}
+    ThrowingMoveArray(const ThrowingMoveArray&) = default;
+    ThrowingMoveArray(ThrowingMoveArray&& other) : array(std::move(other.array)) {}
+};
+
+DynamicArray makeArray(size_t n) {
+    DynamicArray result(n);
+    result[0] = 1;
+    return result;
+}
+
+struct Widget {
+    int id;
+    double value;
+};
+
+// operator new calls std::vector<T> needs to grow to `count` elements
+// one push_back at a time (implementation-defined growth factor)
+std::uint64_t vectorGrowthAllocations(size_t count) {
+    alloc_tracker::AllocationScope scope;
+    std::vector<char> v;
+    for (size_t i = 0; i < count; ++i) v.push_back(0);
+    return scope.allocations();
+}
+
+void moveSection(size_t n) {
+    std::printf("DynamicArray (%zu ints):\n", n);
+    DynamicArray source(n);
+    expectAllocations("copy construct", 1, [&] {
+        DynamicArray copy = source;
+        bench::doNotOptimize(copy[0]);
+    });
+    expectAllocations("move construct + move back", 0, [&] {
+        DynamicArray moved = std::move(source);
+        source = std::move(moved);
+    });
+    expectAllocations("return by value (NRVO)", 1, [&] {
+        DynamicArray made = makeArray(n);
+        bench::doNotOptimize(made[0]);
+    });
+
+    const size_t count = 64;
+    std::uint64_t growth = vectorGrowthAllocations(count);
+    expectAllocations("vector<DynamicArray>: 64 push_back, noexcept move", count + growth, [&] {
+        std::vector<DynamicArray> v;
+        for (size_t i = 0; i < count; ++i) v.push_back(DynamicArray(16));
+    });
+    expectAllocations("same with reserve(64)", count + 1, [&] {
+        std::vector<DynamicArray> v;
+        v.reserve(count);
+        for (size_t i = 0; i < count; ++i) v.push_back(DynamicArray(16));
+    });
+
+    // Every reallocation deep-copies the elements it already holds
+    alloc_tracker::AllocationScope throwing;
+    {
+        std::vector<ThrowingMoveArray> v;
+        for (size_t i = 0; i < count; ++i) v.push_back(ThrowingMoveArray(16));
+    }
+    std::uint64_t got = throwing.allocations();
+    bool ok = got > count + growth;
+    allOk = allOk && ok;
+    std::printf("  %-50s %6llu allocs %10llu bytes   expected >%-3llu %s\n",
+                "same, move not noexcept (copies on growth)", static_cast<unsigned long long>(got),
+                static_cast<unsigned long long>(throwing.bytes()),
+                static_cast<unsigned long long>(count + growth), ok ? "ok" : "REGRESSION");
+
+    // Hot path that must stay allocation-free: moves and swaps only
+    DynamicArray a(n), b(n);
+    {
+        alloc_tracker::NoAllocationScope hot;
+        for (int i = 0; i < 1000; ++i) {
+            DynamicArray t = std::move(a);
+            a = std::move(b);
+            b = std::move(t);
+        }
+    }
+    std::printf("  1000 three-way moves inside NoAllocationScope: ok\n\n");
+}
+
+void stringSection() {
+    std::printf("Strings:\n");
+    SsoString shortSso("short");
+    SsoString longSso("this string is longer than the inline buffer");
+    expectAllocations("SsoString copy, 5 chars (inline)", 0, [&] {
+        SsoString copy = shortSso;
+        bench::doNotOptimize(copy);
+    });
+    expectAllocations("SsoString copy, 45 chars (heap)", 1, [&] {
+        SsoString copy = longSso;
+        bench::doNotOptimize(copy);
+    });
+    expectAllocations("SsoString move, 45 chars", 0, [&] {
+        SsoString moved = std::move(longSso);
+        longSso = std::move(moved);
+    });
+    std::string shortStd = "short", longStd = "this string is longer than the inline buffer";
+    expectAllocations("std::string copy, 5 chars (SSO)", 0, [&] {
+        std::string copy = shortStd;
+        bench::doNotOptimize(copy);
+    });
+    expectAllocations("std::string copy, 45 chars", 1, [&] {
+        std::string copy = longStd;
+        bench::doNotOptimize(copy);
+    });
+    std::printf("\n");
+}
+
+void pointerSection() {
+    std::printf("Smart pointers:\n");
+    expectAllocations("std::make_unique<Widget>", 1, [] {
+        auto p = std::make_unique<Widget>();
+        bench::doNotOptimize(p);
+    });
+    expectAllocations("std::make_shared<Widget> (object + count)", 1, [] {
+        auto p = std::make_shared<Widget>();
+        bench::doNotOptimize(p);
+    });
+    expectAllocations("std::shared_ptr<Widget>(new Widget)", 2, [] {
+        std::shared_ptr<Widget> p(new Widget());
+        bench::doNotOptimize(p);
+    });
+    std::printf("\n");
+}
+
+std::uint64_t violations = 0;
+
+void threadSection() {
+    std::printf("Per-thread counters and peak usage:\n");
+    const int threads = 4, perThread = 1000;
+    std::uint64_t before = alloc_tracker::totalStats().allocations;
+    alloc_tracker::resetPeak();
+    std::int64_t liveBefore = alloc_tracker::liveBytes();
+
+    std::vector<std::uint64_t> counted(threads);
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([t, &counted] {
+            alloc_tracker::AllocationScope scope;
+            std::vector<std::unique_ptr<Widget>> keep;
+            keep.reserve(perThread);
+            for (int i = 0; i < perThread; ++i) keep.push_back(std::make_unique<Widget>());
+            counted[t] = scope.allocations();
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    // Thread objects and their start-up state allocate too, so the total is a lower bound
+    std::uint64_t total = alloc_tracker::totalStats().allocations - before;
+    bool ok = total >= static_cast<std::uint64_t>(threads) * (perThread + 1);
+    for (std::uint64_t c : counted) ok = ok && c == perThread + 1;
+    std::int64_t peak = alloc_tracker::peakBytes() - liveBefore;
+    ok = ok && peak >= static_cast<std::int64_t>(perThread * sizeof(Widget));
+    allOk = allOk && ok;
+    std::printf("  %d threads x %d make_unique: per thread %llu, total %llu, peak +%lld bytes   %s\n",
+                threads, perThread, static_cast<unsigned long long>(counted[0]),
+                static_cast<unsigned long long>(total), static_cast<long long>(peak), ok ? "ok" : "REGRESSION");
+
+    // A custom handler can count violations instead of aborting
+    alloc_tracker::setViolationHandler([](size_t) { ++violations; });
+    {
+        alloc_tracker::NoAllocationScope hot;
+        auto p = std::make_unique<Widget>();
+        bench::doNotOptimize(p);
+    }
+    alloc_tracker::setViolationHandler(nullptr);
+    ok = violations == 1;
+    allOk = allOk && ok;
+    std::printf("  make_unique inside NoAllocationScope reported %llu violation   %s\n\n",
+                static_cast<unsigned long long>(violations), ok ? "ok" : "REGRESSION");
+}
+
+void overheadSection() {
+    std::printf("Tracking overhead (64-byte blocks, best of 5):\n");
+    const int count = 1000000;
+    std::vector<void*> blocks(count);
+    double trackedNs = bench::bestOfNs([&] {
+        for (int i = 0; i < count; ++i) blocks[i] = ::operator new(64);
+        for (int i = 0; i < count; ++i) ::operator delete(blocks[i]);
+    });
+    double mallocNs = bench::bestOfNs([&] {
+        for (int i = 0; i < count; ++i) blocks[i] = std::malloc(64);
+        bench::doNotOptimize(blocks.data());
+        for (int i = 0; i < count; ++i) std::free(blocks[i]);
+    });
+    std::printf("  operator new + delete (tracked) %8.2f ns\n", trackedNs / count);
+    std::printf("  malloc + free (untracked)       %8.2f ns\n\n", mallocNs / count);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 100000);
+    if (n == 0) n = 1;
+
+    std::printf("=== Allocation Counts (alloc_tracker %s) ===\n\n",
+                alloc_tracker::installed() ? "installed" : "NOT installed");
+    moveSection(n);
+    stringSection();
+    pointerSection();
+    threadSection();
+    overheadSection();
+    alloc_tracker::printReport("at exit", stdout);
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+// Move-counting benchmark for the "Performance Impact" section of README.md.
+//
+// Build with optimizations, otherwise the numbers are meaningless:
+//     g++ -std=c++17 -O2 -Wall -Wextra -o move_benchmark move_benchmark.cpp
+//     ./move_benchmark [elements]        (default: 1000000)
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../04_constructors_destructors/dynamic_array.h"
+
+// Same buffer, but the move constructor is NOT noexcept. std::vector must then
+// copy elements on reallocation to keep its strong exception guarantee.
+struct ThrowingMoveArray {
+    DynamicArray array;
+
+    explicit ThrowingMoveArray(size_t n) : array(n) {}
+    ThrowingMoveArray(const ThrowingMoveArray&) = default;
+    ThrowingMoveArray(ThrowingMoveArray&& other) : array(std::move(other.array)) {}
+};
+
+DynamicArray makeArray(size_t n) {
+    DynamicArray result(n);
+    result[0] = 1;
+    return result;  // NRVO or move, never a deep copy
+}
+
+void printStats(const char* label, double ms) {
+    const DynamicArray::Stats& s = DynamicArray::getStats();
+    std::printf("  %-40s %10.4f ms   allocs=%zu copies=%zu moves=%zu\n",
+                label, ms, s.allocations, s.deepCopies, s.moves);
+}
+
+void benchCopyVsMove(size_t n) {
+    std::printf("Transfer one %zu-element array:\n", n);
+    DynamicArray source(n);
+
+    DynamicArray::resetStats();
+    double copyMs = bench::bestOfMs([&] {
+        DynamicArray copy = source;
+        bench::doNotOptimize(copy[0]);
+    });
+    printStats("copy construct (deep copy)", copyMs);
+
+    DynamicArray::resetStats();
+    double moveMs = bench::bestOfMs([&] {
+        DynamicArray moved = std::move(source);
+        bench::doNotOptimize(moved[0]);
+        source = std::move(moved);  // Put it back for the next repeat
+    });
+    printStats("move construct + move back", moveMs);
+
+    DynamicArray::resetStats();
+    double returnMs = bench::bestOfMs([&] {
+        DynamicArray made = makeArray(n);
+        bench::doNotOptimize(made[0]);
+    });
+    printStats("return from function (alloc + zero-fill)", returnMs);
+
+    std::vector<int> vec(n, 0);
+    double vecCopyMs = bench::bestOfMs([&] {
+        std::vector<int> copy = vec;
+        bench::doNotOptimize(copy.data());
+    });
+    double vecMoveMs = bench::bestOfMs([&] {
+        std::vector<int> moved = std::move(vec);
+        bench::doNotOptimize(moved.data());
+        vec = std::move(moved);
+    });
+    std::printf("  %-40s %10.4f ms\n", "std::vector<int> copy", vecCopyMs);
+    std::printf("  %-40s %10.4f ms\n", "std::vector<int> move + move back", vecMoveMs);
+    if (moveMs > 0.0) {
+        std::printf("  copy/move ratio: %.0fx\n", copyMs / moveMs);
+    }
+    std::printf("\n");
+}
+
+void benchZeroFill(size_t n) {
+    std::printf("Allocate %zu elements:\n", n);
+
+    DynamicArray::resetStats();
+    double zeroMs = bench::bestOfMs([&] {
+        DynamicArray a(n);
+        bench::doNotOptimize(a[n - 1]);
+    });
+    printStats("DynamicArray(n)  (zero-filled)", zeroMs);
+
+    DynamicArray::resetStats();
+    double rawMs = bench::bestOfMs([&] {
+        DynamicArray a(n, uninitialized);
+        a[n - 1] = 0;
+        bench::doNotOptimize(a[n - 1]);
+    });
+    printStats("DynamicArray(n, uninitialized)", rawMs);
+
+    DynamicArray::resetStats();
+    double pushMs = bench::bestOfMs([&] {
+        DynamicArray a;
+        for (size_t i = 0; i < n; ++i) {
+            a.push_back(static_cast<int>(i));
+        }
+        bench::doNotOptimize(a[n - 1]);
+    }, 1);
+    printStats("push_back x n (geometric growth)", pushMs);
+    std::printf("\n");
+}
+
+// Push `count` arrays into a vector without reserve(), forcing reallocations.
+void benchVectorReallocation(size_t n) {
+    const size_t count = 64;
+    size_t elements = n / count > 0 ? n / count : 1;
+    std::printf("Push %zu arrays of %zu elements into std::vector (no reserve):\n",
+                count, elements);
+
+    DynamicArray::resetStats();
+    double noexceptMs = bench::bestOfMs([&] {
+        std::vector<DynamicArray> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.push_back(DynamicArray(elements));
+        }
+        bench::doNotOptimize(v.back()[0]);
+    }, 1);
+    printStats("noexcept move (DynamicArray)", noexceptMs);
+
+    DynamicArray::resetStats();
+    double throwingMs = bench::bestOfMs([&] {
+        std::vector<ThrowingMoveArray> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.push_back(ThrowingMoveArray(elements));
+        }
+        bench::doNotOptimize(v.back().array[0]);
+    }, 1);
+    printStats("throwing move (vector must copy)", throwingMs);
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench::argOr(argc, argv, 1, 1000000);
+    if (n == 0) n = 1;
+
+    std::printf("=== Move Semantics Benchmark (n = %zu) ===\n\n", n);
+    benchCopyVsMove(n);
+    benchZeroFill(n);
+    benchVectorReallocation(n);
+    return 0;
+}
@@ -0,0 +1,325 @@
+#pragma once
+
+// Opt-in heap instrumentation: replaces global operator new/delete to count
+// allocations and bytes per thread, track live and peak heap usage, and fail
+// loudly when a scope that must not allocate does.
+//
+//     #define ALLOC_TRACKER_INSTALL        // In exactly one .cpp of the program
+//     #include "../common/alloc_tracker.h"
+//
+//     alloc_tracker::AllocationScope scope;
+//     DynamicArray moved = std::move(source);
+//     assert(scope.allocations() == 0);          // Move semantics still pay off
+//
+//     {
+//         alloc_tracker::NoAllocationScope hot;   // Any operator new here aborts
+//         processFrame(buffers);
+//     }
+//     alloc_tracker::printReport("after run");
+//
+// Without ALLOC_TRACKER_INSTALL the header only declares the API; the
+// counters stay at zero and installed() returns false, so code that reports
+// statistics still builds either way. The replacement operators cannot be
+// inline, which is why only one translation unit may define the macro.
+//
+// Counters: each thread owns a cache-line-sized block, written with relaxed
+// load+store (no locked instructions, no sharing). Threads beyond kMaxThreads
+// share one overflow block updated with fetch_add. Totals sum all blocks and
+// include threads that have exited. Live and peak bytes are necessarily
+// global: one fetch_add per allocation or free, plus a compare-exchange when a
+// new peak is reached.
+//
+// Every block carries a 16-byte header (its size and the malloc pointer), so
+// unsized delete still knows how many bytes it frees. Only operator new and
+// delete are seen: malloc, mmap and allocations made through custom allocators
+// that bypass operator new are not counted.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace alloc_tracker {
+
+struct Stats {
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytesAllocated = 0;
+    std::uint64_t bytesFreed = 0;
+};
+
+// Called with the requested size when a NoAllocationScope allocates. The
+// default prints a message to stderr and calls std::abort().
+using ViolationHandler = void (*)(std::size_t bytes);
+
+namespace detail {
+
+constexpr size_t kMaxThreads = 256;
+
+struct alignas(64) Counters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> bytesAllocated{0};
+    std::atomic<std::uint64_t> bytesFreed{0};
+};
+
+// Constant-initialized, so it is ready before any static constructor allocates
+struct State {
+    Counters threads[kMaxThreads];
+    Counters overflow;
+    std::atomic<size_t> threadCount{0};
+    alignas(64) std::atomic<std::int64_t> live{0};
+    std::atomic<std::int64_t> peak{0};
+    std::atomic<ViolationHandler> onViolation{nullptr};
+    std::atomic<bool> installed{false};
+};
+
+inline State state;
+inline thread_local Counters* threadCounters = nullptr;
+inline thread_local int noAllocationDepth = 0;
+
+inline Counters& mine() {
+    Counters* c = threadCounters;
+    if (!c) {
+        size_t index = state.threadCount.fetch_add(1, std::memory_order_relaxed);
+        c = index < kMaxThreads ? &state.threads[index] : &state.overflow;
+        threadCounters = c;
+    }
+    return *c;
+}
+
+// Single writer: a plain add, still visible to readers on other threads
+inline void bump(Counters& c, std::atomic<std::uint64_t>& counter, std::uint64_t v) {
+    if (&c == &state.overflow) counter.fetch_add(v, std::memory_order_relaxed);
+    else counter.store(counter.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+inline void violation(std::size_t bytes) {
+    // The handler may allocate (or be interrupted by an allocation) safely
+    int depth = noAllocationDepth;
+    noAllocationDepth = 0;
+    if (ViolationHandler handler = state.onViolation.load(std::memory_order_relaxed)) {
+        handler(bytes);
+    } else {
+        std::fprintf(stderr, "alloc_tracker: %zu-byte allocation inside a NoAllocationScope\n", bytes);
+        std::abort();
+    }
+    noAllocationDepth = depth;
+}
+
+inline void recordAllocation(std::size_t bytes) {
+    Counters& c = mine();
+    bump(c, c.allocations, 1);
+    bump(c, c.bytesAllocated, bytes);
+    std::int64_t now = state.live.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) +
+                       static_cast<std::int64_t>(bytes);
+    std::int64_t peak = state.peak.load(std::memory_order_relaxed);
+    while (now > peak && !state.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+    if (noAllocationDepth > 0) violation(bytes);
+}
+
+inline void recordFree(std::size_t bytes) {
+    Counters& c = mine();
+    bump(c, c.frees, 1);
+    bump(c, c.bytesFreed, bytes);
+    state.live.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+inline Stats read(const Counters& c) {
+    Stats s;
+    s.allocations = c.allocations.load(std::memory_order_relaxed);
+    s.frees = c.frees.load(std::memory_order_relaxed);
+    s.bytesAllocated = c.bytesAllocated.load(std::memory_order_relaxed);
+    s.bytesFreed = c.bytesFreed.load(std::memory_order_relaxed);
+    return s;
+}
+
+}  // namespace detail
+
+// True when this program was built with ALLOC_TRACKER_INSTALL
+inline bool installed() { return detail::state.installed.load(std::memory_order_relaxed); }
+
+// The calling thread's counters since it started
+inline Stats threadStats() { return detail::read(detail::mine()); }
+
+// All threads, including finished ones
+inline Stats totalStats() {
+    Stats total;
+    size_t threads = detail::state.threadCount.load(std::memory_order_relaxed);
+    auto add = [&total](const detail::Counters& c) {
+        Stats s = detail::read(c);
+        total.allocations += s.allocations;
+        total.frees += s.frees;
+        total.bytesAllocated += s.bytesAllocated;
+        total.bytesFreed += s.bytesFreed;
+    };
+    for (size_t i = 0; i < threads && i < detail::kMaxThreads; ++i) add(detail::state.threads[i]);
+    add(detail::state.overflow);
+    return total;
+}
+
+// Bytes currently allocated through operator new, and the high-water mark
+inline std::int64_t liveBytes() { return detail::state.live.load(std::memory_order_relaxed); }
+inline std::int64_t peakBytes() { return detail::state.peak.load(std::memory_order_relaxed); }
+
+// Start a new high-water mark from the current live size
+inline void resetPeak() { detail::state.peak.store(liveBytes(), std::memory_order_relaxed); }
+
+inline void setViolationHandler(ViolationHandler handler) {
+    detail::state.onViolation.store(handler, std::memory_order_relaxed);
+}
+
+// Counts the calling thread's allocations from construction on
+class AllocationScope {
+public:
+    AllocationScope() : start(threadStats()) {}
+
+    std::uint64_t allocations() const { return threadStats().allocations - start.allocations; }
+    std::uint64_t frees() const { return threadStats().frees - start.frees; }
+    std::uint64_t bytes() const { return threadStats().bytesAllocated - start.bytesAllocated; }
+
+private:
+    Stats start;
+};
+
+// Any operator new on this thread while one of these is alive is a violation.
+// Frees are allowed: releasing memory allocated earlier is not a hot-path cost
+// worth banning, and destructors at the end of a scope commonly do it.
+class NoAllocationScope {
+public:
+    NoAllocationScope() { ++detail::noAllocationDepth; }
+    ~NoAllocationScope() { --detail::noAllocationDepth; }
+    NoAllocationScope(const NoAllocationScope&) = delete;
+    NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+};
+
+inline void printReport(const char* label = nullptr, std::FILE* out = stderr) {
+    if (!installed()) {
+        std::fprintf(out, "alloc_tracker: not installed (define ALLOC_TRACKER_INSTALL)\n");
+        return;
+    }
+    Stats s = totalStats();
+    std::fprintf(out,
+                 "alloc_tracker%s%s: %llu allocations (%llu bytes), %llu frees (%llu bytes), "
+                 "live %lld bytes, peak %lld bytes, %zu threads\n",
+                 label ? " " : "", label ? label : "", static_cast<unsigned long long>(s.allocations),
+                 static_cast<unsigned long long>(s.bytesAllocated), static_cast<unsigned long long>(s.frees),
+                 static_cast<unsigned long long>(s.bytesFreed), static_cast<long long>(liveBytes()),
+                 static_cast<long long>(peakBytes()), detail::state.threadCount.load(std::memory_order_relaxed));
+}
+
+}  // namespace alloc_tracker
+
+#if defined(ALLOC_TRACKER_INSTALL)
+
+namespace alloc_tracker::detail {
+
+struct Header {
+    std::size_t size;
+    void* raw;  // What malloc returned
+};
+static_assert(sizeof(Header) <= 16, "Header must fit the default new alignment");
+
+constexpr std::size_t kHeaderSpace = 16;
+
+inline void* trackedAllocate(std::size_t size, std::size_t alignment) {
+    std::size_t slack = alignment > kHeaderSpace ? alignment : 0;
+    // An overflowing total would succeed with a tiny block; fail like malloc
+    if (size > std::numeric_limits<std::size_t>::max() - kHeaderSpace - slack) return nullptr;
+    void* raw = std::malloc(size + kHeaderSpace + slack);
+    if (!raw) return nullptr;
+    std::uintptr_t user = reinterpret_cast<std::uintptr_t>(raw) + kHeaderSpace;
+    if (slack) user = (user + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    Header* header = reinterpret_cast<Header*>(user) - 1;
+    header->size = size;
+    header->raw = raw;
+    recordAllocation(size);
+    return reinterpret_cast<void*>(user);
+}
+
+inline void trackedFree(void* p) noexcept {
+    if (!p) return;
+    Header* header = static_cast<Header*>(p) - 1;
+    recordFree(header->size);
+    std::free(header->raw);
+}
+
+// The operator new contract: retry through the new-handler, then fail
+inline void* allocateOrFail(std::size_t size, std::size_t alignment, bool nothrow) {
+    for (;;) {
+        if (void* p = trackedAllocate(size, alignment)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            if (nothrow) return nullptr;
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+        try {
+            handler();
+        } catch (const std::bad_alloc&) {
+            if (nothrow) return nullptr;
+            throw;
+        }
+#else
+        handler();
+#endif
+    }
+}
+
+constexpr std::size_t kDefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+static const bool registered = (state.installed.store(true, std::memory_order_relaxed), true);
+
+}  // namespace alloc_tracker::detail
+
+void* operator new(std::size_t n) {
+    return alloc_tracker::detail::allocateOrFail(n, alloc_tracker::detail::kDefaultAlignment, false);
+}
+void* operator new[](std::size_t n) {
+    return alloc_tracker::detail::allocateOrFail(n, alloc_tracker::detail::kDefaultAlignment, false);
+}
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    return alloc_tracker::detail::allocateOrFail(n, alloc_tracker::detail::kDefaultAlignment, true);
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    return alloc_tracker::detail::allocateOrFail(n, alloc_tracker::detail::kDefaultAlignment, true);
+}
+void* operator new(std::size_t n, std::align_val_t a) {
+    return alloc_tracker::detail::allocateOrFail(n, static_cast<std::size_t>(a), false);
+}
+void* operator new[](std::size_t n, std::align_val_t a) {
+    return alloc_tracker::detail::allocateOrFail(n, static_cast<std::size_t>(a), false);
+}
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return alloc_tracker::detail::allocateOrFail(n, static_cast<std::size_t>(a), true);
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return alloc_tracker::detail::allocateOrFail(n, static_cast<std::size_t>(a), true);
+}
+
+void operator delete(void* p) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete[](void* p) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alloc_tracker::detail::trackedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    alloc_tracker::detail::trackedFree(p);
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    alloc_tracker::detail::trackedFree(p);
+}
+
+#endif  // ALLOC_TRACKER_INSTALL
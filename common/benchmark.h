@@ -0,0 +1,86 @@
+#pragma once
+
+// Tiny self-contained timing helpers shared by the *_benchmark.cpp programs.
+// Header-only so every benchmark still compiles as a single command:
+//     g++ -std=c++17 -O2 -o bench some_module/xyz_benchmark.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Keep a function out of line, and (on GCC) stop interprocedural passes from
+// rewriting its signature, so a call costs what its declaration says
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#elif defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE __attribute__((noipa))
+#endif
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Keep the optimizer from deleting work whose result is never used.
+#if defined(_MSC_VER)
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    static const void* volatile sink;
+    sink = &value;
+    _ReadWriteBarrier();
+}
+
+inline void clobberMemory() {
+    _ReadWriteBarrier();
+}
+#else
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+#endif
+
+// Run fn() `repeats` times and return the fastest run in nanoseconds.
+// Best-of-N filters out scheduler noise better than the mean does.
+template <typename Fn>
+double bestOfNs(Fn&& fn, int repeats = 5) {
+    double best = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = Clock::now();
+        fn();
+        auto stop = Clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        best = (r == 0) ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+template <typename Fn>
+double bestOfMs(Fn&& fn, int repeats = 5) {
+    return bestOfNs(fn, repeats) / 1e6;
+}
+
+// Read an optional size argument: ./bench 1000000
+inline size_t argOr(int argc, char** argv, int index, size_t fallback) {
+    if (argc > index) {
+        return static_cast<size_t>(std::strtoull(argv[index], nullptr, 10));
+    }
+    return fallback;
+}
+
+inline void printRow(const std::string& label, double value, const char* unit) {
+    std::printf("  %-44s %14.3f %s\n", label.c_str(), value, unit);
+}
+
+}  // namespace bench
@@ -0,0 +1,227 @@
+#pragma once
+
+// Value-or-error result type, standing in for C++23 std::expected so the
+// examples still build with -std=c++17.
+//
+//     Expected<double, WithdrawError> withdraw(double amount);
+//
+//     auto balance = account.withdraw(50.0);
+//     if (!balance) report(balance.error());     // Failure is part of the type
+//     else use(*balance);
+//
+//     return makeUnexpected(WithdrawError::InsufficientFunds);   // Failing
+//
+// Failure is an ordinary return value: no unwinding, no allocation, and a
+// cost that does not depend on how often it happens (see
+// 11_exceptions/error_model_benchmark.cpp). When T and E are trivially
+// copyable, so is Expected, and small results come back in registers.
+//
+// operator* and operator-> do not check. value() does: it throws
+// BadExpectedAccess<E> on an error, or calls std::abort() when exceptions are
+// disabled (-fno-exceptions), so the type works in non-throwing builds too.
+
+#include <cstdlib>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename E>
+class Unexpected {
+public:
+    explicit Unexpected(E e) : err(std::move(e)) {}
+
+    const E& error() const& { return err; }
+    E& error() & { return err; }
+    E&& error() && { return std::move(err); }
+
+private:
+    E err;
+};
+
+template <typename E>
+Unexpected<std::decay_t<E>> makeUnexpected(E&& e) {
+    return Unexpected<std::decay_t<E>>(std::forward<E>(e));
+}
+
+template <typename E>
+class BadExpectedAccess : public std::exception {
+public:
+    explicit BadExpectedAccess(E e) : err(std::move(e)) {}
+    const char* what() const noexcept override { return "Expected::value() called on an error"; }
+    const E& error() const { return err; }
+
+private:
+    E err;
+};
+
+namespace expected_detail {
+
+struct ValueTag {};
+struct ErrorTag {};
+struct Unit {};  // The value of Expected<void, E>
+
+template <typename E>
+[[noreturn]] void throwBadAccess(const E& e) {
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+    throw BadExpectedAccess<E>(e);
+#else
+    (void)e;
+    std::abort();
+#endif
+}
+
+// Trivially copyable T and E: the implicit copy and destructor stay trivial
+template <typename T, typename E,
+          bool Trivial = std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E> &&
+                         std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>>
+struct Storage {
+    union {
+        T val;
+        E err;
+    };
+    bool has;
+
+    template <typename... Args>
+    constexpr explicit Storage(ValueTag, Args&&... args) : val(std::forward<Args>(args)...), has(true) {}
+    template <typename... Args>
+    constexpr explicit Storage(ErrorTag, Args&&... args) : err(std::forward<Args>(args)...), has(false) {}
+};
+
+template <typename T, typename E>
+struct Storage<T, E, false> {
+    union {
+        T val;
+        E err;
+    };
+    bool has;
+
+    template <typename... Args>
+    explicit Storage(ValueTag, Args&&... args) : val(std::forward<Args>(args)...), has(true) {}
+    template <typename... Args>
+    explicit Storage(ErrorTag, Args&&... args) : err(std::forward<Args>(args)...), has(false) {}
+
+    Storage(const Storage& other) : has(other.has) {
+        if (has) new (&val) T(other.val);
+        else new (&err) E(other.err);
+    }
+
+    Storage(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                      std::is_nothrow_move_constructible_v<E>)
+        : has(other.has) {
+        if (has) new (&val) T(std::move(other.val));
+        else new (&err) E(std::move(other.err));
+    }
+
+    // Copy first, so a throwing copy leaves *this untouched
+    Storage& operator=(const Storage& other) {
+        if (this != &other) {
+            Storage copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    Storage& operator=(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                 std::is_nothrow_move_constructible_v<E>) {
+        static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>,
+                      "Expected assignment needs nothrow-movable T and E");
+        if (this != &other) {
+            destroy();
+            has = other.has;
+            if (has) new (&val) T(std::move(other.val));
+            else new (&err) E(std::move(other.err));
+        }
+        return *this;
+    }
+
+    ~Storage() { destroy(); }
+
+    void destroy() {
+        if (has) val.~T();
+        else err.~E();
+    }
+};
+
+}  // namespace expected_detail
+
+template <typename T, typename E>
+class Expected {
+public:
+    using value_type = T;
+    using error_type = E;
+
+    Expected() : store(expected_detail::ValueTag{}) {}
+    Expected(const T& value) : store(expected_detail::ValueTag{}, value) {}
+    Expected(T&& value) : store(expected_detail::ValueTag{}, std::move(value)) {}
+
+    template <typename G>
+    Expected(const Unexpected<G>& u) : store(expected_detail::ErrorTag{}, u.error()) {}
+    template <typename G>
+    Expected(Unexpected<G>&& u) : store(expected_detail::ErrorTag{}, std::move(u).error()) {}
+
+    bool has_value() const noexcept { return store.has; }
+    explicit operator bool() const noexcept { return store.has; }
+
+    T& value() & {
+        if (!store.has) expected_detail::throwBadAccess(store.err);
+        return store.val;
+    }
+    const T& value() const& {
+        if (!store.has) expected_detail::throwBadAccess(store.err);
+        return store.val;
+    }
+    T&& value() && {
+        if (!store.has) expected_detail::throwBadAccess(store.err);
+        return std::move(store.val);
+    }
+
+    template <typename U>
+    T value_or(U&& fallback) const& {
+        return store.has ? store.val : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    // Unchecked: the caller has tested has_value()
+    T& operator*() & noexcept { return store.val; }
+    const T& operator*() const& noexcept { return store.val; }
+    T&& operator*() && noexcept { return std::move(store.val); }
+    T* operator->() noexcept { return &store.val; }
+    const T* operator->() const noexcept { return &store.val; }
+
+    // Unchecked: the caller has tested !has_value()
+    E& error() & noexcept { return store.err; }
+    const E& error() const& noexcept { return store.err; }
+    E&& error() && noexcept { return std::move(store.err); }
+
+private:
+    expected_detail::Storage<T, E> store;
+};
+
+// Success carries no value: Expected<void, E> ok;  or  return {};
+template <typename E>
+class Expected<void, E> {
+public:
+    using value_type = void;
+    using error_type = E;
+
+    Expected() : store(expected_detail::ValueTag{}) {}
+
+    template <typename G>
+    Expected(const Unexpected<G>& u) : store(expected_detail::ErrorTag{}, u.error()) {}
+    template <typename G>
+    Expected(Unexpected<G>&& u) : store(expected_detail::ErrorTag{}, std::move(u).error()) {}
+
+    bool has_value() const noexcept { return store.has; }
+    explicit operator bool() const noexcept { return store.has; }
+
+    void value() const {
+        if (!store.has) expected_detail::throwBadAccess(store.err);
+    }
+
+    E& error() & noexcept { return store.err; }
+    const E& error() const& noexcept { return store.err; }
+    E&& error() && noexcept { return std::move(store.err); }
+
+private:
+    expected_detail::Storage<expected_detail::Unit, E> store;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+// Non-owning reference to any callable, the "std::function without the
+// ownership" (std::function_ref arrives in C++26).
+//
+// FunctionRef is two pointers: the callable's address and a thunk that knows
+// its type. It never allocates and copying it is free, but it does NOT extend
+// the callable's lifetime - use it for parameters, never for stored callbacks:
+//
+//     void visit(FunctionRef<void(int)> fn);   // OK: fn used during the call
+//     visit([&](int v) { sum += v; });
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature>
+class FunctionRef;
+
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+public:
+    template <typename F,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::remove_cv_t<std::remove_reference_t<F>>, FunctionRef> &&
+                  !std::is_function_v<std::remove_reference_t<F>> &&
+                  std::is_invocable_r_v<R, F&, Args...>>>
+    FunctionRef(F&& callable) noexcept : thunk(&invokeObject<std::remove_reference_t<F>>) {
+        target.object = const_cast<void*>(static_cast<const void*>(std::addressof(callable)));
+    }
+
+    // Plain functions: `visit(printValue)`
+    FunctionRef(R (*function)(Args...)) noexcept : thunk(&invokeFunction) {
+        target.function = function;
+    }
+
+    R operator()(Args... args) const {
+        return thunk(target, std::forward<Args>(args)...);
+    }
+
+private:
+    // Function pointers may not round-trip through void*, so keep them apart
+    union Target {
+        void* object;
+        R (*function)(Args...);
+    };
+
+    Target target;
+    R (*thunk)(Target, Args...);
+
+    template <typename F>
+    static R invokeObject(Target target, Args... args) {
+        return (*static_cast<F*>(target.object))(std::forward<Args>(args)...);
+    }
+
+    static R invokeFunction(Target target, Args... args) {
+        return target.function(std::forward<Args>(args)...);
+    }
+};
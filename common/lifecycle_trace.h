@@ -0,0 +1,265 @@
+#pragma once
+
+// Object lifetime tracing without a syscall per event.
+//
+//     Widget(int i) : id(i) { LIFECYCLE_EVENT("Widget", Construct, this, id); }
+//     ~Widget()             { LIFECYCLE_EVENT("Widget", Destruct, this, id); }
+//
+//     auto mark = lifecycle::now();
+//     ...                                           // Create and destroy objects
+//     lifecycle::printEvents(std::cout, mark);      // What happened since mark
+//     lifecycle::writeChromeTrace("trace.json");    // Open in chrome://tracing or Perfetto
+//
+// Writing to std::cout with std::endl in every constructor flushes the stream
+// (one write() system call per object) and makes threads queue on the stream
+// lock. LIFECYCLE_EVENT instead stores a 64-byte record (type, address, event,
+// timestamp, a value and a short note) in a ring buffer owned by the calling
+// thread: no lock, no allocation after the thread's first event, no I/O.
+// Output happens later, when the program asks for it.
+//
+// Build with -DLIFECYCLE_TRACE=0 to compile every LIFECYCLE_EVENT to nothing;
+// the reporting functions then see no events.
+//
+// Each thread keeps the last kRingCapacity events; older ones are overwritten
+// and counted as dropped. Reading (events(), printEvents(), writeChromeTrace())
+// is meant for quiescent points - after threads have joined or between
+// phases. Reading while a thread wraps its ring can return torn records for
+// the oldest entries.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#if !defined(LIFECYCLE_TRACE)
+#define LIFECYCLE_TRACE 1
+#endif
+
+namespace lifecycle {
+
+enum class Event : std::uint8_t { Construct, CopyConstruct, MoveConstruct, CopyAssign, MoveAssign, Destruct };
+
+inline const char* eventName(Event e) {
+    switch (e) {
+        case Event::Construct: return "construct";
+        case Event::CopyConstruct: return "copy-construct";
+        case Event::MoveConstruct: return "move-construct";
+        case Event::CopyAssign: return "copy-assign";
+        case Event::MoveAssign: return "move-assign";
+        case Event::Destruct: return "destruct";
+    }
+    return "unknown";
+}
+
+// One cache line per event (the ring aligns its slots; copies need not be)
+struct Record {
+    std::uint64_t timestampNs;
+    const char* type;        // Must be a string literal (or otherwise outlive the trace)
+    const void* object;
+    std::int64_t value;
+    std::uint32_t thread;    // Order in which threads recorded their first event
+    Event event;
+    char note[27];           // Copied, truncated, NUL-terminated
+};
+static_assert(sizeof(Record) == 64, "Record should fill exactly one cache line");
+
+// Steady-clock nanoseconds, the timestamp used by every record
+inline std::uint64_t now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+namespace detail {
+
+constexpr std::size_t kRingCapacity = 1 << 14;  // 16384 events, 1 MiB per thread
+
+struct Ring {
+    alignas(64) Record slots[kRingCapacity];
+    std::atomic<std::uint64_t> head{0};  // Events ever written; slot = head % capacity
+    std::atomic<std::uint64_t> tail{0};  // First event still reported (clear() moves it)
+    std::atomic<bool> owned{true};       // A live thread is writing to it
+    Ring* next = nullptr;
+};
+
+// Rings are never freed, so events survive their thread. A thread that exits
+// hands its ring (and the events in it) to the next new thread instead, so
+// spawning threads in a loop does not grow memory.
+inline std::atomic<Ring*> rings{nullptr};
+inline std::atomic<std::uint32_t> threadCount{0};
+inline std::atomic<std::uint64_t> lostEvents{0};  // No ring could be allocated
+
+inline Ring* acquireRing() noexcept {
+    for (Ring* r = rings.load(std::memory_order_acquire); r; r = r->next) {
+        bool expected = false;
+        if (!r->owned.load(std::memory_order_relaxed) &&
+            r->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return r;
+        }
+    }
+    Ring* ring = new (std::nothrow) Ring();
+    if (!ring) return nullptr;
+    ring->next = rings.load(std::memory_order_relaxed);
+    while (!rings.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return ring;
+}
+
+struct ThreadState {
+    Ring* ring = nullptr;
+    std::uint32_t thread = 0;
+
+    ~ThreadState() {
+        if (ring) ring->owned.store(false, std::memory_order_release);
+    }
+};
+
+inline thread_local ThreadState threadState;
+
+inline ThreadState* mine() noexcept {
+    ThreadState* state = &threadState;
+    if (!state->ring) {
+        state->ring = acquireRing();
+        if (!state->ring) return nullptr;
+        state->thread = threadCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return state;
+}
+
+}  // namespace detail
+
+// Called through LIFECYCLE_EVENT so that LIFECYCLE_TRACE=0 removes the call
+inline void record(const char* type, Event event, const void* object, std::int64_t value = 0,
+                   std::string_view note = {}) noexcept {
+    detail::ThreadState* state = detail::mine();
+    if (!state) {
+        detail::lostEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    detail::Ring* ring = state->ring;
+    std::uint64_t h = ring->head.load(std::memory_order_relaxed);  // Only this thread writes
+    Record& slot = ring->slots[h & (detail::kRingCapacity - 1)];
+    slot.timestampNs = now();
+    slot.type = type;
+    slot.object = object;
+    slot.value = value;
+    slot.thread = state->thread;
+    size_t n = std::min(note.size(), sizeof(slot.note) - 1);
+    if (n) std::memcpy(slot.note, note.data(), n);
+    slot.note[n] = '\0';
+    slot.event = event;
+    ring->head.store(h + 1, std::memory_order_release);
+}
+
+// Every retained event recorded at or after `since`, oldest first
+inline std::vector<Record> events(std::uint64_t since = 0) {
+    std::vector<Record> out;
+    for (detail::Ring* r = detail::rings.load(std::memory_order_acquire); r; r = r->next) {
+        std::uint64_t head = r->head.load(std::memory_order_acquire);
+        std::uint64_t first = std::max(r->tail.load(std::memory_order_relaxed),
+                                       head > detail::kRingCapacity ? head - detail::kRingCapacity : 0);
+        for (std::uint64_t i = first; i < head; ++i) {
+            const Record& rec = r->slots[i & (detail::kRingCapacity - 1)];
+            if (rec.timestampNs >= since) out.push_back(rec);
+        }
+    }
+    std::stable_sort(out.begin(), out.end(),
+                     [](const Record& a, const Record& b) { return a.timestampNs < b.timestampNs; });
+    return out;
+}
+
+// Events overwritten before anyone read them (plus any that found no ring)
+inline std::uint64_t droppedEvents() {
+    std::uint64_t dropped = detail::lostEvents.load(std::memory_order_relaxed);
+    for (detail::Ring* r = detail::rings.load(std::memory_order_acquire); r; r = r->next) {
+        std::uint64_t head = r->head.load(std::memory_order_acquire);
+        std::uint64_t tail = r->tail.load(std::memory_order_relaxed);
+        if (head - tail > detail::kRingCapacity) dropped += head - tail - detail::kRingCapacity;
+    }
+    return dropped;
+}
+
+// Forget everything recorded so far
+inline void clear() {
+    for (detail::Ring* r = detail::rings.load(std::memory_order_acquire); r; r = r->next) {
+        r->tail.store(r->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    detail::lostEvents.store(0, std::memory_order_relaxed);
+}
+
+// One line per event: "  [trace] Widget #42 construct (note)", no #value when it is 0
+inline void printEvents(std::ostream& os, std::uint64_t since = 0) {
+    for (const Record& r : events(since)) {
+        os << "  [trace] " << r.type;
+        if (r.value) os << " #" << r.value;
+        os << ' ' << eventName(r.event);
+        if (r.note[0]) os << " (" << r.note << ')';
+        os << '\n';
+    }
+}
+
+namespace detail {
+
+inline void writeJsonString(std::FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') std::fprintf(f, "\\%c", c);
+        else if (c < 0x20) std::fprintf(f, "\\u%04x", c);
+        else std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+}  // namespace detail
+
+// Chrome trace-event JSON (chrome://tracing, https://ui.perfetto.dev): each
+// object is an async span from its constructor to its destructor, keyed by
+// address; assignments are instant events on that span. Returns false if the
+// file cannot be written.
+inline bool writeChromeTrace(const char* path) {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+    std::vector<Record> all = events();
+    std::uint64_t origin = all.empty() ? 0 : all.front().timestampNs;
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (std::uint32_t t = 0; t < detail::threadCount.load(std::memory_order_relaxed); ++t) {
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                        "\"args\":{\"name\":\"thread %u\"}}",
+                     first ? "" : ",\n", static_cast<unsigned>(t), static_cast<unsigned>(t));
+        first = false;
+    }
+    for (const Record& r : all) {
+        const char* phase = r.event == Event::Destruct ? "e"
+                            : (r.event == Event::CopyAssign || r.event == Event::MoveAssign) ? "n"
+                                                                                            : "b";
+        std::fprintf(f, "%s{\"name\":", first ? "" : ",\n");
+        detail::writeJsonString(f, r.type);
+        std::fprintf(f, ",\"cat\":\"lifecycle\",\"ph\":\"%s\",\"id\":\"%p\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                        "\"args\":{\"event\":\"%s\",\"value\":%lld,\"note\":",
+                     phase, r.object, (r.timestampNs - origin) / 1000.0, static_cast<unsigned>(r.thread),
+                     eventName(r.event), static_cast<long long>(r.value));
+        detail::writeJsonString(f, r.note);
+        std::fprintf(f, "}}");
+        first = false;
+    }
+    std::fprintf(f, "\n]}\n");
+    return std::fclose(f) == 0;
+}
+
+}  // namespace lifecycle
+
+#if LIFECYCLE_TRACE
+// LIFECYCLE_EVENT("Widget", Construct, this)  or  (..., this, id)  or  (..., this, id, name)
+#define LIFECYCLE_EVENT(type, event, ...) ::lifecycle::record(type, ::lifecycle::Event::event, __VA_ARGS__)
+#else
+#define LIFECYCLE_EVENT(type, event, ...) ((void)0)
+#endif
@@ -0,0 +1,190 @@
+#pragma once
+
+// Buffered text output for bulk export, formatting numbers with std::to_chars.
+//
+//     OutputSink out(stdout);                    // Or any FILE* opened for writing
+//     out << "point " << 42 << ' ' << 3.5 << '\n';
+//     out << complexValue << ' ' << vector2d << '\n';   // formatTo() hooks
+//     out.flush();                               // Only here (or when the buffer fills)
+//
+// std::ostream pays for locale lookups, sentry objects and a virtual call per
+// insertion, and std::endl adds a flush (a write() system call) per line.
+// OutputSink appends into one large buffer and writes it out with a single
+// fwrite when it fills or when flush() is called - never on '\n'. The
+// destructor flushes too. Numbers go through std::to_chars, which needs no
+// locale and no allocation.
+//
+// Doubles are written in the shortest form that reads back to the same value
+// (0.1 -> "0.1", 1.0/3 -> "0.3333333333333333"). precision(n) switches to
+// "%.ng" style, the format std::ostream uses (precision(6) reproduces
+// `std::cout << x` exactly); n is capped at 17, which is always enough.
+//
+// Types opt in by providing formatTo(OutputSink&, const T&), found by
+// argument-dependent lookup. A hook that knows its maximum size can format
+// straight into the buffer:
+//
+//     inline void formatTo(OutputSink& out, const Vector2D& v) {
+//         char* p = out.reserve(2 * OutputSink::kMaxDoubleChars + 4);
+//         *p++ = '(';
+//         p = out.format(p, v.x);
+//         ...
+//         out.commit(p);
+//     }
+//
+// Mixing with std::cout: flush() before the next std::cout line, so both
+// reach the FILE in order.
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define OUTPUT_SINK_FLOAT_TO_CHARS 1  // Otherwise doubles fall back to snprintf
+#endif
+#if !defined(OUTPUT_SINK_FLOAT_TO_CHARS)
+#include <cstdlib>
+#endif
+
+class OutputSink {
+public:
+    static constexpr size_t kDefaultCapacity = 1 << 16;
+    static constexpr size_t kMaxDoubleChars = 32;  // "-1.7976931348623157e+308" and friends
+    static constexpr size_t kMaxIntChars = 24;     // 64-bit integers with sign
+
+    explicit OutputSink(std::FILE* file = stdout, size_t capacity = kDefaultCapacity)
+        : file(file),
+          capacity(capacity < 256 ? 256 : capacity),
+          buffer(new char[this->capacity]),
+          cursor(buffer.get()) {}
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    ~OutputSink() { flush(); }
+
+    // 0 (the default): shortest round-trip; n > 0: at most n significant digits
+    void precision(int digits) { digitsOfPrecision = digits < 0 ? 0 : digits > 17 ? 17 : digits; }
+    int precision() const { return digitsOfPrecision; }
+
+    // Write the buffer to the FILE and fflush it. Returns false on a write error
+    // (which also sticks: see good()).
+    bool flush() {
+        writeBuffer();
+        if (std::fflush(file) != 0) failed = true;
+        return !failed;
+    }
+
+    bool good() const { return !failed; }
+
+    // Bytes written so far, flushed or not
+    unsigned long long bytesWritten() const { return flushed + static_cast<size_t>(cursor - buffer.get()); }
+
+    // --- Direct buffer access for formatter hooks ---
+
+    // At least n bytes to write into (n must not exceed the capacity); pass the
+    // end of what was written to commit()
+    char* reserve(size_t n) {
+        if (static_cast<size_t>(end() - cursor) < n) writeBuffer();
+        return cursor;
+    }
+    void commit(char* newCursor) { cursor = newCursor; }
+
+    // Format into memory reserved above; returns the end of the text
+    char* format(char* p, double value) const { return formatDouble(p, value); }
+    template <typename Int, typename = std::enable_if_t<std::is_integral_v<Int>>>
+    static char* format(char* p, Int value) {
+        return std::to_chars(p, p + kMaxIntChars, value).ptr;
+    }
+
+    // --- Insertion ---
+
+    OutputSink& write(const char* data, size_t n) {
+        if (n > static_cast<size_t>(end() - cursor)) {
+            writeBuffer();
+            if (n > capacity) {  // Too big to buffer: straight through
+                writeRaw(data, n);
+                return *this;
+            }
+        }
+        std::memcpy(cursor, data, n);
+        cursor += n;
+        return *this;
+    }
+
+    OutputSink& operator<<(std::string_view s) { return write(s.data(), s.size()); }
+    OutputSink& operator<<(const char* s) { return write(s, std::strlen(s)); }
+    OutputSink& operator<<(const std::string& s) { return write(s.data(), s.size()); }
+
+    OutputSink& operator<<(char c) {
+        if (cursor == end()) writeBuffer();
+        *cursor++ = c;
+        return *this;
+    }
+
+    OutputSink& operator<<(bool b) { return *this << (b ? '1' : '0'); }  // As std::ostream does
+
+    OutputSink& operator<<(double value) {
+        commit(formatDouble(reserve(kMaxDoubleChars), value));
+        return *this;
+    }
+    OutputSink& operator<<(float value) { return *this << static_cast<double>(value); }
+
+    template <typename Int, typename = std::enable_if_t<std::is_integral_v<Int> && !std::is_same_v<Int, bool> &&
+                                                        !std::is_same_v<Int, char>>>
+    OutputSink& operator<<(Int value) {
+        commit(format(reserve(kMaxIntChars), value));
+        return *this;
+    }
+
+    // Anything with a formatTo(OutputSink&, const T&) hook
+    template <typename T, typename = decltype(formatTo(std::declval<OutputSink&>(), std::declval<const T&>()))>
+    OutputSink& operator<<(const T& value) {
+        formatTo(*this, value);
+        return *this;
+    }
+
+private:
+    std::FILE* file;
+    size_t capacity;
+    std::unique_ptr<char[]> buffer;
+    char* cursor;
+    unsigned long long flushed = 0;
+    int digitsOfPrecision = 0;
+    bool failed = false;
+
+    char* end() const { return buffer.get() + capacity; }
+
+    void writeRaw(const char* data, size_t n) {
+        if (std::fwrite(data, 1, n, file) != n) failed = true;
+        flushed += n;
+    }
+
+    void writeBuffer() {
+        size_t n = static_cast<size_t>(cursor - buffer.get());
+        if (n) writeRaw(buffer.get(), n);
+        cursor = buffer.get();
+    }
+
+    char* formatDouble(char* p, double value) const {
+#if defined(OUTPUT_SINK_FLOAT_TO_CHARS)
+        if (digitsOfPrecision == 0) return std::to_chars(p, p + kMaxDoubleChars, value).ptr;
+        return std::to_chars(p, p + kMaxDoubleChars, value, std::chars_format::general, digitsOfPrecision).ptr;
+#else
+        // printf-based fallback: the shortest of %.15g..%.17g that round-trips
+        int written = 0;
+        if (digitsOfPrecision == 0) {
+            for (int digits = 15; digits <= 17; ++digits) {
+                written = std::snprintf(p, kMaxDoubleChars, "%.*g", digits, value);
+                if (digits == 17 || std::strtod(p, nullptr) == value) break;
+            }
+        } else {
+            written = std::snprintf(p, kMaxDoubleChars, "%.*g", digitsOfPrecision, value);
+        }
+        return p + written;
+#endif
+    }
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+// Minimal non-owning view over contiguous elements, standing in for C++20
+// std::span so the examples still build with -std=c++17.
+//
+//     void process(Span<const int> values);
+//     process(myVector);               // from any container with data()/size()
+//     process({ptr, count});           // from pointer + length
+//     process(values.subspan(0, 100)); // first 100 elements
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept : ptr(nullptr), count(0) {}
+    constexpr Span(T* data, size_t size) noexcept : ptr(data), count(size) {}
+
+    template <size_t N>
+    constexpr Span(T (&array)[N]) noexcept : ptr(array), count(N) {}
+
+    // Any contiguous container whose data() converts to T*
+    template <typename Container,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::remove_cv_t<std::remove_reference_t<Container>>, Span> &&
+                  std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container&& c) noexcept : ptr(c.data()), count(c.size()) {}
+
+    // Span<T> -> Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : ptr(other.data()), count(other.size()) {}
+
+    constexpr T* data() const noexcept { return ptr; }
+    constexpr size_t size() const noexcept { return count; }
+    constexpr bool empty() const noexcept { return count == 0; }
+
+    constexpr T& operator[](size_t i) const { return ptr[i]; }
+    constexpr T* begin() const noexcept { return ptr; }
+    constexpr T* end() const noexcept { return ptr + count; }
+
+    constexpr Span subspan(size_t offset, size_t n) const {
+        return Span(ptr + offset, n);
+    }
+    constexpr Span first(size_t n) const { return Span(ptr, n); }
+
+private:
+    T* ptr;
+    size_t count;
+};
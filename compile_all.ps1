@@ -1,11 +1,16 @@
 $modules = @(
+    "00_cpp_syntax",
     "01_references",
     "02_function_overloading",
     "03_classes_basics",
     "04_constructors_destructors",
     "05_operator_overloading",
+    "08_templates",
+    "09_stl_containers",
     "10_smart_pointers",
-    "12_lambda_expressions"
+    "11_exceptions",
+    "12_lambda_expressions",
+    "13_move_semantics"
 )
 
 # Detect available compiler
@@ -101,6 +106,30 @@ foreach ($module in $modules) {
         }
     }
     
+    # Benchmarks are built with optimizations; -O0 timings are meaningless
+    foreach ($bench in Get-ChildItem "$module\*_benchmark.cpp" -ErrorAction SilentlyContinue) {
+        $exe = [System.IO.Path]::ChangeExtension($bench.FullName, ".exe")
+        Write-Host "   Compiling $($bench.Name)... " -NoNewline
+
+        if ($compiler -eq "cl") {
+            cl /EHsc /std:c++17 /W4 /O2 /Fe:"$exe" "$($bench.FullName)" 2>$null >$null
+        } else {
+            g++ -std=c++17 -O2 -Wall -Wextra -pthread -o "$exe" "$($bench.FullName)" 2>$null
+        }
+
+        if ($LASTEXITCODE -eq 0) {
+            Write-Host "OK" -ForegroundColor Green
+            $totalCompiled++
+            if ($compiler -eq "cl") {
+                Remove-Item "$module\*.obj" -ErrorAction SilentlyContinue
+                Remove-Item "*.obj" -ErrorAction SilentlyContinue
+            }
+        } else {
+            Write-Host "FAILED" -ForegroundColor Red
+            $totalFailed++
+        }
+    }
+    
     Write-Host ""
 }
 